@@ -0,0 +1,412 @@
+/*
+ * cachesim.c - Offline cache simulator for sizing the proxy's cache and comparing eviction policies
+ *
+ * The requests of a capture taken with the proxy server's -capture option, or of a
+ * generated Zipf workload, are replayed against the proxy's own eviction policies
+ * at many capacities. The trace is loaded into memory once, and every combination
+ * of policy and capacity is simulated independently by a pool of threads. The
+ * policies are sized for a capacity the way the proxy sizes them, so a curve
+ * predicts the hit ratio the proxy would have with -cache-size and -cache-policy.
+ *
+ * Only requests the proxy answered from its cache or the server are replayed, as
+ * those are the ones it tells its eviction policy about. Generated objects are
+ * named "key-0" ... "key-(n-1)" like the client's load generator, and object k is
+ * between half and one and a half times the given size.
+ *
+ * Every point of a curve gives the object hit ratio, the share of requests that
+ * were hits, and the byte hit ratio, the share of requested bytes that were hits.
+ */
+
+#include <sys/types.h>
+
+#include <err.h>
+#include <errno.h>
+#include <limits.h>
+#include <math.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include "capture.h"
+#include "murmur3.h"
+#include "options.h"
+#include "policy.h"
+#include "zipf.h"
+
+const unsigned int DEFAULT_OBJECTS = 100000;
+const unsigned int DEFAULT_REQUESTS = 1000000;
+const unsigned int DEFAULT_SIZE = 4096;
+const unsigned int DEFAULT_POINTS = 12;
+const double MIN_CAPACITY_SHARE = 0.001;	/* Smallest capacity of -points, as a share of the unique bytes */
+const unsigned int MAX_CAPACITIES = 256;
+
+enum format {
+	FORMAT_TABLE,
+	FORMAT_CSV,
+	FORMAT_JSON
+};
+
+struct request {
+	uint64_t key;
+	unsigned long long size;
+	unsigned long long time_us;		/* Since the start of the capture. Orders the requests */
+};
+
+struct simulation {
+	enum policy_kind policy;
+	unsigned long long capacity;
+	unsigned long long hits;
+	unsigned long long hit_bytes;
+	double seconds;				/* Time the simulation took */
+};
+
+static struct request *requests;
+static size_t num_requests;
+static size_t warmup;				/* Requests replayed before hits are counted */
+static unsigned long long total_bytes;		/* Requested bytes after the warmup */
+static struct simulation *simulations;
+static unsigned int num_simulations;
+static unsigned int next_simulation;
+
+void usage(void)
+{
+	extern char * __progname;
+	fprintf(stderr, "usage: %s -capture filename | -zipf exponent [-objects count] [-requests count] [-size bytes]\n"
+	    "       [-capacities bytes,... | -points count] [-policies lru,slru,tinylfu] [-threads count]\n"
+	    "       [-warmup requests] [-format table|csv|json]\n", __progname);
+	exit(1);
+}
+
+static uint64_t hash_name(const char *object_name) {
+	uint64_t hash[2];
+
+	MurmurHash3_x64_128(object_name, strlen(object_name), POLICY_SEED, hash);
+	return hash[0];
+}
+
+static void add_request(size_t *capacity, uint64_t key, unsigned long long size, unsigned long long time_us) {
+	if (num_requests == *capacity) {
+		*capacity = *capacity == 0 ? 65536 : 2 * *capacity;
+		if ((requests = realloc(requests, *capacity * sizeof(*requests))) == NULL)
+			err(1, "realloc");
+	}
+	requests[num_requests].key = key;
+	requests[num_requests].size = size;
+	requests[num_requests++].time_us = time_us;
+}
+
+static int compare_times(const void *a, const void *b) {
+	const struct request *x = a, *y = b;
+	return (x->time_us > y->time_us) - (x->time_us < y->time_us);
+}
+
+/****
+ * Load the requests of a capture the proxy answered from its cache or the server,
+ * in arrival order. Requests for objects of unknown size count default_size bytes
+ * return: Nothing. Exits if the file is not a capture
+ ****/
+static void load_capture(const char *path, unsigned long long default_size) {
+	struct capture_record record;
+	unsigned long long start_us;
+	size_t capacity = 0;
+	FILE *fp;
+	int ret;
+
+	if ((fp = fopen(path, "r")) == NULL)
+		err(1, "%s", path);
+	if (capture_read_header(fp, &start_us) == -1)
+		errx(1, "%s is not a capture", path);
+	while ((ret = capture_read(fp, &record)) == 1) {
+		if (record.outcome == CAPTURE_HIT || record.outcome == CAPTURE_MISS)
+			add_request(&capacity, hash_name(record.object_name), record.size > 0 ? record.size : default_size,
+			    record.time_us);
+	}
+	if (ret == -1)
+		warnx("%s: malformed record after %zu requests", path, num_requests);
+	fclose(fp);
+	qsort(requests, num_requests, sizeof(*requests), compare_times);	// Records are written as requests end
+}
+
+/****
+ * Generate requests for Zipf distributed objects
+ * return: Nothing
+ ****/
+static void generate_zipf(double exponent, unsigned int num_objects, size_t count, unsigned long long size) {
+	uint64_t *keys;
+	unsigned long long *sizes;
+	uint64_t state = 0x9e3779b97f4a7c15ULL;
+	struct zipf zipf;
+	char name[32];
+	size_t capacity = 0, i;
+	unsigned int k;
+
+	if ((keys = malloc(num_objects * sizeof(*keys))) == NULL || (sizes = malloc(num_objects * sizeof(*sizes))) == NULL)
+		err(1, "malloc");
+	for (k = 0; k < num_objects; k++) {
+		snprintf(name, sizeof(name), "key-%u", k);
+		keys[k] = hash_name(name);
+		sizes[k] = size / 2 + keys[k] % (size + 1);
+	}
+	zipf_init(&zipf, num_objects, exponent);
+	for (i = 0; i < count; i++) {
+		k = zipf_next(&zipf, &state);
+		add_request(&capacity, keys[k], sizes[k], i);
+	}
+	zipf_free(&zipf);
+	free(keys);
+	free(sizes);
+}
+
+static int compare_keys(const void *a, const void *b) {
+	const struct request *x = a, *y = b;
+	return (x->key > y->key) - (x->key < y->key);
+}
+
+/****
+ * Count the distinct objects of the trace and their bytes, each at the size it was
+ * first requested with
+ * return: Nothing
+ ****/
+static void count_unique(size_t *objects, unsigned long long *bytes) {
+	struct request *sorted;
+	size_t i;
+
+	*objects = 0;
+	*bytes = 0;
+	if ((sorted = malloc(num_requests * sizeof(*sorted))) == NULL)
+		err(1, "malloc");
+	memcpy(sorted, requests, num_requests * sizeof(*sorted));
+	for (i = 0; i < num_requests; i++)
+		sorted[i].time_us = i;
+	qsort(sorted, num_requests, sizeof(*sorted), compare_keys);
+	for (i = 0; i < num_requests; i++) {
+		size_t first = i;
+		while (i + 1 < num_requests && sorted[i + 1].key == sorted[first].key) {
+			if (sorted[++i].time_us < sorted[first].time_us)
+				first = i;
+		}
+		(*objects)++;
+		*bytes += sorted[first].size;
+	}
+	free(sorted);
+}
+
+/****
+ * Replay the trace against one policy at one capacity
+ * return: Nothing
+ ****/
+static void simulate(struct simulation *simulation) {
+	unsigned int max_objects = policy_objects(simulation->capacity);
+	struct timespec start, end;
+	struct policy *policy;
+	unsigned int slot;
+	size_t i;
+
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	if ((policy = malloc(policy_size(max_objects))) == NULL)
+		err(1, "malloc");
+	policy_init(policy, simulation->policy, simulation->capacity, max_objects);
+	for (i = 0; i < num_requests; i++) {
+		if (policy_access(policy, requests[i].key, requests[i].size, &slot, NULL, NULL) == POLICY_HIT && i >= warmup) {
+			simulation->hits++;
+			simulation->hit_bytes += requests[i].size;
+		}
+	}
+	free(policy);
+	clock_gettime(CLOCK_MONOTONIC, &end);
+	simulation->seconds = (end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) / 1e9;
+}
+
+static void *run_worker(void *arg)
+{
+	unsigned int i;
+
+	(void)arg;
+	while ((i = __atomic_fetch_add(&next_simulation, 1, __ATOMIC_RELAXED)) < num_simulations)
+		simulate(&simulations[i]);
+	return NULL;
+}
+
+/****
+ * Parse a comma separated list of capacities in bytes
+ * return: Number of capacities
+ ****/
+static unsigned int parse_capacities(char *list, unsigned long long *capacities) {
+	unsigned int count = 0;
+	char *capacity;
+
+	for (capacity = strtok(list, ","); capacity != NULL; capacity = strtok(NULL, ",")) {
+		if (count == MAX_CAPACITIES)
+			errx(1, "At most %u capacities", MAX_CAPACITIES);
+		if ((capacities[count++] = parse_number(capacity, ULONG_MAX)) == 0)
+			usage();
+	}
+	return count;
+}
+
+static void print_results(enum format format, unsigned long long unique_bytes) {
+	size_t counted = num_requests - warmup;
+	unsigned int i;
+
+	if (format == FORMAT_TABLE)
+		printf("%-8s %16s %9s %10s %15s\n", "policy", "capacity", "unique%", "hit_ratio", "byte_hit_ratio");
+	else if (format == FORMAT_CSV)
+		printf("policy,capacity,unique_share,hit_ratio,byte_hit_ratio\n");
+	else
+		printf("{\n  \"requests\": %zu,\n  \"warmup\": %zu,\n  \"unique_bytes\": %llu,\n  \"results\": [\n", num_requests,
+		    warmup, unique_bytes);
+
+	for (i = 0; i < num_simulations; i++) {
+		const struct simulation *s = &simulations[i];
+		double share = (double)s->capacity / unique_bytes;
+		double hit_ratio = counted > 0 ? (double)s->hits / counted : 0;
+		double byte_hit_ratio = total_bytes > 0 ? (double)s->hit_bytes / total_bytes : 0;
+
+		if (format == FORMAT_TABLE)
+			printf("%-8s %16llu %8.2f%% %10.4f %15.4f\n", POLICY_NAMES[s->policy], s->capacity, 100 * share, hit_ratio,
+			    byte_hit_ratio);
+		else if (format == FORMAT_CSV)
+			printf("%s,%llu,%.6f,%.6f,%.6f\n", POLICY_NAMES[s->policy], s->capacity, share, hit_ratio, byte_hit_ratio);
+		else
+			printf("    {\"policy\": \"%s\", \"capacity\": %llu, \"unique_share\": %.6f, \"hit_ratio\": %.6f, "
+			    "\"byte_hit_ratio\": %.6f}%s\n", POLICY_NAMES[s->policy], s->capacity, share, hit_ratio, byte_hit_ratio,
+			    i + 1 < num_simulations ? "," : "");
+	}
+	if (format == FORMAT_JSON)
+		printf("  ]\n}\n");
+}
+
+int main(int argc, char *argv[])
+{
+	const char *capture_path = NULL;
+	double exponent = -1;
+	unsigned int num_objects = DEFAULT_OBJECTS;
+	size_t count = DEFAULT_REQUESTS;
+	unsigned long long size = DEFAULT_SIZE;
+	unsigned long long capacities[MAX_CAPACITIES];
+	unsigned int num_capacities = 0, num_points = DEFAULT_POINTS;
+	int policies[NUM_POLICIES] = {1, 1, 1};
+	long num_threads = sysconf(_SC_NPROCESSORS_ONLN);
+	enum format format = FORMAT_TABLE;
+	enum policy_kind kind;
+	char *ep, *name;
+	int arg;
+
+	if (argc < 3 || argc % 2 != 1)
+		usage();
+	for (arg = 1; arg < argc; arg += 2) {
+		if (strcmp(argv[arg], "-capture") == 0) {
+			capture_path = argv[arg + 1];
+		} else if (strcmp(argv[arg], "-zipf") == 0) {
+			exponent = strtod(argv[arg + 1], &ep);
+			if (*argv[arg + 1] == '\0' || *ep != '\0' || exponent < 0)
+				usage();
+		} else if (strcmp(argv[arg], "-objects") == 0) {
+			if ((num_objects = parse_number(argv[arg + 1], UINT_MAX)) == 0)
+				usage();
+		} else if (strcmp(argv[arg], "-requests") == 0) {
+			count = parse_number(argv[arg + 1], ULONG_MAX);
+		} else if (strcmp(argv[arg], "-size") == 0) {
+			size = parse_number(argv[arg + 1], ULONG_MAX / 2);
+		} else if (strcmp(argv[arg], "-capacities") == 0) {
+			num_capacities = parse_capacities(argv[arg + 1], capacities);
+		} else if (strcmp(argv[arg], "-points") == 0) {
+			if ((num_points = parse_number(argv[arg + 1], MAX_CAPACITIES)) == 0)
+				usage();
+		} else if (strcmp(argv[arg], "-policies") == 0) {
+			memset(policies, 0, sizeof(policies));
+			for (name = strtok(argv[arg + 1], ","); name != NULL; name = strtok(NULL, ",")) {
+				if (policy_parse(name, &kind) == -1)
+					usage();
+				policies[kind] = 1;
+			}
+		} else if (strcmp(argv[arg], "-threads") == 0) {
+			if ((num_threads = parse_number(argv[arg + 1], 4096)) == 0)
+				usage();
+		} else if (strcmp(argv[arg], "-warmup") == 0) {
+			warmup = parse_number(argv[arg + 1], ULONG_MAX);
+		} else if (strcmp(argv[arg], "-format") == 0) {
+			if (strcmp(argv[arg + 1], "table") == 0)
+				format = FORMAT_TABLE;
+			else if (strcmp(argv[arg + 1], "csv") == 0)
+				format = FORMAT_CSV;
+			else if (strcmp(argv[arg + 1], "json") == 0)
+				format = FORMAT_JSON;
+			else
+				usage();
+		} else {
+			usage();
+		}
+	}
+	if ((capture_path == NULL) == (exponent < 0))
+		usage();
+
+	/**** Load the trace ****/
+	if (capture_path != NULL)
+		load_capture(capture_path, size);
+	else
+		generate_zipf(exponent, num_objects, count, size);
+	if (num_requests == 0)
+		errx(1, "No requests to replay");
+	if (warmup >= num_requests)
+		errx(1, "The warmup covers all %zu requests", num_requests);
+
+	size_t unique_objects;
+	unsigned long long unique_bytes;
+	size_t i;
+	count_unique(&unique_objects, &unique_bytes);
+	for (i = warmup; i < num_requests; i++)
+		total_bytes += requests[i].size;
+	fprintf(stderr, "%zu requests for %zu objects totalling %llu bytes\n", num_requests, unique_objects, unique_bytes);
+	/**** End load the trace ****/
+
+	/**** Simulate every policy at every capacity ****/
+	unsigned int p, c;
+	if (num_capacities == 0) {			// Log spaced from MIN_CAPACITY_SHARE of the unique bytes to all of them
+		for (c = 0; c < num_points; c++) {
+			double share = num_points == 1 ? 1 : MIN_CAPACITY_SHARE * pow(1 / MIN_CAPACITY_SHARE, (double)c / (num_points - 1));
+			if ((capacities[num_capacities] = share * unique_bytes) > 0)
+				num_capacities++;
+		}
+	}
+	if ((simulations = calloc(NUM_POLICIES * num_capacities, sizeof(*simulations))) == NULL)
+		err(1, "calloc");
+	for (p = 0; p < NUM_POLICIES; p++) {
+		for (c = 0; policies[p] && c < num_capacities; c++) {
+			simulations[num_simulations].policy = p;
+			simulations[num_simulations++].capacity = capacities[c];
+		}
+	}
+
+	pthread_t *threads;
+	struct timespec start, end;
+	long t;
+	if (num_threads > (long)num_simulations)
+		num_threads = num_simulations;
+	if ((threads = calloc(num_threads, sizeof(*threads))) == NULL)
+		err(1, "calloc");
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	for (t = 0; t < num_threads; t++) {
+		if (pthread_create(&threads[t], NULL, run_worker, NULL) != 0)
+			errx(1, "pthread_create failed");
+	}
+	for (t = 0; t < num_threads; t++)
+		pthread_join(threads[t], NULL);
+	clock_gettime(CLOCK_MONOTONIC, &end);
+
+	double elapsed = (end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) / 1e9;
+	double busy = 0;
+	for (i = 0; i < num_simulations; i++)
+		busy += simulations[i].seconds;
+	fprintf(stderr, "%u simulations on %ld threads in %.2f s (%.1f million requests/s per thread)\n", num_simulations,
+	    num_threads, elapsed, busy > 0 ? num_simulations * (double)num_requests / busy / 1e6 : 0);
+	/**** End simulate every policy at every capacity ****/
+
+	print_results(format, unique_bytes);
+	free(threads);
+	free(simulations);
+	free(requests);
+	return 0;
+}
@@ -0,0 +1,155 @@
+/*
+ * connrate.c - Connection rate benchmark for the proxy server and server
+ *
+ * Several threads repeatedly open a TLS connection to a local port, optionally
+ * send one request line and read the response, and close the connection. The
+ * number of completed connections per second measures how fast the target
+ * accepts connections and completes handshakes.
+ */
+
+#include <sys/types.h>
+
+#include <err.h>
+#include <errno.h>
+#include <limits.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <tls.h>
+#include "options.h"
+#include "protocol.h"
+
+const unsigned int DEFAULT_THREADS = 8;
+const unsigned int DEFAULT_SECONDS = 10;
+
+static struct tls_config *cfg;
+static const char *port;
+static const char *request;
+static struct timespec stop_time;
+
+struct worker {
+	pthread_t thread;
+	unsigned long long connections;		/* Connections completed */
+	unsigned long long failures;		/* Connections that failed to connect, handshake or get a response */
+};
+
+void usage(void)
+{
+	extern char * __progname;
+	fprintf(stderr, "usage: %s -port portnumber [-threads count] [-seconds duration] [-request line]\n", __progname);
+	exit(1);
+}
+
+static int time_left()
+{
+	struct timespec now;
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return now.tv_sec < stop_time.tv_sec || (now.tv_sec == stop_time.tv_sec && now.tv_nsec < stop_time.tv_nsec);
+}
+
+/****
+ * Open one connection, run the request if any and close the connection
+ * return: 0 on success. -1 on failure
+ ****/
+static int one_connection()
+{
+	struct tls *ctx;
+	int ret = -1;
+
+	if ((ctx = tls_client()) == NULL)
+		return -1;
+	if (tls_configure(ctx, cfg) != 0 || tls_connect(ctx, "localhost", port) != 0 || tls_handshake(ctx) != 0)
+		goto done;
+
+	if (request != NULL) {
+		char buf[4096];
+		ssize_t n;
+		if (tls_printf(ctx, "%s\n", request) == -1)
+			goto done;
+		while ((n = tls_read(ctx, buf, sizeof(buf))) != 0) {
+			if (n == TLS_WANT_POLLIN || n == TLS_WANT_POLLOUT)
+				continue;
+			if (n < 0)
+				goto done;
+		}
+	}
+	ret = 0;
+
+done:
+	tls_close(ctx);
+	tls_free(ctx);
+	return ret;
+}
+
+static void *run_worker(void *arg)
+{
+	struct worker *worker = arg;
+
+	while (time_left()) {
+		if (one_connection() == 0)
+			worker->connections++;
+		else
+			worker->failures++;
+	}
+	return NULL;
+}
+
+int main(int argc, char *argv[])
+{
+	unsigned int num_threads = DEFAULT_THREADS;
+	unsigned int seconds = DEFAULT_SECONDS;
+	int arg;
+
+	if (argc < 3 || argc % 2 != 1 || strcmp(argv[1], "-port") != 0)
+		usage();
+	port = argv[2];
+	for (arg = 3; arg < argc; arg += 2) {
+		if (strcmp(argv[arg], "-threads") == 0 && parse_number(argv[arg + 1], 4096) > 0)
+			num_threads = parse_number(argv[arg + 1], 4096);
+		else if (strcmp(argv[arg], "-seconds") == 0 && parse_number(argv[arg + 1], 86400) > 0)
+			seconds = parse_number(argv[arg + 1], 86400);
+		else if (strcmp(argv[arg], "-request") == 0)
+			request = argv[arg + 1];
+		else
+			usage();
+	}
+
+	if (tls_init() != 0)
+		err(1, "tls_init:");
+	if ((cfg = tls_config_new()) == NULL)
+		err(1, "tls_config_new:");
+	if (tls_config_set_ca_file(cfg, "../../certificates/root.pem") != 0)
+		err(1, "tls_config_set_ca_file:");
+
+	struct worker *workers;
+	struct timespec start, end;
+	unsigned int i;
+
+	if ((workers = calloc(num_threads, sizeof(*workers))) == NULL)
+		err(1, "calloc");
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	stop_time = start;
+	stop_time.tv_sec += seconds;
+	for (i = 0; i < num_threads; i++) {
+		if (pthread_create(&workers[i].thread, NULL, run_worker, &workers[i]) != 0)
+			errx(1, "pthread_create failed");
+	}
+
+	unsigned long long connections = 0, failures = 0;
+	for (i = 0; i < num_threads; i++) {
+		pthread_join(workers[i].thread, NULL);
+		connections += workers[i].connections;
+		failures += workers[i].failures;
+	}
+	clock_gettime(CLOCK_MONOTONIC, &end);
+
+	double elapsed = (end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) / 1e9;
+	printf("threads %u elapsed %.2f s connections %llu failures %llu rate %.1f connections/s\n",
+	    num_threads, elapsed, connections, failures, connections / elapsed);
+
+	free(workers);
+	tls_config_free(cfg);
+	return 0;
+}
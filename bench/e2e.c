@@ -0,0 +1,458 @@
+/*
+ * e2e.c - End-to-end loopback benchmark of the server and proxy server
+ *
+ * A scratch directory is set up with its own server_files and proxy_files, and
+ * the server and proxy executables are started in it on free ephemeral ports. Every
+ * object is requested once through the proxy server, which misses and fetches it
+ * from the server, then again several times, which hits the proxy cache. Finally a
+ * number of threads request random cached objects over persistent connections for
+ * a fixed time to measure throughput. Latencies are recorded in histograms. A
+ * summary is printed to stderr and the results are written as JSON to stdout or a
+ * file, so runs can be compared. The scratch directory is removed afterwards unless
+ * a step fails, in which case it is kept with the logs of both executables.
+ */
+
+#define _GNU_SOURCE
+
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+
+#include <err.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <ftw.h>
+#include <libgen.h>
+#include <limits.h>
+#include <pthread.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <tls.h>
+#include "connection.h"
+#include "histogram.h"
+#include "options.h"
+#include "protocol.h"
+#include "rendezvous.h"
+#include "zipf.h"
+
+const unsigned int NUM_PROXIES = 6;
+const char *PROXY_NAMES[] = {"one", "two", "three", "four", "five", "six"};
+const unsigned int DEFAULT_OBJECTS = 200;
+const unsigned int DEFAULT_OBJECT_SIZE = 4096;
+const unsigned int DEFAULT_CONNECTIONS = 4;
+const unsigned int DEFAULT_SECONDS = 5;
+const unsigned int HIT_PASSES = 5;
+const unsigned int STARTUP_ATTEMPTS = 100;	/* Connection attempts, 50 ms apart, before giving up on a process */
+
+struct worker {
+	pthread_t thread;
+	uint64_t random_state;
+	struct histogram latency;		/* Microseconds per request */
+	unsigned long long bytes;		/* Body bytes received */
+	unsigned long long errors;
+};
+
+static char scratch_dir[] = "/tmp/tlscache-e2e.XXXXXX";
+static char proxy_port[16];
+static struct tls_config *tls_cfg;
+static char (*requests)[MAX_LINE];		/* Request line of every object */
+static unsigned int num_objects = DEFAULT_OBJECTS;
+static unsigned int object_size = DEFAULT_OBJECT_SIZE;
+static struct timespec stop_time;
+
+void usage(void)
+{
+	extern char * __progname;
+	fprintf(stderr, "usage: %s [-bin directory] [-certificates directory] [-objects count] [-size bytes]\n"
+	    "          [-connections count] [-seconds duration] [-json filename]\n", __progname);
+	exit(1);
+}
+
+static long long elapsed_us(const struct timespec *start, const struct timespec *end) {
+	return (end->tv_sec - start->tv_sec) * 1000000LL + (end->tv_nsec - start->tv_nsec) / 1000;
+}
+
+static int time_left()
+{
+	struct timespec now;
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return now.tv_sec < stop_time.tv_sec || (now.tv_sec == stop_time.tv_sec && now.tv_nsec < stop_time.tv_nsec);
+}
+
+/****
+ * Find a free port by binding to port 0 and reading the port the kernel chose
+ * port: Filled with the port number
+ * return: Nothing
+ ****/
+static void free_port(char *port, size_t size) {
+	struct sockaddr_in addr;
+	socklen_t len = sizeof(addr);
+	int sd;
+
+	memset(&addr, 0, sizeof(addr));
+	addr.sin_family = AF_INET;
+	addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+	if ((sd = socket(AF_INET, SOCK_STREAM, 0)) == -1)
+		err(1, "socket");
+	if (bind(sd, (struct sockaddr *)&addr, sizeof(addr)) == -1 || getsockname(sd, (struct sockaddr *)&addr, &len) == -1)
+		err(1, "bind");
+	snprintf(port, size, "%u", ntohs(addr.sin_port));
+	close(sd);
+}
+
+static void write_file(const char *path, const char *data, size_t len) {
+	int fd;
+
+	if ((fd = open(path, O_WRONLY | O_CREAT | O_TRUNC, 0644)) == -1)
+		err(1, "%s", path);
+	if (len > 0 && write(fd, data, len) != (ssize_t)len)
+		err(1, "%s", path);
+	close(fd);
+}
+
+/****
+ * Create the scratch directory and change into the directory the executables run in.
+ * The executables find the certificates at ../../certificates
+ * certificates: Directory holding root.pem, server.crt and server.key
+ * return: Nothing
+ ****/
+static void setup_scratch(const char *certificates) {
+	char path[PATH_MAX];
+	char *data;
+	unsigned int i, j;
+
+	if (mkdtemp(scratch_dir) == NULL)
+		err(1, "mkdtemp");
+	snprintf(path, sizeof(path), "%s/certificates", scratch_dir);
+	if (symlink(certificates, path) == -1)
+		err(1, "symlink %s", path);
+	snprintf(path, sizeof(path), "%s/run", scratch_dir);
+	if (mkdir(path, 0755) == -1)
+		err(1, "mkdir %s", path);
+	snprintf(path, sizeof(path), "%s/run/src", scratch_dir);
+	if (mkdir(path, 0755) == -1 || chdir(path) == -1)
+		err(1, "%s", path);
+	if (mkdir("server_files", 0755) == -1 || mkdir("proxy_files", 0755) == -1)
+		err(1, "mkdir");
+	write_file("proxy_files/Blacklisted_Objects", "", 0);
+
+	if ((data = malloc(object_size)) == NULL || (requests = malloc(num_objects * sizeof(*requests))) == NULL)
+		err(1, "malloc");
+	for (i = 0; i < num_objects; i++) {
+		char name[MAX_OBJECT_NAME + 1];
+
+		snprintf(name, sizeof(name), "bench-%u", i);
+		for (j = 0; j < object_size; j++)
+			data[j] = 'a' + (i + j) % 26;
+		snprintf(path, sizeof(path), "server_files/%s", name);
+		write_file(path, data, object_size);
+		format_request(requests[i], sizeof(requests[i]), name);
+	}
+	free(data);
+}
+
+static int remove_entry(const char *path, const struct stat *st, int flag, struct FTW *ftw) {
+	return remove(path);
+}
+
+/****
+ * Start an executable in its own process group with its output going to a log file
+ * return: Process ID of the executable
+ ****/
+static pid_t spawn(const char *bin_dir, const char *name, const char *arg1, const char *arg2, const char *arg3) {
+	char path[PATH_MAX];
+	char log[PATH_MAX];
+	pid_t pid;
+	int fd;
+
+	snprintf(path, sizeof(path), "%s/%s", bin_dir, name);
+	snprintf(log, sizeof(log), "%s/%s.log", scratch_dir, name);
+	fflush(stdout);
+	fflush(stderr);
+	if ((pid = fork()) == -1)
+		err(1, "fork");
+	if (pid == 0) {
+		setpgid(0, 0);
+		if ((fd = open(log, O_WRONLY | O_CREAT | O_TRUNC, 0644)) == -1)
+			err(1, "%s", log);
+		dup2(fd, STDOUT_FILENO);
+		dup2(fd, STDERR_FILENO);
+		close(fd);
+		execl(path, name, arg1, arg2, arg3, (char *)NULL);
+		err(1, "%s", path);
+	}
+	setpgid(pid, pid);
+	return pid;
+}
+
+static void stop(pid_t pid) {
+	kill(-pid, SIGTERM);
+	waitpid(pid, NULL, 0);
+}
+
+/****
+ * Wait until a port accepts connections
+ * return: 0 once it does. -1 if it did not within STARTUP_ATTEMPTS attempts
+ ****/
+static int wait_listening(const char *port) {
+	struct sockaddr_in addr;
+	unsigned int attempt;
+
+	memset(&addr, 0, sizeof(addr));
+	addr.sin_family = AF_INET;
+	addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+	addr.sin_port = htons(atoi(port));
+	for (attempt = 0; attempt < STARTUP_ATTEMPTS; attempt++) {
+		int sd = socket(AF_INET, SOCK_STREAM, 0);
+		if (sd == -1)
+			err(1, "socket");
+		if (connect(sd, (struct sockaddr *)&addr, sizeof(addr)) == 0) {
+			close(sd);
+			return 0;
+		}
+		close(sd);
+		usleep(50000);
+	}
+	return -1;
+}
+
+static struct tls *connect_proxy() {
+	return client_connect(tls_cfg, "localhost", proxy_port);
+}
+
+/****
+ * Send one request over a persistent connection and read the whole response
+ * bytes: Incremented by the number of body bytes received
+ * return: 0 if the object came back whole. -1 otherwise
+ ****/
+static int request_object(struct tls *ctx, struct tls_stream *stream, const char *request, unsigned long long *bytes) {
+	struct response response;
+	char body[16384];
+	long long length;
+
+	if (tls_write_all(ctx, request, strlen(request)) == -1)
+		return -1;
+	if (read_response(stream, &response) == -1 || strcmp(response.status, RESP_OK) != 0 || response.length != object_size)
+		return -1;
+	length = response.length;
+	while (length > 0) {
+		ssize_t n = stream_read(stream, body, length < (long long)sizeof(body) ? length : (long long)sizeof(body));
+		if (n <= 0)
+			return -1;
+		length -= n;
+		*bytes += n;
+	}
+	return 0;
+}
+
+/****
+ * Request every object in order over one connection, passes times
+ * latency: Records the microseconds each request took
+ * return: Number of requests that failed
+ ****/
+static unsigned long long sequential_pass(struct histogram *latency, unsigned int passes) {
+	unsigned long long bytes = 0, errors = 0;
+	struct tls_stream stream;
+	struct tls *ctx;
+	unsigned int pass, i;
+
+	if ((ctx = connect_proxy()) == NULL)
+		return (unsigned long long)passes * num_objects;
+	stream_init(&stream, ctx);
+	for (pass = 0; pass < passes; pass++) {
+		for (i = 0; i < num_objects; i++) {
+			struct timespec start, end;
+
+			clock_gettime(CLOCK_MONOTONIC, &start);
+			if (request_object(ctx, &stream, requests[i], &bytes) == -1) {
+				errors++;
+				continue;
+			}
+			clock_gettime(CLOCK_MONOTONIC, &end);
+			histogram_record(latency, elapsed_us(&start, &end));
+		}
+	}
+	tls_close(ctx);
+	tls_free(ctx);
+	return errors;
+}
+
+static void *run_worker(void *arg) {
+	struct worker *worker = arg;
+	struct tls_stream stream;
+	struct tls *ctx;
+
+	if ((ctx = connect_proxy()) == NULL) {
+		worker->errors++;
+		return NULL;
+	}
+	stream_init(&stream, ctx);
+	while (time_left()) {
+		struct timespec start, end;
+		unsigned int i = random_next(&worker->random_state) % num_objects;
+
+		clock_gettime(CLOCK_MONOTONIC, &start);
+		if (request_object(ctx, &stream, requests[i], &worker->bytes) == -1) {
+			worker->errors++;
+			break;
+		}
+		clock_gettime(CLOCK_MONOTONIC, &end);
+		histogram_record(&worker->latency, elapsed_us(&start, &end));
+	}
+	tls_close(ctx);
+	tls_free(ctx);
+	return NULL;
+}
+
+static void print_latency(FILE *fp, const char *name, const struct histogram *latency, const char *indent) {
+	fprintf(fp, "%s\"%s\": {\"count\": %llu, \"mean_us\": %.1f, \"p50_us\": %llu, \"p90_us\": %llu, \"p99_us\": %llu, "
+	    "\"max_us\": %llu}", indent, name, latency->count, histogram_mean(latency), histogram_percentile(latency, 50),
+	    histogram_percentile(latency, 90), histogram_percentile(latency, 99), latency->max);
+}
+
+static void summarize(const char *name, const struct histogram *latency) {
+	fprintf(stderr, "%-10s %8llu requests  mean %8.1f us  p50 %6llu us  p99 %6llu us  max %6llu us\n", name,
+	    latency->count, histogram_mean(latency), histogram_percentile(latency, 50), histogram_percentile(latency, 99),
+	    latency->max);
+}
+
+int main(int argc, char *argv[])
+{
+	char bin_dir[PATH_MAX];
+	char certificates[PATH_MAX];
+	char resolved[PATH_MAX];
+	char server_port[16];
+	char server_arg[32];
+	const char *json_filename = NULL;
+	unsigned int num_connections = DEFAULT_CONNECTIONS;
+	unsigned int seconds = DEFAULT_SECONDS;
+	static struct histogram miss, hit, throughput;
+	unsigned long long errors, bytes = 0;
+	struct worker *workers;
+	struct timespec start, end;
+	pid_t server, proxy;
+	unsigned int i;
+	int arg;
+
+	/* Executables are next to this one in ../src, certificates where every executable expects them */
+	if (realpath("/proc/self/exe", bin_dir) == NULL)
+		err(1, "/proc/self/exe");
+	snprintf(bin_dir, sizeof(bin_dir), "%s/../src", dirname(strdup(bin_dir)));
+	if (realpath("../../certificates", certificates) == NULL)
+		certificates[0] = '\0';
+	if (argc % 2 != 1)
+		usage();
+	for (arg = 1; arg < argc; arg += 2) {
+		if (strcmp(argv[arg], "-bin") == 0)
+			snprintf(bin_dir, sizeof(bin_dir), "%s", argv[arg + 1]);
+		else if (strcmp(argv[arg], "-certificates") == 0 && realpath(argv[arg + 1], certificates) == NULL)
+			err(1, "%s", argv[arg + 1]);
+		else if (strcmp(argv[arg], "-certificates") == 0)
+			continue;
+		else if (strcmp(argv[arg], "-objects") == 0 && parse_number(argv[arg + 1], 1000000) > 0)
+			num_objects = parse_number(argv[arg + 1], 1000000);
+		else if (strcmp(argv[arg], "-size") == 0 && parse_number(argv[arg + 1], 1U << 30) > 0)
+			object_size = parse_number(argv[arg + 1], 1U << 30);
+		else if (strcmp(argv[arg], "-connections") == 0 && parse_number(argv[arg + 1], 4096) > 0)
+			num_connections = parse_number(argv[arg + 1], 4096);
+		else if (strcmp(argv[arg], "-seconds") == 0 && parse_number(argv[arg + 1], 86400) > 0)
+			seconds = parse_number(argv[arg + 1], 86400);
+		else if (strcmp(argv[arg], "-json") == 0)
+			json_filename = argv[arg + 1];
+		else
+			usage();
+	}
+	if (certificates[0] == '\0')
+		errx(1, "../../certificates not found. Use -certificates");
+	if (realpath(bin_dir, resolved) == NULL)
+		err(1, "%s", bin_dir);
+	snprintf(bin_dir, sizeof(bin_dir), "%s", resolved);
+
+	/* The JSON file is opened before changing into the scratch directory */
+	FILE *fp = stdout;
+	if (json_filename != NULL && (fp = fopen(json_filename, "w")) == NULL)
+		err(1, "%s", json_filename);
+
+	setup_scratch(certificates);
+	tls_cfg = client_tls_config();
+
+	free_port(server_port, sizeof(server_port));
+	free_port(proxy_port, sizeof(proxy_port));
+	snprintf(server_arg, sizeof(server_arg), "-localhost:%s", server_port);
+	server = spawn(bin_dir, "server", "-port", server_port, NULL);
+	if (wait_listening(server_port) == -1)
+		errx(1, "server did not start. See %s/server.log", scratch_dir);
+	proxy = spawn(bin_dir, "proxy", "-port", proxy_port, server_arg);
+	if (wait_listening(proxy_port) == -1) {
+		stop(server);
+		errx(1, "proxy did not start. See %s/proxy.log", scratch_dir);
+	}
+	fprintf(stderr, "server on port %s, proxy on port %s, %u objects of %u bytes\n", server_port, proxy_port,
+	    num_objects, object_size);
+
+	histogram_init(&miss);
+	histogram_init(&hit);
+	errors = sequential_pass(&miss, 1);
+	errors += sequential_pass(&hit, HIT_PASSES);
+
+	if ((workers = calloc(num_connections, sizeof(*workers))) == NULL)
+		err(1, "calloc");
+	histogram_init(&throughput);
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	stop_time = start;
+	stop_time.tv_sec += seconds;
+	for (i = 0; i < num_connections; i++) {
+		histogram_init(&workers[i].latency);
+		workers[i].random_state = 0x9E3779B97F4A7C15ULL * (i + 1);
+		if (pthread_create(&workers[i].thread, NULL, run_worker, &workers[i]) != 0)
+			errx(1, "pthread_create failed");
+	}
+	for (i = 0; i < num_connections; i++) {
+		pthread_join(workers[i].thread, NULL);
+		histogram_merge(&throughput, &workers[i].latency);
+		bytes += workers[i].bytes;
+		errors += workers[i].errors;
+	}
+	clock_gettime(CLOCK_MONOTONIC, &end);
+	double elapsed = elapsed_us(&start, &end) / 1e6;
+
+	stop(proxy);
+	stop(server);
+
+	summarize("miss", &miss);
+	summarize("hit", &hit);
+	summarize("throughput", &throughput);
+	fprintf(stderr, "%u connections: %.1f requests/s, %.2f MB/s, %llu errors\n", num_connections,
+	    throughput.count / elapsed, bytes / elapsed / 1e6, errors);
+
+	fprintf(fp, "{\n  \"benchmark\": \"e2e\",\n  \"objects\": %u,\n  \"object_size\": %u,\n  \"errors\": %llu,\n",
+	    num_objects, object_size, errors);
+	print_latency(fp, "miss", &miss, "  ");
+	fprintf(fp, ",\n");
+	print_latency(fp, "hit", &hit, "  ");
+	fprintf(fp, ",\n  \"throughput\": {\"connections\": %u, \"seconds\": %.3f, \"requests\": %llu, "
+	    "\"requests_per_s\": %.1f, \"mb_per_s\": %.3f,\n", num_connections, elapsed, throughput.count,
+	    throughput.count / elapsed, bytes / elapsed / 1e6);
+	print_latency(fp, "latency", &throughput, "    ");
+	fprintf(fp, "}\n}\n");
+	if (fp != stdout)
+		fclose(fp);
+
+	free(workers);
+	free(requests);
+	tls_config_free(tls_cfg);
+	if (errors > 0) {
+		warnx("%llu requests failed. Logs are in %s", errors, scratch_dir);
+		return 1;
+	}
+	chdir("/");
+	nftw(scratch_dir, remove_entry, 16, FTW_DEPTH | FTW_PHYS);
+	return 0;
+}
@@ -0,0 +1,251 @@
+/*
+ * microbench.c - Micro-benchmarks of hashing, Bloom filters and proxy selection
+ *
+ * Every case repeats one operation in batches until its time budget is used up and
+ * reports nanoseconds per operation: MurmurHash3_x86_32 and MurmurHash3_x64_128 for
+ * a range of key lengths, inserting into and looking up present and absent object
+ * names in a blacklist-sized Bloom filter, and choosing the proxy server for an
+ * object by rendezvous hashing. The code measured is the code the client and proxy
+ * run. A summary is printed to stderr and the results are written as JSON to stdout
+ * or a file, so runs can be compared.
+ */
+
+#include <sys/types.h>
+
+#include <err.h>
+#include <errno.h>
+#include <limits.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "bloom.h"
+#include "murmur3.h"
+#include "options.h"
+#include "protocol.h"
+#include "rendezvous.h"
+
+const unsigned int NUM_PROXIES = 6;
+const char *PROXY_NAMES[] = {"one", "two", "three", "four", "five", "six"};
+const unsigned int DEFAULT_MILLISECONDS = 250;
+const unsigned int BATCH = 1024;
+const unsigned int NUM_KEYS = 10000;
+const int KEY_LENGTHS[] = {4, 8, 16, 32, 64, 256, 1024, 4096};
+#define NUM_KEY_LENGTHS (sizeof(KEY_LENGTHS) / sizeof(KEY_LENGTHS[0]))
+#define MAX_RESULTS 64
+
+struct result {
+	const char *name;
+	int key_bytes;				/* Length of the hashed key. 0 if keys are object names */
+	unsigned long long ops;
+	double seconds;
+	double false_positive_rate;		/* Share of absent names a lookup found. -1 if not measured */
+};
+
+static struct result results[MAX_RESULTS];
+static unsigned int num_results;
+static double budget;				/* Seconds every case runs for */
+static volatile uint64_t sink;			/* Keeps the compiler from dropping the measured work */
+
+void usage(void)
+{
+	extern char * __progname;
+	fprintf(stderr, "usage: %s [-milliseconds per-case] [-json filename]\n", __progname);
+	exit(1);
+}
+
+static double elapsed_s(const struct timespec *start) {
+	struct timespec now;
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return (now.tv_sec - start->tv_sec) + (now.tv_nsec - start->tv_nsec) / 1e9;
+}
+
+static struct result *add_result(const char *name, int key_bytes, unsigned long long ops, double seconds) {
+	struct result *result = &results[num_results++];
+
+	result->name = name;
+	result->key_bytes = key_bytes;
+	result->ops = ops;
+	result->seconds = seconds;
+	result->false_positive_rate = -1;
+	if (key_bytes > 0)
+		fprintf(stderr, "%-24s %5d bytes %10.1f ns/op %10.1f MB/s\n", name, key_bytes, seconds * 1e9 / ops,
+		    (double)key_bytes * ops / seconds / 1e6);
+	else
+		fprintf(stderr, "%-24s %11s %10.1f ns/op\n", name, "", seconds * 1e9 / ops);
+	return result;
+}
+
+static void bench_murmur() {
+	char key[4096];
+	unsigned int i, j;
+
+	for (i = 0; i < sizeof(key); i++)
+		key[i] = (char)(i * 131 + 7);
+
+	for (j = 0; j < NUM_KEY_LENGTHS; j++) {
+		struct timespec start;
+		unsigned long long ops = 0;
+		uint32_t hash32;
+
+		clock_gettime(CLOCK_MONOTONIC, &start);
+		do {
+			for (i = 0; i < BATCH; i++) {
+				MurmurHash3_x86_32(key, KEY_LENGTHS[j], i, &hash32);
+				sink ^= hash32;
+			}
+			ops += BATCH;
+		} while (elapsed_s(&start) < budget);
+		add_result("murmur3_x86_32", KEY_LENGTHS[j], ops, elapsed_s(&start));
+	}
+
+	for (j = 0; j < NUM_KEY_LENGTHS; j++) {
+		struct timespec start;
+		unsigned long long ops = 0;
+		uint64_t hash128[2];
+
+		clock_gettime(CLOCK_MONOTONIC, &start);
+		do {
+			for (i = 0; i < BATCH; i++) {
+				MurmurHash3_x64_128(key, KEY_LENGTHS[j], i, hash128);
+				sink ^= hash128[0] ^ hash128[1];
+			}
+			ops += BATCH;
+		} while (elapsed_s(&start) < budget);
+		add_result("murmur3_x64_128", KEY_LENGTHS[j], ops, elapsed_s(&start));
+	}
+}
+
+/****
+ * Time an operation over a set of object names
+ * op: 0 to insert, 1 to look up
+ * found: Set to the number of names the last pass over the set found in the filter
+ * return: Nothing
+ ****/
+static void bench_bloom_pass(const char *name, unsigned int *filter, char (*names)[MAX_OBJECT_NAME + 1], int op,
+    unsigned int *found)
+{
+	struct timespec start;
+	unsigned long long ops = 0;
+	unsigned int i;
+
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	do {
+		*found = 0;
+		for (i = 0; i < NUM_KEYS; i++) {
+			if (op == 0)
+				insert_bloom_filter(filter, NUM_BLOOM_HASHES, NUM_BLOOM_BITS, names[i]);
+			else
+				*found += search_bloom_filter(filter, NUM_BLOOM_HASHES, NUM_BLOOM_BITS, names[i]);
+		}
+		ops += NUM_KEYS;
+	} while (elapsed_s(&start) < budget);
+	struct result *result = add_result(name, 0, ops, elapsed_s(&start));
+	if (op == 1 && strcmp(name, "bloom_lookup_absent") == 0) {
+		result->false_positive_rate = (double)*found / NUM_KEYS;
+		fprintf(stderr, "%-24s %11s %10.6f\n", "bloom_false_positives", "", result->false_positive_rate);
+	}
+}
+
+static void bench_bloom(char (*present)[MAX_OBJECT_NAME + 1], char (*absent)[MAX_OBJECT_NAME + 1]) {
+	unsigned int *filter;
+	unsigned int found;
+
+	if ((filter = calloc(NUM_BLOOM_INTS, sizeof(*filter))) == NULL)
+		err(1, "calloc");
+	bench_bloom_pass("bloom_insert", filter, present, 0, &found);
+	bench_bloom_pass("bloom_lookup_present", filter, present, 1, &found);
+	if (found != NUM_KEYS)
+		errx(1, "Bloom filter lost %u inserted names", NUM_KEYS - found);
+	bench_bloom_pass("bloom_lookup_absent", filter, absent, 1, &found);
+	free(filter);
+}
+
+static void bench_rendezvous(char (*names)[MAX_OBJECT_NAME + 1]) {
+	struct timespec start;
+	unsigned long long ops = 0;
+	char request[MAX_LINE];
+	unsigned int i;
+
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	do {
+		for (i = 0; i < NUM_KEYS; i++)
+			sink += rendezvous_proxy(names[i]);
+		ops += NUM_KEYS;
+	} while (elapsed_s(&start) < budget);
+	add_result("rendezvous_proxy", 0, ops, elapsed_s(&start));
+
+	ops = 0;
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	do {
+		for (i = 0; i < NUM_KEYS; i++)
+			sink += format_request(request, sizeof(request), names[i]);
+		ops += NUM_KEYS;
+	} while (elapsed_s(&start) < budget);
+	add_result("format_request", 0, ops, elapsed_s(&start));
+}
+
+static void write_json(FILE *fp) {
+	unsigned int i;
+
+	fprintf(fp, "{\n  \"benchmark\": \"micro\",\n  \"seconds_per_case\": %.3f,\n  \"object_names\": %u,\n"
+	    "  \"proxies\": %u,\n  \"results\": [\n", budget, NUM_KEYS, NUM_PROXIES);
+	for (i = 0; i < num_results; i++) {
+		const struct result *result = &results[i];
+
+		fprintf(fp, "    {\"name\": \"%s\"", result->name);
+		if (result->key_bytes > 0)
+			fprintf(fp, ", \"key_bytes\": %d", result->key_bytes);
+		fprintf(fp, ", \"ops\": %llu, \"ns_per_op\": %.2f", result->ops, result->seconds * 1e9 / result->ops);
+		if (result->key_bytes > 0)
+			fprintf(fp, ", \"mb_per_s\": %.1f", (double)result->key_bytes * result->ops / result->seconds / 1e6);
+		if (result->false_positive_rate >= 0)
+			fprintf(fp, ", \"false_positive_rate\": %.6f", result->false_positive_rate);
+		fprintf(fp, "}%s\n", i + 1 < num_results ? "," : "");
+	}
+	fprintf(fp, "  ]\n}\n");
+}
+
+int main(int argc, char *argv[])
+{
+	const char *json_filename = NULL;
+	char (*present)[MAX_OBJECT_NAME + 1];
+	char (*absent)[MAX_OBJECT_NAME + 1];
+	unsigned int i;
+	int arg;
+
+	budget = DEFAULT_MILLISECONDS / 1000.0;
+	if (argc % 2 != 1)
+		usage();
+	for (arg = 1; arg < argc; arg += 2) {
+		if (strcmp(argv[arg], "-milliseconds") == 0 && parse_number(argv[arg + 1], 60000) > 0)
+			budget = parse_number(argv[arg + 1], 60000) / 1000.0;
+		else if (strcmp(argv[arg], "-json") == 0)
+			json_filename = argv[arg + 1];
+		else
+			usage();
+	}
+
+	if ((present = malloc(NUM_KEYS * sizeof(*present))) == NULL || (absent = malloc(NUM_KEYS * sizeof(*absent))) == NULL)
+		err(1, "malloc");
+	for (i = 0; i < NUM_KEYS; i++) {
+		snprintf(present[i], sizeof(present[i]), "object-%u.txt", i);
+		snprintf(absent[i], sizeof(absent[i]), "missing-%u.txt", i);
+	}
+
+	bench_murmur();
+	bench_bloom(present, absent);
+	bench_rendezvous(present);
+
+	FILE *fp = stdout;
+	if (json_filename != NULL && (fp = fopen(json_filename, "w")) == NULL)
+		err(1, "%s", json_filename);
+	write_json(fp);
+	if (fp != stdout)
+		fclose(fp);
+
+	free(present);
+	free(absent);
+	return 0;
+}
@@ -25,127 +25,498 @@
 #include <err.h>
 #include <errno.h>
 #include <limits.h>
-#include <signal.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <time.h>
 #include <unistd.h>
 #include <tls.h>
-#include "murmur3.h"
+#include "connection.h"
+#include "fanout.h"
+#include "latency.h"
+#include "loadgen.h"
+#include "log.h"
+#include "protocol.h"
+#include "rendezvous.h"
+#include "spread.h"
+#include "trace.h"
 
 
 const unsigned int NUM_PROXIES = 6;
 const char *PROXY_NAMES[] = {"one", "two", "three", "four", "five", "six"};
+const unsigned int MAX_BUSY_RETRIES = 3;
+const unsigned int MAX_PIPELINE = 256;
+const unsigned int DEFAULT_FANOUT_PIPELINE = 16;
+
+static unsigned long trace_sample = 0;		/* One in this many requests is sampled */
+static uint64_t random_state;			/* Picks the proxy server for requests for hot objects */
 
 static void usage()
 {
 	extern char * __progname;
-	fprintf(stderr, "usage: %s -port proxyportnumber filename\n", __progname);
+	fprintf(stderr, "usage: %s -port proxyportnumber | -nodes nodetable filename [-pipeline depth]\n"
+	    "          [-fanout directory] [-log-level error|warn|info|debug] [-trace filename] [-trace-sample n]\n"
+	    "       %s -port proxyportnumber | -nodes nodetable -bench [-connections count]\n"
+	    "          [-rate requests-per-second] [-duration seconds] [-keys count | -objects filename]\n"
+	    "          [-zipf exponent] [-verify seed [-verify-sizes bytes|uniform:min-max|pareto:min-max]]\n"
+	    "       %s -port proxyportnumber | -nodes nodetable -replay capturefile [-speed factor]\n"
+	    "          [-connections count] [-admin-port proxyadminport] [-verify seed [-verify-sizes spec]]\n",
+	    __progname, __progname, __progname);
 	exit(1);
 }
 
+/****
+ * Parse a non-negative number given on the command line
+ * return: The parsed number. Exits with the usage message if arg is not a number
+ ****/
+static double parse_number(const char *arg)
+{
+	char *ep;
+	double value = strtod(arg, &ep);
+
+	if (*arg == '\0' || *ep != '\0' || value < 0) {
+		fprintf(stderr, "%s - not a number\n", arg);
+		usage();
+	}
+	return value;
+}
+
+/****
+ * Set where the proxy servers are reached: one local port for all of them, or the
+ * nodes listed in a node table
+ * return: 1 if option was -port or -nodes. 0 otherwise
+ ****/
+static int parse_nodes(const char *option, const char *value)
+{
+	if (strcmp(option, "-port") == 0)
+		nodes_local(value);
+	else if (strcmp(option, "-nodes") == 0)
+		nodes_load(value);
+	else
+		return 0;
+	return 1;
+}
+
+/****
+ * Parse the options checking responses against a server started with -synthetic
+ * return: 1 if the option was one of them. 0 otherwise
+ ****/
+static int parse_verify(const char *option, const char *value, struct load_config *config)
+{
+	char *ep;
+
+	if (strcmp(option, "-verify") == 0) {
+		errno = 0;
+		config->verify_seed = strtoull(value, &ep, 10);
+		if (*value < '0' || *value > '9' || *ep != '\0' || errno == ERANGE) {
+			fprintf(stderr, "%s - not a seed\n", value);
+			usage();
+		}
+		config->verify = 1;
+		return 1;
+	}
+	if (strcmp(option, "-verify-sizes") == 0) {
+		if (synthetic_parse_sizes(value, &config->verify_size_spec) == -1)
+			usage();
+		config->verify_sizes = 1;
+		return 1;
+	}
+	return 0;
+}
+
+/****
+ * Run the client in load generator mode
+ * return: Exit status
+ ****/
+static int bench(int argc, char *argv[])
+{
+	struct load_config config = { .connections = 1, .duration = 10, .speed = 1 };
+	int arg;
+
+	for (arg = 4; arg + 1 < argc; arg += 2) {
+		if (strcmp(argv[arg], "-connections") == 0 && parse_number(argv[arg + 1]) >= 1)
+			config.connections = parse_number(argv[arg + 1]);
+		else if (strcmp(argv[arg], "-rate") == 0)
+			config.rate = parse_number(argv[arg + 1]);
+		else if (strcmp(argv[arg], "-duration") == 0)
+			config.duration = parse_number(argv[arg + 1]);
+		else if (strcmp(argv[arg], "-keys") == 0 && parse_number(argv[arg + 1]) >= 1)
+			config.num_keys = parse_number(argv[arg + 1]);
+		else if (strcmp(argv[arg], "-objects") == 0)
+			config.objects = argv[arg + 1];
+		else if (strcmp(argv[arg], "-zipf") == 0)
+			config.zipf = parse_number(argv[arg + 1]);
+		else if (!parse_verify(argv[arg], argv[arg + 1], &config))
+			usage();
+	}
+	if (arg != argc || (config.num_keys == 0) == (config.objects == NULL))	// Exactly one keyspace
+		usage();
+	if (config.verify_sizes && !config.verify)
+		usage();
+	return run_load(&config);
+}
+
+/****
+ * Replay a capture taken by a proxy server
+ * return: Exit status
+ ****/
+static int replay(int argc, char *argv[])
+{
+	struct load_config config = { .connections = 1, .replay = argv[4], .speed = 1 };
+	int arg;
+
+	for (arg = 5; arg + 1 < argc; arg += 2) {
+		if (strcmp(argv[arg], "-speed") == 0 && parse_number(argv[arg + 1]) > 0)
+			config.speed = parse_number(argv[arg + 1]);
+		else if (strcmp(argv[arg], "-connections") == 0 && parse_number(argv[arg + 1]) >= 1)
+			config.connections = parse_number(argv[arg + 1]);
+		else if (strcmp(argv[arg], "-admin-port") == 0 && parse_number(argv[arg + 1]) <= USHRT_MAX)
+			config.admin_port = parse_number(argv[arg + 1]);
+		else if (!parse_verify(argv[arg], argv[arg + 1], &config))
+			usage();
+	}
+	if (arg != argc || (config.verify_sizes && !config.verify))
+		usage();
+	return run_load(&config);
+}
+
+/****
+ * Read the proxy server's response and print the object it contains
+ * stream: Stream over the TLS connection to the proxy server
+ * request: Request line the response answers, to record whether its object is hot
+ * return: Seconds to wait before retrying if the proxy server was too busy. 0 otherwise
+ ****/
+static unsigned int print_response(struct tls_stream *stream, const char *request)
+{
+	struct response resp;
+	char response[255];
+	long long length;
+
+	if (read_response(stream, &resp) == -1) {
+		if (resp.line[0] == '\0')
+			errx(1, "No response from proxy server");
+		errx(1, "Malformed response from proxy server: %s", resp.line);
+	}
+	spread_note(request, &resp);
+
+	if (strcmp(resp.status, RESP_BUSY) == 0) {
+		printf("****busy**** retry after %u seconds\n", resp.retry_after);
+		return resp.retry_after;
+	} else if (strcmp(resp.status, RESP_BLACKLISTED) == 0) {
+		printf("****black-listed****\n");
+		return 0;
+	} else if (strcmp(resp.status, RESP_NOT_FOUND) == 0) {
+		printf("****not-found****\n");
+		return 0;
+	} else if (strcmp(resp.status, RESP_BAD_RANGE) == 0) {
+		printf("****bad-range**** %s\n", resp.line + strlen(resp.status));
+		return 0;
+	} else if (strcmp(resp.status, RESP_INVALID) == 0) {
+		printf("****invalid-request****\n");
+		return 0;
+	} else if (strcmp(resp.status, RESP_UNAVAILABLE) == 0) {
+		printf("****unavailable****\n");
+		return 0;
+	} else if (strcmp(resp.status, RESP_PARTIAL) == 0) {
+		printf("Bytes %lld-%lld of %lld:\n", resp.first, resp.last, resp.size);
+	}
+
+	length = resp.length;
+	while (length > 0) {
+		ssize_t n = stream_read(stream, response, length < (long long)sizeof(response) ? length : sizeof(response));
+		if (n <= 0)
+			errx(1, "Proxy server closed connection before sending the whole object");
+		printf("%.*s", (int)n, response);
+		length -= n;
+	}
+	return 0;
+}
+
+/****
+ * Give a request line a new request ID
+ * request: Request line ending in '\n'. The trace field is added before the newline
+ * trace: Set to the request's trace
+ * return: Nothing
+ ****/
+static void add_request_id(char *request, size_t size, struct trace_context *trace)
+{
+	size_t len = strlen(request);
+
+	trace_new(trace, trace_sample);
+	if (len > 0 && request[len - 1] == '\n')
+		len--;
+	len += trace_format(trace, request + len, size - len);
+	snprintf(request + len, size - len, "\n");
+}
+
+/****
+ * Send a request for an object a proxy server reported hot to one of the proxy
+ * servers replicating it, chosen at random
+ * request: MAX_LINE bytes. Request line naming the object's highest ranked proxy server. Rewritten if spread
+ * proxy: Index of the proxy server the request names. Set to the chosen proxy server
+ * return: Nothing
+ ****/
+static void spread_hot(char *request, unsigned int *proxy)
+{
+	char redirected[MAX_LINE];
+
+	if (spread_request(request, redirected, proxy, &random_state) == redirected) {
+		snprintf(request, MAX_LINE, "%s", redirected);
+		log_debug("Spreading hot object to proxy server %s", PROXY_NAMES[*proxy]);
+	}
+}
+
+/****
+ * Record the span of a request whose response has been read
+ * started: Time the request was sent, from latency_clock
+ * return: Nothing
+ ****/
+static void end_request(const struct trace_context *trace, const char *request, unsigned long long started)
+{
+	char object_name[MAX_OBJECT_NAME + 1];
+
+	if (sscanf(request, "%*s %255s", object_name) != 1)
+		object_name[0] = '\0';
+	trace_begin(trace);
+	trace_end("request", started, object_name);
+}
+
+/****
+ * Open a TLS connection to the proxy server
+ * return: The connection. Exits on error
+ ****/
+static struct tls *connect_proxy(struct tls_config *cfg)
+{
+	const struct node *node = node_of(0);
+	struct tls *ctx;
+
+	if ((ctx = client_connect(cfg, node->host, node->port)) == NULL)
+		exit(1);
+	return ctx;
+}
+
+/****
+ * Request every object in a file over one connection, keeping up to depth requests
+ * outstanding. The proxy server answers them in order. If it is too busy to take
+ * the connection, the unanswered requests are sent again on a new one. One node
+ * must serve every proxy server
+ * return: Exit status
+ ****/
+static int run_pipelined(FILE *fp, unsigned int depth)
+{
+	char (*outstanding)[MAX_LINE];			// Requests sent but not answered yet, oldest at head
+	struct trace_context *traces;
+	unsigned long long *sent;
+	unsigned int head = 0, count = 0, i;
+	unsigned int num_requests = 0, busy_retries = 0;
+	struct tls_config *cfg;
+	struct tls_stream stream;
+	struct tls *ctx;
+	char line[MAX_LINE];
+	int eof = 0;
+
+	if ((outstanding = calloc(depth, sizeof(*outstanding))) == NULL || (traces = calloc(depth, sizeof(*traces))) == NULL ||
+	    (sent = calloc(depth, sizeof(*sent))) == NULL)
+		err(1, "calloc");
+	cfg = client_tls_config();				// A busy proxy server may close before reading the requests
+
+	ctx = connect_proxy(cfg);
+	stream_init(&stream, ctx);
+	log_info("Connected to proxy server. Keeping up to %u requests outstanding", depth);
+
+	for (;;) {
+		while (!eof && count < depth) {			// Fill the pipeline
+			unsigned int slot = (head + count) % depth;
+			char *request = outstanding[slot];
+			if (fgets(line, sizeof(line), fp) == NULL) {
+				eof = 1;
+				break;
+			}
+			int ranked = format_request(request, MAX_LINE, line);
+			if (ranked == -1)
+				continue;
+			unsigned int proxy = ranked;
+			spread_hot(request, &proxy);
+			add_request_id(request, MAX_LINE, &traces[slot]);
+			sent[slot] = latency_clock();
+			if (tls_write_all(ctx, request, strlen(request)) == -1)
+				errx(1, "tls_write: %s", tls_error(ctx));
+			count++;
+		}
+		if (count == 0)
+			break;
+
+		printf("Proxy server response to %s", outstanding[head]);
+		unsigned int retry_after = print_response(&stream, outstanding[head]);
+		printf("\n");
+		if (retry_after == 0) {
+			end_request(&traces[head], outstanding[head], sent[head]);
+			head = (head + 1) % depth;
+			count--;
+			num_requests++;
+			continue;
+		}
+
+		if (busy_retries++ == MAX_BUSY_RETRIES)
+			errx(1, "Proxy server stayed busy");
+		tls_free(ctx);
+		sleep(retry_after);
+		ctx = connect_proxy(cfg);
+		stream_init(&stream, ctx);
+		for (i = 0; i < count; i++) {
+			const char *request = outstanding[(head + i) % depth];
+			if (tls_write_all(ctx, request, strlen(request)) == -1)
+				errx(1, "tls_write: %s", tls_error(ctx));
+		}
+	}
+
+	if (tls_close(ctx) != 0)
+		warnx("tls_close: %s", tls_error(ctx));
+	tls_free(ctx);
+	tls_config_free(cfg);
+	free(outstanding);
+	free(traces);
+	free(sent);
+	printf("Received %u responses over one connection\n", num_requests);
+	return 0;
+}
+
 int main(int argc, char *argv[])
 {
-	if (argc != 4 || strcmp(argv[1], "-port") != 0)			// Check if executable is used properly
+	if (argc < 4 || !parse_nodes(argv[1], argv[2]))
+		usage();
+	if (strcmp(argv[3], "-bench") == 0)
+		return bench(argc, argv);
+	if (argc >= 5 && strcmp(argv[3], "-replay") == 0)
+		return replay(argc, argv);
+	if (argc > 14 || argc % 2 != 0)			// Check if executable is used properly
         	usage();
 
+	const char *out_dir = NULL;
+	double depth = -1;
+	enum log_level log_level = LOG_LEVEL_INFO;
+	const char *trace_path = NULL;
+	double sample = -1;
+	int arg;
+
+	for (arg = 4; arg < argc; arg += 2) {
+		if (strcmp(argv[arg], "-pipeline") == 0 && depth == -1)
+			depth = parse_number(argv[arg + 1]);
+		else if (strcmp(argv[arg], "-fanout") == 0 && out_dir == NULL)
+			out_dir = argv[arg + 1];
+		else if (strcmp(argv[arg], "-log-level") == 0 && log_parse_level(argv[arg + 1], &log_level) == 0)
+			continue;
+		else if (strcmp(argv[arg], "-trace") == 0 && trace_path == NULL)
+			trace_path = argv[arg + 1];
+		else if (strcmp(argv[arg], "-trace-sample") == 0 && sample == -1)
+			sample = parse_number(argv[arg + 1]);
+		else
+			usage();
+	}
+	log_init(STDERR_FILENO, log_level, 0);		// Objects go to stdout
+	if (trace_path != NULL)
+		trace_init(trace_path, "client");
+	if (sample == -1)
+		sample = trace_path != NULL;		// A client writing a trace samples every request unless told otherwise
+	trace_sample = sample;
+	random_state = ((uint64_t)time(NULL) << 32 ^ (uint64_t)getpid()) | 1;	// Never 0
+
+	if (depth != -1 || out_dir != NULL) {
+		FILE *list;
+
+		if (depth == -1)
+			depth = DEFAULT_FANOUT_PIPELINE;
+		if (depth < 1 || depth > MAX_PIPELINE)
+			usage();
+		if ((list = fopen(argv[3], "r")) == NULL)
+			err(1, "File not found!");
+		if (out_dir != NULL)
+			return run_fanout(list, out_dir, depth);
+		if (!nodes_shared())
+			errx(1, "-pipeline needs one node serving every proxy server. Use -fanout with a node table");
+		return run_pipelined(list, depth);
+	}
+
 	FILE *fp;
-  	uint32_t hashes[NUM_PROXIES];
-        char object_name[255];
-        char request[255];
-        char response[255];
+	struct tls_config *cfg;
+	char line[MAX_LINE];
+        char object_name[MAX_OBJECT_NAME + 1];
+	char range[64];
+        char request[MAX_LINE];
+	unsigned int retry_after = 0;
+	unsigned int busy_retries = 0;
         memset(object_name, 0, sizeof(object_name));
         memset(request, 0, sizeof(request));
-        memset(response, 0, sizeof(response));
 
         if((fp = fopen(argv[3], "r")) == NULL)
                 err(1, "File not found!");
 
-        while (fscanf(fp, "%s", object_name) > 0) {			// New TLS connection for each object requested in file	
+	cfg = client_tls_config();				// A busy proxy server may close before reading the request
+
+        while (retry_after > 0 || fgets(line, sizeof(line), fp) != NULL) {	// New TLS connection for each object requested in file
+		if (retry_after > 0) {					// Request the same object again once the proxy server asked us to
+			sleep(retry_after);
+			busy_retries++;
+		} else {
+			busy_retries = 0;
+		}
+		memset(range, 0, sizeof(range));				// Each line has the form "object_name [range]"
+		if (sscanf(line, "%255s %63s", object_name, range) < 1)
+			continue;
+
+		/**** Rendezvous hashing with proxy names  ****/
+		unsigned int max_index = rendezvous_proxy(object_name);
+		log_debug("Proxy server %s has the highest hash for %s", PROXY_NAMES[max_index], object_name);
+		/**** End rendezvous hashing with proxy names  ****/
+
+		snprintf(request, sizeof(request), "%s %s%s%s\n",	// Create request with form "PROXY_NAME OBJECT_NAME [RANGE] [TRACE]"
+		    PROXY_NAMES[max_index], object_name, range[0] ? " " : "", range);
+		unsigned int proxy = max_index;
+		spread_hot(request, &proxy);				// A hot object may be requested from any of its replicas
+
 		/**** TLS connection to proxy server ****/
-		struct tls_config *cfg = NULL;
 		struct tls *ctx = NULL;
+		unsigned long long started = latency_clock();
 	
-		if (tls_init() != 0)
-			err(1, "tls_init:");
-		printf("Initialized TLS\n");
-	
-		if ((cfg = tls_config_new()) == NULL)
-			err(1, "tls_config_new:");
-		printf("Got TLS config\n");
-	
-		if (tls_config_set_ca_file(cfg, "../../certificates/root.pem") != 0)
-			err(1, "tls_config_set_ca_file:");
-		printf("Set root certificate\n");
-	
-		if ((ctx = tls_client()) == NULL)
-			err(1, "tls_client:");
-		printf("Got TLS client\n");
-	
-		if (tls_configure(ctx, cfg) != 0)
-			err(1, "tls_configure: %s", tls_error(ctx));
-		printf("Configured TLS client with TLS config\n");
-	
-		if (tls_connect(ctx, "localhost", argv[2]) != 0)
-			err(1, "tls_connect: %s", tls_error(ctx));
-		printf("Connected to proxy server\n");
-		printf("\n");
+		const struct node *node = node_of(proxy);		// Connect to the node serving the chosen proxy
+		if ((ctx = client_connect(cfg, node->host, node->port)) == NULL)
+			exit(1);
+		log_debug("Connected to proxy server %s at %s:%s", PROXY_NAMES[proxy], node->host, node->port);
 		/**** End TLS connection to proxy server  ****/
 
-		/**** Rendezvous hashing with proxy names  ****/
-		printf("Computing hashes for each objectname|proxyname\n");
-		unsigned int i;
-		for (i = 0; i < NUM_PROXIES; i++) {			// Calculate hashes for object_name.PROXY_NAMES[i]
-			char str[255];
-			memset(str, 0, sizeof(str));
-			strcpy(str, object_name);
-			strcat(str, PROXY_NAMES[i]);
-			MurmurHash3_x86_32(str, strlen(str), 42, &hashes[i]);
-			printf("%s|%s: %x\n", object_name, PROXY_NAMES[i], hashes[i]); 
-		}				
-		printf("\n");		
-
-		unsigned int max_index = 0;
-		for (i = 0; i < NUM_PROXIES; i++) {			// Get index of proxy that produced the highest hash value
-			if (hashes[i] > hashes[max_index])
-				max_index = i;
-		}
-		/**** End rendezvous hashing with proxy names  ****/
-
 		/**** Send request for object to selected proxy  ****/
-		strcpy(request, PROXY_NAMES[max_index]);		// Create request with form "PROXY_NAME OBJECT_NAME"
-		strcat(request, " ");
-		strcat(request, object_name); 
+		struct trace_context trace;
+		add_request_id(request, sizeof(request), &trace);
 
-		if (tls_write(ctx, request, strlen(request)) < 0)
+		if (tls_write_all(ctx, request, strlen(request)) == -1)
 			err(1, "tls_write: %s", tls_error(ctx));
-		printf("Sent request to proxy server %s for %s\n", PROXY_NAMES[max_index], object_name);
+		log_info("Sent request %016llx to proxy server %s for %s%s%s", trace.id, PROXY_NAMES[proxy], object_name,
+		    range[0] ? " " : "", range);
 
-		printf("Proxy server response:\n");
-		while (tls_read(ctx, response, sizeof(response)) > 0){
-			printf("%s", response);
-			memset(response, 0, sizeof(response));
-		}
+		struct tls_stream stream;
+		stream_init(&stream, ctx);
+		printf("Proxy server response to %s", request);
+		retry_after = print_response(&stream, request);
+		end_request(&trace, request, started);
+		int busy = retry_after > 0;				// A busy proxy server closes without waiting for us
+		if (busy_retries == MAX_BUSY_RETRIES)
+			retry_after = 0;
 		printf("\n");
 		/**** End send request for object to selected proxy ****/
 
 		/**** Close TLS connection with proxy server ****/
-		if (tls_close(ctx) != 0)
+		if (tls_close(ctx) != 0 && !busy)
 			err(1, "tls_close: %s", tls_error(ctx));
-		printf("Closed TLS client\n");
-	
+		log_debug("Closed TLS client");
+
 		tls_free(ctx);
-		printf("Freed TLS client\n");
-	
-		tls_config_free(cfg);
-		printf("Freed TLS config\n");
-		printf("\n");
+		log_debug("Freed TLS client");
 		/**** End close TLS connection with proxy server ****/
 
-		memset(object_name, 0, sizeof(object_name));		// Reset object_name, request, and response for next object
+		memset(object_name, 0, sizeof(object_name));		// Reset object_name and request for next object
        		memset(request, 0, sizeof(request));
-                memset(response, 0, sizeof(response));
         }
 
+	tls_config_free(cfg);
 	return(0);
 }
@@ -0,0 +1,107 @@
+/*
+ * connection.c - Connecting to proxy servers and reading their responses
+ *
+ * Every mode of the client, and the end-to-end benchmark, talks to the proxy
+ * servers through these functions, so a change to the status lines of the
+ * protocol is parsed in one place.
+ */
+
+#include <err.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "connection.h"
+
+/****
+ * Initialize TLS and build the configuration for connections to proxy servers. A
+ * write to a proxy server that already closed the connection, such as a busy one,
+ * fails instead of killing the process
+ * return: The configuration. Exits on error
+ ****/
+struct tls_config *client_tls_config(void)
+{
+	struct tls_config *cfg;
+
+	if (tls_init() != 0)
+		errx(1, "tls_init failed");
+	if ((cfg = tls_config_new()) == NULL)
+		errx(1, "tls_config_new failed");
+	if (tls_config_set_ca_file(cfg, "../../certificates/root.pem") != 0)
+		errx(1, "tls_config_set_ca_file: %s", tls_config_error(cfg));
+	signal(SIGPIPE, SIG_IGN);
+	return cfg;
+}
+
+/****
+ * Open a TLS connection to a proxy server
+ * return: The connection. NULL with a warning if it could not be opened
+ ****/
+struct tls *client_connect(struct tls_config *cfg, const char *host, const char *port)
+{
+	struct tls *ctx;
+
+	if ((ctx = tls_client()) == NULL) {
+		warnx("tls_client failed");
+		return NULL;
+	}
+	if (tls_configure(ctx, cfg) != 0 || tls_connect(ctx, host, port) != 0) {
+		warnx("tls_connect %s:%s: %s", host, port, tls_error(ctx));
+		tls_free(ctx);
+		return NULL;
+	}
+	return ctx;
+}
+
+/****
+ * Read and parse the status line of a proxy server's response. The body, if any, is
+ * left in the stream
+ * response: Filled with the status line and its fields
+ * return: 0 on success. -1 if the connection ended before a status line or the status
+ *         line is malformed
+ ****/
+int read_response(struct tls_stream *stream, struct response *response)
+{
+	const char *advert;
+	char *fields;
+
+	memset(response, 0, sizeof(*response));
+	response->size = -1;
+	if (stream_read_line(stream, response->line, sizeof(response->line)) != 1) {
+		response->line[0] = '\0';
+		return -1;
+	}
+	if (sscanf(response->line, "%31s", response->status) != 1)
+		return -1;
+	fields = response->line + strlen(response->status);
+
+	if (strcmp(response->status, RESP_OK) == 0) {
+		if (sscanf(fields, "%lld", &response->length) != 1 || response->length < 0)
+			return -1;
+		response->size = response->length;
+		response->last = response->length - 1;
+	} else if (strcmp(response->status, RESP_PARTIAL) == 0) {
+		if (sscanf(fields, "%lld %*s %lld-%lld/%lld", &response->length, &response->first, &response->last,
+		    &response->size) != 4 || response->length < 0)
+			return -1;
+	} else if (strcmp(response->status, RESP_BUSY) == 0) {
+		if (sscanf(fields, "%u", &response->retry_after) != 1)
+			return -1;
+		if (response->retry_after == 0)
+			response->retry_after = 1;
+		return 0;
+	} else if (strcmp(response->status, RESP_BAD_RANGE) == 0) {
+		if (sscanf(fields, "%lld", &response->size) != 1)
+			response->size = -1;
+		return 0;
+	} else if (strcmp(response->status, RESP_NOT_FOUND) == 0 || strcmp(response->status, RESP_BLACKLISTED) == 0 ||
+	    strcmp(response->status, RESP_INVALID) == 0 || strcmp(response->status, RESP_UNAVAILABLE) == 0) {
+		return 0;
+	} else {
+		return -1;
+	}
+
+	if ((advert = strstr(fields, " " HOT_FIELD)) != NULL)
+		sscanf(advert + 1 + strlen(HOT_FIELD), "%u", &response->hot);
+	return 0;
+}
@@ -0,0 +1,26 @@
+/*
+ * connection.h - Connecting to proxy servers and reading their responses
+ */
+
+#ifndef _CONNECTION_H_
+#define _CONNECTION_H_
+
+#include <tls.h>
+#include "protocol.h"
+
+/* A proxy server's status line, parsed by read_response */
+struct response {
+	char line[MAX_LINE];			/* Status line as received. Empty if none arrived */
+	char status[32];
+	long long length;			/* Body bytes that follow the status line */
+	long long first, last;			/* Bytes of the object in the body of an OK or PARTIAL response */
+	long long size;				/* Size of the object. -1 if the status line does not give it */
+	unsigned int retry_after;		/* Seconds a BUSY proxy server asked to wait, at least 1 */
+	unsigned int hot;			/* Proxy servers replicating a hot object. 0 if it is not hot */
+};
+
+struct tls_config *client_tls_config(void);
+struct tls *client_connect(struct tls_config *cfg, const char *host, const char *port);
+int read_response(struct tls_stream *stream, struct response *response);
+
+#endif // _CONNECTION_H_
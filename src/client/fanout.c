@@ -0,0 +1,250 @@
+/*
+ * fanout.c - Fetching an object list from every proxy server concurrently
+ *
+ * The whole list is read and partitioned by the proxy server rendezvous hashing
+ * chooses for each object before anything is requested. Every partition is then
+ * fetched by its own thread over its own connection to the node serving its proxy
+ * server, with up to depth requests
+ * pipelined, so the partitions proceed in parallel and the run takes about as long
+ * as the slowest one. Object bodies are written to files in the output directory
+ * named after the object, with the range appended for range requests. Since the
+ * partitions are fixed before the first response arrives, requests for hot objects
+ * are not spread over their replicas the way the other modes spread them.
+ */
+
+#include <sys/types.h>
+#include <sys/stat.h>
+
+#include <err.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <tls.h>
+#include "connection.h"
+#include "fanout.h"
+#include "protocol.h"
+#include "rendezvous.h"
+
+const unsigned int MAX_FANOUT_BUSY_RETRIES = 3;
+
+struct partition {
+	unsigned int proxy;			/* Index of the proxy server in PROXY_NAMES */
+	char (*requests)[MAX_LINE];		/* Request lines of the partition's objects */
+	unsigned int count;
+	unsigned int capacity;
+	unsigned int answered;			/* Objects the proxy server responded to */
+	unsigned int saved;			/* Objects written to the output directory */
+	unsigned long long bytes;
+	double seconds;				/* Time taken to fetch the partition */
+	pthread_t thread;
+};
+
+static struct tls_config *tls_cfg;
+static int out_fd;
+static unsigned int pipeline_depth;
+
+static double elapsed_s(const struct timespec *start, const struct timespec *end) {
+	return (end->tv_sec - start->tv_sec) + (end->tv_nsec - start->tv_nsec) / 1e9;
+}
+
+static void add_request(struct partition *partition, const char *request) {
+	if (partition->count == partition->capacity) {
+		partition->capacity = partition->capacity ? partition->capacity * 2 : 64;
+		if ((partition->requests = realloc(partition->requests, partition->capacity * sizeof(*partition->requests))) == NULL)
+			err(1, "realloc");
+	}
+	strcpy(partition->requests[partition->count++], request);
+}
+
+static struct tls *connect_proxy(const struct partition *partition) {
+	const struct node *node = node_of(partition->proxy);
+
+	return client_connect(tls_cfg, node->host, node->port);
+}
+
+/****
+ * Read the response to a request and write the object it contains to the output directory
+ * request: Request line the response answers
+ * retry_after: Set to the seconds to wait before retrying if the proxy server was busy. 0 otherwise
+ * return: 1 if the object was saved. 0 if the proxy server did not send it. -1 if the
+ *         connection can no longer be used
+ ****/
+static int save_response(struct partition *partition, struct tls_stream *stream, const char *request,
+    unsigned int *retry_after)
+{
+	char object_name[MAX_OBJECT_NAME + 1];
+	char range[64];
+	char path[MAX_OBJECT_NAME + 80];
+	char body[16384];
+	struct response response;
+	long long length;
+
+	*retry_after = 0;
+	range[0] = '\0';
+	sscanf(request, "%*s %255s %63s", object_name, range);
+	if (read_response(stream, &response) == -1) {
+		if (response.line[0] == '\0')
+			warnx("No response from proxy server %s for %s", PROXY_NAMES[partition->proxy], object_name);
+		else
+			warnx("Malformed response from proxy server %s for %s: %s", PROXY_NAMES[partition->proxy], object_name,
+			    response.line);
+		return -1;
+	}
+	if (strcmp(response.status, RESP_BUSY) == 0) {
+		*retry_after = response.retry_after;
+		return -1;
+	}
+	if (strcmp(response.status, RESP_OK) != 0 && strcmp(response.status, RESP_PARTIAL) != 0) {
+		printf("%s%s%s: %s\n", object_name, range[0] ? " " : "", range, response.line);
+		return 0;
+	}
+	length = response.length;
+
+	snprintf(path, sizeof(path), "%s%s%s", object_name, range[0] ? "." : "", range);
+	int fd = openat(out_fd, path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+	if (fd == -1)
+		warn("%s", path);
+	while (length > 0) {
+		ssize_t n = stream_read(stream, body, length < (long long)sizeof(body) ? length : (long long)sizeof(body));
+		if (n <= 0) {
+			warnx("Proxy server %s closed connection in the middle of %s", PROXY_NAMES[partition->proxy], object_name);
+			if (fd != -1)
+				close(fd);
+			return -1;
+		}
+		if (fd != -1 && write(fd, body, n) != n) {
+			warn("%s", path);
+			close(fd);
+			fd = -1;
+		}
+		length -= n;
+		partition->bytes += n;
+	}
+	if (fd == -1)
+		return 0;
+	close(fd);
+	return 1;
+}
+
+/****
+ * Fetch every object of a partition over one pipelined connection. The unanswered
+ * requests are sent again on a new connection if the proxy server was busy
+ * return: NULL
+ ****/
+static void *fetch_partition(void *arg) {
+	struct partition *partition = arg;
+	struct timespec start, end;
+	unsigned int answered = 0, sent = 0, busy_retries = 0;
+	struct tls_stream stream;
+	struct tls *ctx;
+
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	if ((ctx = connect_proxy(partition)) == NULL)
+		goto done;
+	stream_init(&stream, ctx);
+
+	while (answered < partition->count) {
+		unsigned int retry_after;
+
+		for (; sent < partition->count && sent - answered < pipeline_depth; sent++) {
+			if (tls_write_all(ctx, partition->requests[sent], strlen(partition->requests[sent])) == -1) {
+				warnx("tls_write: %s", tls_error(ctx));
+				goto done;
+			}
+		}
+
+		int ret = save_response(partition, &stream, partition->requests[answered], &retry_after);
+		if (ret >= 0) {
+			if (ret)
+				partition->saved++;
+			partition->answered = ++answered;
+			continue;
+		}
+		if (retry_after == 0 || busy_retries++ == MAX_FANOUT_BUSY_RETRIES)
+			goto done;
+
+		tls_free(ctx);				// A busy proxy server closes without waiting for us
+		sleep(retry_after);
+		if ((ctx = connect_proxy(partition)) == NULL)
+			goto done;
+		stream_init(&stream, ctx);
+		sent = answered;
+	}
+
+done:
+	if (ctx != NULL) {
+		tls_close(ctx);
+		tls_free(ctx);
+	}
+	clock_gettime(CLOCK_MONOTONIC, &end);
+	partition->seconds = elapsed_s(&start, &end);
+	return NULL;
+}
+
+/****
+ * Partition an object list by proxy server and fetch the partitions concurrently
+ * fp: Object list, one "object_name [range]" per line
+ * out_dir: Directory the objects are written to. Created if it does not exist
+ * depth: Requests kept outstanding on each connection
+ * return: Exit status. 1 if a proxy server did not respond to every request
+ ****/
+int run_fanout(FILE *fp, const char *out_dir, unsigned int depth) {
+	struct partition partitions[NUM_PROXIES];
+	struct timespec start, end;
+	char line[MAX_LINE];
+	char request[MAX_LINE];
+	unsigned int i, total = 0, saved = 0, unanswered = 0;
+	double slowest = 0;
+
+	pipeline_depth = depth;
+	if (mkdir(out_dir, 0755) == -1 && errno != EEXIST)
+		err(1, "mkdir %s", out_dir);
+	if ((out_fd = open(out_dir, O_RDONLY | O_DIRECTORY)) == -1)
+		err(1, "%s", out_dir);
+	tls_cfg = client_tls_config();
+
+	/**** Partition the whole list before requesting anything ****/
+	memset(partitions, 0, sizeof(partitions));
+	for (i = 0; i < NUM_PROXIES; i++)
+		partitions[i].proxy = i;
+	while (fgets(line, sizeof(line), fp) != NULL) {
+		int proxy = format_request(request, sizeof(request), line);
+		if (proxy == -1)
+			continue;
+		add_request(&partitions[proxy], request);
+		total++;
+	}
+	fclose(fp);
+	/**** End partition the whole list before requesting anything ****/
+
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	for (i = 0; i < NUM_PROXIES; i++) {
+		if (partitions[i].count > 0 && pthread_create(&partitions[i].thread, NULL, fetch_partition, &partitions[i]) != 0)
+			errx(1, "pthread_create failed");
+	}
+	for (i = 0; i < NUM_PROXIES; i++) {
+		if (partitions[i].count == 0)
+			continue;
+		pthread_join(partitions[i].thread, NULL);
+		printf("Proxy server %s: %u objects, %u saved, %u unanswered, %llu bytes in %.3f s\n", PROXY_NAMES[i],
+		    partitions[i].count, partitions[i].saved, partitions[i].count - partitions[i].answered, partitions[i].bytes,
+		    partitions[i].seconds);
+		if (partitions[i].seconds > slowest)
+			slowest = partitions[i].seconds;
+		saved += partitions[i].saved;
+		unanswered += partitions[i].count - partitions[i].answered;
+		free(partitions[i].requests);
+	}
+	clock_gettime(CLOCK_MONOTONIC, &end);
+	printf("Saved %u of %u objects into %s in %.3f s. Slowest partition took %.3f s\n", saved, total, out_dir,
+	    elapsed_s(&start, &end), slowest);
+
+	close(out_fd);
+	tls_config_free(tls_cfg);
+	return unanswered > 0;
+}
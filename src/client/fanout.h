@@ -0,0 +1,12 @@
+/*
+ * fanout.h - Fetching an object list from every proxy server concurrently
+ */
+
+#ifndef _FANOUT_H_
+#define _FANOUT_H_
+
+#include <stdio.h>
+
+int run_fanout(FILE *fp, const char *out_dir, unsigned int depth);
+
+#endif // _FANOUT_H_
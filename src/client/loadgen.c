@@ -0,0 +1,510 @@
+/*
+ * loadgen.c - Load generator mode of the client
+ *
+ * A fixed number of threads each keep one request in flight. In open loop mode
+ * requests are scheduled at a fixed rate independent of how fast the proxy answers,
+ * and a request's latency is measured from the time it was scheduled, so time spent
+ * waiting for a free thread counts against the proxy instead of being hidden
+ * (coordinated omission). In closed loop mode every thread starts its next request
+ * as soon as the previous one finishes.
+ *
+ * Keys are drawn uniformly or Zipf distributed from a keyspace read from a file or
+ * generated as "key-0" ... "key-(n-1)". Every thread records latencies in its own
+ * histogram and outcome counters, which are merged once the run is over.
+ *
+ * Requests for objects a proxy server reported hot are spread over the proxy servers
+ * replicating them (see spread.c), and counted to report how much load was moved.
+ *
+ * With a seed, bodies are checked against the generated objects of a server started
+ * with -synthetic, byte for byte and optionally in size, so responses the proxy
+ * server mangled, truncated or mixed up are counted as corrupt.
+ *
+ * In replay mode the requests of a capture taken by a proxy server are sent again
+ * in open loop, each at its captured arrival time divided by the speed. Responses do
+ * not say whether the proxy server had the object cached, so the replay's hit ratio
+ * is read from the cache counters on the proxy server's admin port before and after
+ * the run, and compared with the hit ratio recorded in the capture.
+ */
+
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+
+#include <err.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <tls.h>
+#include "capture.h"
+#include "connection.h"
+#include "histogram.h"
+#include "loadgen.h"
+#include "protocol.h"
+#include "rendezvous.h"
+#include "spread.h"
+#include "synthetic.h"
+#include "zipf.h"
+
+const long LATE_START_NS = 1000000;
+const char METRICS_REQUEST[] = "GET /metrics HTTP/1.0\r\n\r\n";
+
+enum outcome {
+	OUTCOME_OK,
+	OUTCOME_NOT_FOUND,
+	OUTCOME_BLACKLISTED,
+	OUTCOME_BUSY,
+	OUTCOME_UNAVAILABLE,
+	OUTCOME_OTHER,				/* INVALID or BAD_RANGE */
+	OUTCOME_CORRUPT,			/* Body or size differs from the generated object */
+	OUTCOME_ERROR,				/* Connection failed or response was malformed */
+	NUM_OUTCOMES
+};
+
+struct key {
+	char request[MAX_LINE];			/* Request line sent for the key, including the proxy name */
+	unsigned int proxy;			/* Index of the proxy server in PROXY_NAMES */
+};
+
+struct replay_request {
+	long long offset_ns;			/* From the start of the replay */
+	char *request;
+	unsigned int proxy;
+};
+
+struct worker {
+	pthread_t thread;
+	uint64_t random_state;
+	struct histogram latency;		/* Microseconds from scheduled start to complete response */
+	unsigned long long outcomes[NUM_OUTCOMES];
+	unsigned long long bytes;		/* Body bytes received */
+	unsigned long long late_starts;		/* Requests started more than LATE_START_NS after their scheduled time */
+	unsigned long long *proxy_requests;	/* Requests sent for each proxy server */
+	unsigned long long spread;		/* Requests for hot objects not sent to their highest ranked proxy server */
+};
+
+static const struct load_config *load;
+static struct tls_config *tls_cfg;
+static struct key *keys;
+static struct replay_request *replays;
+static unsigned long long num_replays;
+static unsigned long long captured[NUM_CAPTURE_OUTCOMES];	/* Requests of the capture by outcome */
+static struct zipf popularity;
+static struct timespec start_time;
+static unsigned long long next_request;		/* Index of the next request to schedule in open loop mode */
+static pthread_mutex_t schedule_lock = PTHREAD_MUTEX_INITIALIZER;
+
+static long long elapsed_ns(const struct timespec *start, const struct timespec *end) {
+	return (end->tv_sec - start->tv_sec) * 1000000000LL + (end->tv_nsec - start->tv_nsec);
+}
+
+static void add_ns(struct timespec *ts, long long ns) {
+	ts->tv_sec += ns / 1000000000LL;
+	ts->tv_nsec += ns % 1000000000LL;
+	if (ts->tv_nsec >= 1000000000L) {
+		ts->tv_sec++;
+		ts->tv_nsec -= 1000000000L;
+	}
+}
+
+/****
+ * Read or generate the keyspace
+ * return: Number of keys
+ ****/
+static unsigned int load_keys() {
+	unsigned int count = 0, capacity = load->num_keys;
+	char line[MAX_LINE];
+	FILE *fp = NULL;
+
+	if (load->num_keys == 0) {
+		if ((fp = fopen(load->objects, "r")) == NULL)
+			err(1, "%s", load->objects);
+		capacity = 64;
+	}
+	if ((keys = malloc(capacity * sizeof(*keys))) == NULL)
+		err(1, "malloc");
+
+	if (fp == NULL) {
+		for (count = 0; count < load->num_keys; count++) {
+			snprintf(line, sizeof(line), "key-%u", count);
+			keys[count].proxy = format_request(keys[count].request, sizeof(keys[count].request), line);
+		}
+		return count;
+	}
+
+	while (fgets(line, sizeof(line), fp) != NULL) {
+		if (count == capacity) {
+			capacity *= 2;
+			if ((keys = realloc(keys, capacity * sizeof(*keys))) == NULL)
+				err(1, "realloc");
+		}
+		int proxy = format_request(keys[count].request, sizeof(keys[count].request), line);
+		if (proxy != -1)
+			keys[count++].proxy = proxy;
+	}
+	fclose(fp);
+	if (count == 0)
+		errx(1, "No objects in %s", load->objects);
+	return count;
+}
+
+static int compare_replays(const void *a, const void *b) {
+	const struct replay_request *x = a, *y = b;
+
+	return x->offset_ns < y->offset_ns ? -1 : x->offset_ns > y->offset_ns;
+}
+
+/****
+ * Read the requests of a capture and schedule them relative to the first one
+ * return: Number of requests
+ ****/
+static unsigned long long load_replay() {
+	struct capture_record record;
+	unsigned long long start, capacity = 1024, first = ~0ULL, i;
+	char request[MAX_LINE];
+	FILE *fp;
+	int ret;
+
+	if ((fp = fopen(load->replay, "r")) == NULL)
+		err(1, "%s", load->replay);
+	if (capture_read_header(fp, &start) == -1)
+		errx(1, "%s is not a capture", load->replay);
+	if ((replays = malloc(capacity * sizeof(*replays))) == NULL)
+		err(1, "malloc");
+	while ((ret = capture_read(fp, &record)) == 1) {
+		if (num_replays == capacity) {
+			capacity *= 2;
+			if ((replays = realloc(replays, capacity * sizeof(*replays))) == NULL)
+				err(1, "realloc");
+		}
+		replays[num_replays].proxy = format_request(request, sizeof(request), record.object_name);
+		if ((replays[num_replays].request = strdup(request)) == NULL)
+			err(1, "strdup");
+		replays[num_replays++].offset_ns = record.time_us;
+		captured[record.outcome]++;
+		if (record.time_us < first)
+			first = record.time_us;
+	}
+	if (ret == -1)
+		warnx("%s ends with a malformed record", load->replay);
+	fclose(fp);
+	if (num_replays == 0)
+		errx(1, "No requests in %s", load->replay);
+
+	for (i = 0; i < num_replays; i++)		// Records are appended as requests end, not as they arrive
+		replays[i].offset_ns = (replays[i].offset_ns - first) * 1000 / load->speed;
+	qsort(replays, num_replays, sizeof(*replays), compare_replays);
+	return num_replays;
+}
+
+/****
+ * Add up the cache hits and misses counted by the proxy server's processes
+ * return: 0 on success. -1 if the admin port could not be read
+ ****/
+static int read_cache_counters(unsigned long long *hits, unsigned long long *misses) {
+	struct sockaddr_in addr;
+	char response[65536];
+	size_t len = 0;
+	ssize_t n;
+	char *line;
+	int sd;
+
+	memset(&addr, 0, sizeof(addr));
+	addr.sin_family = AF_INET;
+	addr.sin_port = htons(load->admin_port);
+	addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+	if ((sd = socket(AF_INET, SOCK_STREAM, 0)) == -1)
+		return -1;
+	if (connect(sd, (struct sockaddr *)&addr, sizeof(addr)) == -1 ||
+	    write(sd, METRICS_REQUEST, strlen(METRICS_REQUEST)) != (ssize_t)strlen(METRICS_REQUEST)) {
+		close(sd);
+		return -1;
+	}
+	while (len < sizeof(response) - 1 && (n = read(sd, response + len, sizeof(response) - 1 - len)) > 0)
+		len += n;
+	close(sd);
+	response[len] = '\0';
+
+	*hits = *misses = 0;
+	for (line = strtok(response, "\n"); line != NULL; line = strtok(NULL, "\n")) {
+		const char *value = strrchr(line, ' ');
+		if (value == NULL || line[0] == '#')
+			continue;
+		if (strncmp(line, "tlscache_proxy_cache_hits_total", 31) == 0)
+			*hits += strtoull(value + 1, NULL, 10);
+		else if (strncmp(line, "tlscache_proxy_cache_misses_total", 33) == 0)
+			*misses += strtoull(value + 1, NULL, 10);
+	}
+	return strncmp(response, "HTTP/1.0 200", 12) == 0 ? 0 : -1;
+}
+
+static double ratio(unsigned long long hits, unsigned long long misses) {
+	return hits + misses > 0 ? 100.0 * hits / (hits + misses) : 0;
+}
+
+/****
+ * Send one request over a new connection to the node serving its proxy server and
+ * read the whole response
+ * request: Request line
+ * proxy: Index of the proxy server the request names
+ * bytes: Incremented by the number of body bytes received
+ * return: Outcome of the request
+ ****/
+static enum outcome send_request(const char *request, unsigned int proxy, unsigned long long *bytes) {
+	const struct node *node = node_of(proxy);
+	struct tls *ctx;
+	struct tls_stream stream;
+	struct response response;
+	char body[16384];
+	char object_name[MAX_OBJECT_NAME + 1];
+	long long length = 0, offset = 0;
+	uint64_t key = 0;
+	enum outcome outcome;
+
+	if ((ctx = client_connect(tls_cfg, node->host, node->port)) == NULL)
+		return OUTCOME_ERROR;
+	if (tls_write_all(ctx, request, strlen(request)) == -1) {
+		tls_free(ctx);
+		return OUTCOME_ERROR;
+	}
+
+	stream_init(&stream, ctx);
+	if (read_response(&stream, &response) == -1)
+		outcome = OUTCOME_ERROR;
+	else if (strcmp(response.status, RESP_OK) == 0 || strcmp(response.status, RESP_PARTIAL) == 0)
+		outcome = OUTCOME_OK;
+	else if (strcmp(response.status, RESP_NOT_FOUND) == 0)
+		outcome = OUTCOME_NOT_FOUND;
+	else if (strcmp(response.status, RESP_BLACKLISTED) == 0)
+		outcome = OUTCOME_BLACKLISTED;
+	else if (strcmp(response.status, RESP_BUSY) == 0)
+		outcome = OUTCOME_BUSY;
+	else if (strcmp(response.status, RESP_UNAVAILABLE) == 0)
+		outcome = OUTCOME_UNAVAILABLE;
+	else
+		outcome = OUTCOME_OTHER;
+
+	if (outcome == OUTCOME_OK) {
+		length = response.length;
+		offset = response.first;
+	}
+	if (outcome == OUTCOME_OK)
+		spread_note(request, &response);
+
+	if (outcome == OUTCOME_OK && load->verify && sscanf(request, "%*s %255s", object_name) == 1) {
+		key = synthetic_key(object_name, load->verify_seed);
+		if (load->verify_sizes && response.size != synthetic_size(object_name, key, &load->verify_size_spec))
+			outcome = OUTCOME_CORRUPT;
+	}
+
+	while (length > 0) {
+		ssize_t n = stream_read(&stream, body, length < (long long)sizeof(body) ? length : (long long)sizeof(body));
+		if (n <= 0) {
+			outcome = OUTCOME_ERROR;
+			break;
+		}
+		if (outcome == OUTCOME_OK && load->verify && synthetic_verify(key, offset, body, n) == -1)
+			outcome = OUTCOME_CORRUPT;
+		offset += n;
+		length -= n;
+		*bytes += n;
+	}
+
+	if (outcome != OUTCOME_BUSY)			// A busy proxy closes without waiting for us
+		tls_close(ctx);
+	tls_free(ctx);
+	return outcome;
+}
+
+/****
+ * Get the time the next request should start
+ * scheduled: Filled with the scheduled start time
+ * index: Set to the number of the request in open loop mode
+ * return: 1 if a request should be sent. 0 once the run is over
+ ****/
+static int schedule(struct timespec *scheduled, unsigned long long *index) {
+	if (load->rate > 0 || load->replay != NULL) {
+		long long offset;
+
+		pthread_mutex_lock(&schedule_lock);
+		*index = next_request++;
+		pthread_mutex_unlock(&schedule_lock);
+
+		if (load->replay != NULL) {
+			if (*index >= num_replays)
+				return 0;
+			offset = replays[*index].offset_ns;
+		} else {
+			offset = (long long)(*index * 1000000000.0 / load->rate);
+			if (offset >= (long long)(load->duration * 1000000000.0))
+				return 0;
+		}
+		*scheduled = start_time;
+		add_ns(scheduled, offset);
+		while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, scheduled, NULL) != 0)
+			;
+		return 1;
+	}
+
+	clock_gettime(CLOCK_MONOTONIC, scheduled);
+	return elapsed_ns(&start_time, scheduled) < (long long)(load->duration * 1000000000.0);
+}
+
+static void *run_worker(void *arg) {
+	struct worker *worker = arg;
+	struct timespec scheduled, started, finished;
+	unsigned long long index;
+	char redirected[MAX_LINE];
+
+	while (schedule(&scheduled, &index)) {
+		const char *request;
+		unsigned int proxy;
+
+		if (load->replay != NULL) {
+			request = replays[index].request;
+			proxy = replays[index].proxy;
+		} else {
+			const struct key *key = &keys[zipf_next(&popularity, &worker->random_state)];
+			request = key->request;
+			proxy = key->proxy;
+		}
+		if ((request = spread_request(request, redirected, &proxy, &worker->random_state)) == redirected)
+			worker->spread++;
+		worker->proxy_requests[proxy]++;
+
+		clock_gettime(CLOCK_MONOTONIC, &started);
+		if (elapsed_ns(&scheduled, &started) > LATE_START_NS)
+			worker->late_starts++;
+		enum outcome outcome = send_request(request, proxy, &worker->bytes);
+		clock_gettime(CLOCK_MONOTONIC, &finished);
+
+		worker->outcomes[outcome]++;
+		if (outcome != OUTCOME_ERROR)
+			histogram_record(&worker->latency, elapsed_ns(&scheduled, &finished) / 1000);
+	}
+	return NULL;
+}
+
+static double ms(unsigned long long us) {
+	return us / 1000.0;
+}
+
+/****
+ * Generate load against the proxy servers' nodes and print throughput, outcomes and
+ * latency percentiles
+ * return: 0 if every request got a response and no body was corrupt. 1 otherwise
+ ****/
+int run_load(const struct load_config *config) {
+	struct worker *workers;
+	struct histogram latency;
+	unsigned long long outcomes[NUM_OUTCOMES];
+	unsigned long long bytes = 0, late_starts = 0, completed = 0, spread = 0, sent = 0, busiest = 0;
+	unsigned long long proxy_requests[NUM_PROXIES];
+	unsigned long long hits_before = 0, misses_before = 0, hits_after, misses_after;
+	int have_counters = 0;
+	struct timespec end_time;
+	unsigned long long r;
+	unsigned int num_keys = 0, i, j;
+
+	load = config;
+	tls_cfg = client_tls_config();
+
+	if ((workers = calloc(config->connections, sizeof(*workers))) == NULL)
+		err(1, "calloc");
+	if (config->replay != NULL) {
+		load_replay();
+		printf("Replaying %llu requests captured over %.1f s at %gx speed with %u connections\n", num_replays,
+		    replays[num_replays - 1].offset_ns * config->speed / 1e9, config->speed, config->connections);
+	} else {
+		num_keys = load_keys();
+		zipf_init(&popularity, num_keys, config->zipf);
+		printf("Generating load with %u connections, ", config->connections);
+		if (config->rate > 0)
+			printf("open loop at %.1f requests/s", config->rate);
+		else
+			printf("closed loop");
+		printf(" for %.1f s over %u keys, %s popularity", config->duration, num_keys, config->zipf > 0 ? "Zipf" : "uniform");
+		if (config->zipf > 0)
+			printf(" (exponent %.2f)", config->zipf);
+		printf("\n");
+	}
+	fflush(stdout);
+	if (config->admin_port != 0) {
+		have_counters = read_cache_counters(&hits_before, &misses_before) == 0;
+		if (!have_counters)
+			warnx("Could not read cache counters from admin port %u", config->admin_port);
+	}
+
+	clock_gettime(CLOCK_MONOTONIC, &start_time);
+	for (i = 0; i < config->connections; i++) {
+		histogram_init(&workers[i].latency);
+		if ((workers[i].proxy_requests = calloc(NUM_PROXIES, sizeof(*workers[i].proxy_requests))) == NULL)
+			err(1, "calloc");
+		workers[i].random_state = 0x9E3779B97F4A7C15ULL * (i + 1);
+		if (pthread_create(&workers[i].thread, NULL, run_worker, &workers[i]) != 0)
+			errx(1, "pthread_create failed");
+	}
+
+	histogram_init(&latency);
+	memset(outcomes, 0, sizeof(outcomes));
+	memset(proxy_requests, 0, sizeof(proxy_requests));
+	for (i = 0; i < config->connections; i++) {
+		pthread_join(workers[i].thread, NULL);
+		histogram_merge(&latency, &workers[i].latency);
+		for (j = 0; j < NUM_OUTCOMES; j++)
+			outcomes[j] += workers[i].outcomes[j];
+		bytes += workers[i].bytes;
+		late_starts += workers[i].late_starts;
+		spread += workers[i].spread;
+		for (j = 0; j < NUM_PROXIES; j++)
+			proxy_requests[j] += workers[i].proxy_requests[j];
+		free(workers[i].proxy_requests);
+	}
+	clock_gettime(CLOCK_MONOTONIC, &end_time);
+	double seconds = elapsed_ns(&start_time, &end_time) / 1e9;
+	for (j = 0; j < OUTCOME_ERROR; j++)
+		completed += outcomes[j];
+
+	printf("Completed %llu requests in %.2f s: %.1f requests/s, %.2f MB/s\n", completed, seconds, completed / seconds,
+	    bytes / seconds / 1e6);
+	printf("Responses: %llu ok, %llu not found, %llu black-listed, %llu busy, %llu unavailable, %llu other, %llu errors\n",
+	    outcomes[OUTCOME_OK], outcomes[OUTCOME_NOT_FOUND], outcomes[OUTCOME_BLACKLISTED], outcomes[OUTCOME_BUSY],
+	    outcomes[OUTCOME_UNAVAILABLE], outcomes[OUTCOME_OTHER], outcomes[OUTCOME_ERROR]);
+	if (config->verify)
+		printf("Integrity: %llu bodies matched the generated objects, %llu corrupt\n", outcomes[OUTCOME_OK],
+		    outcomes[OUTCOME_CORRUPT]);
+	printf("Latency (ms): mean %.3f p50 %.3f p90 %.3f p99 %.3f p99.9 %.3f max %.3f\n", histogram_mean(&latency) / 1000.0,
+	    ms(histogram_percentile(&latency, 50)), ms(histogram_percentile(&latency, 90)),
+	    ms(histogram_percentile(&latency, 99)), ms(histogram_percentile(&latency, 99.9)), ms(latency.max));
+	printf("Requests per proxy server:");
+	for (j = 0; j < NUM_PROXIES; j++) {
+		printf("%s %s %llu", j == 0 ? "" : ",", PROXY_NAMES[j], proxy_requests[j]);
+		if (proxy_requests[j] > busiest)
+			busiest = proxy_requests[j];
+		sent += proxy_requests[j];
+	}
+	printf("\nLoad skew %.2f (busiest proxy server over the mean), %llu requests for hot objects spread over replicas\n",
+	    sent > 0 ? (double)busiest * NUM_PROXIES / sent : 0.0, spread);
+	if ((config->rate > 0 || config->replay != NULL) && late_starts > 0)
+		printf("%llu requests started more than 1 ms late. More connections are needed to sustain the rate\n", late_starts);
+	if (config->replay != NULL)
+		printf("Captured hit ratio %.1f%% (%llu hits, %llu misses, %llu not found, %llu denied, %llu failed)\n",
+		    ratio(captured[CAPTURE_HIT], captured[CAPTURE_MISS]), captured[CAPTURE_HIT], captured[CAPTURE_MISS],
+		    captured[CAPTURE_NOT_FOUND], captured[CAPTURE_DENIED], captured[CAPTURE_FAILED]);
+	if (have_counters && read_cache_counters(&hits_after, &misses_after) == 0)
+		printf("Proxy server hit ratio during the run %.1f%% (%llu hits, %llu misses)\n",
+		    ratio(hits_after - hits_before, misses_after - misses_before), hits_after - hits_before,
+		    misses_after - misses_before);
+
+	if (config->replay == NULL)
+		zipf_free(&popularity);
+	for (r = 0; r < num_replays; r++)
+		free(replays[r].request);
+	free(replays);
+	free(workers);
+	free(keys);
+	tls_config_free(tls_cfg);
+	return outcomes[OUTCOME_ERROR] > 0 || outcomes[OUTCOME_CORRUPT] > 0;
+}
@@ -0,0 +1,28 @@
+/*
+ * loadgen.h - Load generator mode of the client
+ */
+
+#ifndef _LOADGEN_H_
+#define _LOADGEN_H_
+
+#include "synthetic.h"
+
+struct load_config {
+	unsigned int connections;		/* Requests in flight at once */
+	double rate;				/* Requests started per second. 0 to start a request as soon as one finishes */
+	double duration;			/* Seconds to generate load for */
+	unsigned int num_keys;			/* Size of the generated keyspace. 0 to use the objects file */
+	const char *objects;			/* File listing the keyspace, one object per line */
+	double zipf;				/* Skew of key popularity. 0 for uniform */
+	const char *replay;			/* Capture to replay instead of generating keys. NULL if none */
+	double speed;				/* Time scale of the replay. 2 replays twice as fast as captured */
+	unsigned int admin_port;		/* Admin port of the proxy server to read cache counters from. 0 if none */
+	int verify;				/* Check bodies against the objects of a server started with -synthetic */
+	uint64_t verify_seed;			/* The server's -synthetic seed */
+	int verify_sizes;			/* Also check object sizes against verify_size_spec */
+	struct synthetic_sizes verify_size_spec;
+};
+
+int run_load(const struct load_config *config);
+
+#endif // _LOADGEN_H_
@@ -0,0 +1,140 @@
+/*
+ * spread.c - Spreading requests for hot objects over the proxy servers replicating them
+ *
+ * A proxy server marks responses for objects that take a large share of its requests
+ * as hot, with the number of proxy servers that replicate them. Requests for an
+ * object marked hot in the last HOT_TTL_NS are sent to one of that many proxy servers
+ * rendezvous hashing ranks highest for it, chosen at random, instead of always the
+ * highest, so one popular object does not load one proxy server alone. The reports
+ * are shared by all of the client's threads.
+ */
+
+#include <pthread.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include "protocol.h"
+#include "rendezvous.h"
+#include "spread.h"
+#include "zipf.h"
+
+#define MAX_HOT_TRACKED 256			/* Hot objects the client spreads at once */
+
+const long long HOT_TTL_NS = 5000000000LL;
+
+/* An object a proxy server reported hot */
+struct hot_object {
+	char name[MAX_OBJECT_NAME + 1];
+	unsigned int replicas;			/* Proxy servers the object is spread over */
+	struct timespec expires;		/* End of the report's validity */
+};
+
+static struct hot_object hot_objects[MAX_HOT_TRACKED];
+static unsigned int num_hot;			/* Read without the lock to skip lookups while nothing is hot */
+static pthread_mutex_t hot_lock = PTHREAD_MUTEX_INITIALIZER;
+
+static long long elapsed_ns(const struct timespec *start, const struct timespec *end) {
+	return (end->tv_sec - start->tv_sec) * 1000000000LL + (end->tv_nsec - start->tv_nsec);
+}
+
+static void add_ns(struct timespec *ts, long long ns) {
+	ts->tv_sec += ns / 1000000000LL;
+	ts->tv_nsec += ns % 1000000000LL;
+	if (ts->tv_nsec >= 1000000000L) {
+		ts->tv_sec++;
+		ts->tv_nsec -= 1000000000L;
+	}
+}
+
+/****
+ * Record that a proxy server reported an object hot, replacing an expired or the
+ * oldest report when the table is full
+ * replicas: Proxy servers the object may be requested from
+ * return: Nothing
+ ****/
+static void hot_mark(const char *object_name, unsigned int replicas) {
+	struct hot_object *hot = NULL;
+	struct timespec now;
+	unsigned int i;
+
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	pthread_mutex_lock(&hot_lock);
+	for (i = 0; i < num_hot && hot == NULL; i++) {
+		if (strcmp(hot_objects[i].name, object_name) == 0)
+			hot = &hot_objects[i];
+	}
+	if (hot == NULL && num_hot < MAX_HOT_TRACKED)
+		hot = &hot_objects[num_hot++];
+	else if (hot == NULL) {
+		hot = &hot_objects[0];
+		for (i = 1; i < MAX_HOT_TRACKED; i++) {
+			if (elapsed_ns(&hot_objects[i].expires, &hot->expires) > 0)
+				hot = &hot_objects[i];
+		}
+	}
+	snprintf(hot->name, sizeof(hot->name), "%s", object_name);
+	hot->replicas = replicas < NUM_PROXIES ? replicas : NUM_PROXIES;
+	hot->expires = now;
+	add_ns(&hot->expires, HOT_TTL_NS);
+	pthread_mutex_unlock(&hot_lock);
+}
+
+/****
+ * return: Proxy servers an object may be requested from. 1 unless a proxy server
+ *         reported it hot less than HOT_TTL_NS ago
+ ****/
+static unsigned int hot_replicas(const char *object_name) {
+	struct timespec now;
+	unsigned int i, replicas = 1;
+
+	if (__atomic_load_n(&num_hot, __ATOMIC_RELAXED) == 0)
+		return 1;
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	pthread_mutex_lock(&hot_lock);
+	for (i = 0; i < num_hot; i++) {
+		if (strcmp(hot_objects[i].name, object_name) == 0) {
+			if (elapsed_ns(&now, &hot_objects[i].expires) > 0)
+				replicas = hot_objects[i].replicas;
+			break;
+		}
+	}
+	pthread_mutex_unlock(&hot_lock);
+	return replicas;
+}
+
+/****
+ * Record whether the proxy server reported the object of a request hot
+ * request: Request line the response answers
+ * response: Status line of the response
+ * return: Nothing
+ ****/
+void spread_note(const char *request, const struct response *response) {
+	char object_name[MAX_OBJECT_NAME + 1];
+
+	if ((strcmp(response->status, RESP_OK) == 0 || strcmp(response->status, RESP_PARTIAL) == 0) && response->hot > 1 &&
+	    sscanf(request, "%*s %255s", object_name) == 1)
+		hot_mark(object_name, response->hot);
+}
+
+/****
+ * Send a request for a hot object to one of the proxy servers replicating it
+ * request: Request line naming the object's highest ranked proxy server
+ * redirected: MAX_LINE bytes. Filled with the request line for the chosen proxy server, if another
+ * proxy: Index of the proxy server the request names. Set to the chosen proxy server
+ * random_state: State of the caller's random number generator. Must not be 0
+ * return: The request line to send: request, or redirected if it was spread to another proxy server
+ ****/
+const char *spread_request(const char *request, char *redirected, unsigned int *proxy, uint64_t *random_state) {
+	char object_name[MAX_OBJECT_NAME + 1];
+	unsigned int ranked[NUM_PROXIES], replicas, chosen;
+
+	if (sscanf(request, "%*s %255s", object_name) != 1 || (replicas = hot_replicas(object_name)) <= 1)
+		return request;
+	rendezvous_rank(object_name, ranked);
+	chosen = ranked[random_next(random_state) % replicas];
+	if (chosen == *proxy)
+		return request;
+	snprintf(redirected, MAX_LINE, "%s%s", PROXY_NAMES[chosen], strchr(request, ' '));
+	*proxy = chosen;
+	return redirected;
+}
@@ -0,0 +1,14 @@
+/*
+ * spread.h - Spreading requests for hot objects over the proxy servers replicating them
+ */
+
+#ifndef _SPREAD_H_
+#define _SPREAD_H_
+
+#include <stdint.h>
+#include "connection.h"
+
+void spread_note(const char *request, const struct response *response);
+const char *spread_request(const char *request, char *redirected, unsigned int *proxy, uint64_t *random_state);
+
+#endif // _SPREAD_H_
@@ -0,0 +1,159 @@
+/*
+ * capture.c - Compact binary captures of the requests a proxy server answered
+ *
+ * The proxy server opens the capture before forking, so all of its processes and
+ * threads append to the same file. Each record is encoded in a buffer and appended
+ * with a single write, so records of concurrent requests do not interleave. A
+ * capture that already exists is appended to, keeping its start time.
+ */
+
+#include <sys/types.h>
+#include <sys/file.h>
+
+#include <err.h>
+#include <fcntl.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include "capture.h"
+
+const char *const CAPTURE_OUTCOME_NAMES[] = {"hit", "miss", "not_found", "denied", "failed"};
+
+static int capture_fd = -1;
+static unsigned long long capture_start;	/* Microseconds since the epoch */
+
+static unsigned long long wall_clock_us() {
+	struct timespec now;
+
+	clock_gettime(CLOCK_REALTIME, &now);
+	return now.tv_sec * 1000000ULL + now.tv_nsec / 1000;
+}
+
+static size_t put_varint(unsigned char *buf, unsigned long long value) {
+	size_t len = 0;
+
+	while (value >= 0x80) {
+		buf[len++] = (value & 0x7f) | 0x80;
+		value >>= 7;
+	}
+	buf[len++] = value;
+	return len;
+}
+
+static int get_varint(FILE *fp, unsigned long long *value) {
+	unsigned int shift;
+	int c;
+
+	*value = 0;
+	for (shift = 0; shift < 64; shift += 7) {
+		if ((c = getc(fp)) == EOF)
+			return -1;
+		*value |= (unsigned long long)(c & 0x7f) << shift;
+		if (!(c & 0x80))
+			return 0;
+	}
+	return -1;
+}
+
+/****
+ * Start capturing requests to a file. Must be called before the processes that
+ * answer requests are forked
+ * return: Nothing. Exits if the file cannot be opened or is not a capture
+ ****/
+void capture_open(const char *path) {
+	unsigned char header[16];
+	unsigned int i;
+
+	if ((capture_fd = open(path, O_RDWR | O_CREAT | O_APPEND | O_CLOEXEC, 0644)) == -1)
+		err(1, "%s", path);
+	flock(capture_fd, LOCK_EX);
+	if (lseek(capture_fd, 0, SEEK_END) == 0) {
+		capture_start = wall_clock_us();
+		memcpy(header, CAPTURE_MAGIC, 8);
+		for (i = 0; i < 8; i++)
+			header[8 + i] = capture_start >> (8 * i);
+		if (write(capture_fd, header, sizeof(header)) != sizeof(header))
+			err(1, "%s", path);
+	} else {
+		if (pread(capture_fd, header, sizeof(header), 0) != sizeof(header) || memcmp(header, CAPTURE_MAGIC, 8) != 0)
+			errx(1, "%s is not a capture", path);
+		for (i = 0; i < 8; i++)
+			capture_start |= (unsigned long long)header[8 + i] << (8 * i);
+	}
+	flock(capture_fd, LOCK_UN);
+}
+
+/****
+ * return: 1 if requests are being captured. 0 otherwise
+ ****/
+int capture_enabled(void) {
+	return capture_fd != -1;
+}
+
+/****
+ * Read the clock requests' arrival times are taken from
+ * return: Microseconds since the epoch
+ ****/
+unsigned long long capture_clock(void) {
+	return wall_clock_us();
+}
+
+/****
+ * Append a request to the capture, if one is open
+ * arrived: Time the request arrived, from capture_clock
+ * size: Size of the object. 0 if unknown
+ * return: Nothing
+ ****/
+void capture_write(unsigned long long arrived, const char *object_name, unsigned long long size,
+    enum capture_outcome outcome)
+{
+	unsigned char record[CAPTURE_MAX_RECORD];
+	size_t name_len = strlen(object_name), len;
+
+	if (capture_fd == -1)
+		return;
+	len = put_varint(record, arrived > capture_start ? arrived - capture_start : 0);
+	len += put_varint(record + len, size);
+	record[len++] = outcome;
+	record[len++] = name_len;
+	memcpy(record + len, object_name, name_len);
+	if (write(capture_fd, record, len + name_len) == -1)
+		warn("write capture");
+}
+
+/****
+ * Read the header of a capture
+ * start_us: Set to the time the capture started, in microseconds since the epoch
+ * return: 0 on success. -1 if the file is not a capture
+ ****/
+int capture_read_header(FILE *fp, unsigned long long *start_us) {
+	unsigned char header[16];
+	unsigned int i;
+
+	if (fread(header, 1, sizeof(header), fp) != sizeof(header) || memcmp(header, CAPTURE_MAGIC, 8) != 0)
+		return -1;
+	*start_us = 0;
+	for (i = 0; i < 8; i++)
+		*start_us |= (unsigned long long)header[8 + i] << (8 * i);
+	return 0;
+}
+
+/****
+ * Read the next record of a capture
+ * return: 1 if a record was read. 0 at the end of the capture. -1 if the record is malformed
+ ****/
+int capture_read(FILE *fp, struct capture_record *record) {
+	int outcome, name_len;
+	int c = getc(fp);
+
+	if (c == EOF)
+		return 0;
+	ungetc(c, fp);
+	if (get_varint(fp, &record->time_us) == -1 || get_varint(fp, &record->size) == -1 ||
+	    (outcome = getc(fp)) == EOF || outcome >= NUM_CAPTURE_OUTCOMES || (name_len = getc(fp)) == EOF || name_len == 0 ||
+	    fread(record->object_name, 1, name_len, fp) != (size_t)name_len)
+		return -1;
+	record->outcome = outcome;
+	record->object_name[name_len] = '\0';
+	return 1;
+}
@@ -0,0 +1,51 @@
+/*
+ * capture.h - Compact binary captures of the requests a proxy server answered
+ */
+
+#ifndef _CAPTURE_H_
+#define _CAPTURE_H_
+
+#include <stdio.h>
+#include "protocol.h"
+
+/*
+ * A capture starts with the 8 byte magic "TLSCAP01" and the time the capture
+ * started, in microseconds since the epoch, as a little endian 64 bit number.
+ * Every request is then one record:
+ *   microseconds from the start of the capture to the request's arrival (varint)
+ *   size of the object in bytes, 0 if unknown (varint)
+ *   outcome (1 byte)
+ *   length of the object name (1 byte), followed by the name
+ * Varints are unsigned LEB128. Records are appended when requests end, so
+ * concurrent requests are not in arrival order
+ */
+#define CAPTURE_MAGIC "TLSCAP01"
+#define CAPTURE_MAX_RECORD (10 + 10 + 1 + 1 + MAX_OBJECT_NAME)
+
+enum capture_outcome {
+	CAPTURE_HIT,				/* Answered from the cache without contacting the server first */
+	CAPTURE_MISS,				/* Fetched or revalidated from the server first */
+	CAPTURE_NOT_FOUND,
+	CAPTURE_DENIED,				/* Blacklisted */
+	CAPTURE_FAILED,				/* Bad range or unavailable */
+	NUM_CAPTURE_OUTCOMES
+};
+
+struct capture_record {
+	unsigned long long time_us;		/* Since the start of the capture */
+	unsigned long long size;
+	enum capture_outcome outcome;
+	char object_name[MAX_OBJECT_NAME + 1];
+};
+
+extern const char *const CAPTURE_OUTCOME_NAMES[];
+
+void capture_open(const char *path);
+int capture_enabled(void);
+unsigned long long capture_clock(void);
+void capture_write(unsigned long long arrived, const char *object_name, unsigned long long size,
+    enum capture_outcome outcome);
+int capture_read_header(FILE *fp, unsigned long long *start_us);
+int capture_read(FILE *fp, struct capture_record *record);
+
+#endif // _CAPTURE_H_
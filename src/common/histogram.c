@@ -0,0 +1,84 @@
+/*
+ * histogram.c - Log-linear latency histograms with bounded relative error
+ *
+ * Values below HISTOGRAM_SUB_BUCKETS are counted exactly. Every power of two above
+ * that is split into HISTOGRAM_SUB_BUCKETS equal buckets, so a bucket is never
+ * wider than 1/HISTOGRAM_SUB_BUCKETS of the values it holds and any 64 bit value
+ * can be recorded in constant time without allocation. Histograms recorded by
+ * different threads are merged by adding their buckets.
+ */
+
+#include <string.h>
+#include "histogram.h"
+
+static unsigned int bucket_of(unsigned long long value) {
+	if (value < HISTOGRAM_SUB_BUCKETS)
+		return value;
+	unsigned int exponent = 63 - __builtin_clzll(value);		// At least HISTOGRAM_SUB_BITS
+	unsigned int shift = exponent - HISTOGRAM_SUB_BITS;
+	return HISTOGRAM_SUB_BUCKETS * (shift + 1) + ((value >> shift) & (HISTOGRAM_SUB_BUCKETS - 1));
+}
+
+/****
+ * Get the largest value counted in a bucket
+ * return: The value
+ ****/
+static unsigned long long bucket_max(unsigned int bucket) {
+	if (bucket < HISTOGRAM_SUB_BUCKETS)
+		return bucket;
+	unsigned int shift = bucket / HISTOGRAM_SUB_BUCKETS - 1;
+	unsigned long long first = (unsigned long long)(HISTOGRAM_SUB_BUCKETS + bucket % HISTOGRAM_SUB_BUCKETS) << shift;
+	return first + ((1ULL << shift) - 1);
+}
+
+void histogram_init(struct histogram *histogram) {
+	memset(histogram, 0, sizeof(*histogram));
+}
+
+void histogram_record(struct histogram *histogram, unsigned long long value) {
+	histogram->counts[bucket_of(value)]++;
+	histogram->count++;
+	histogram->sum += value;
+	if (value > histogram->max)
+		histogram->max = value;
+}
+
+/****
+ * Add the values of one histogram to another
+ * return: Nothing
+ ****/
+void histogram_merge(struct histogram *into, const struct histogram *from) {
+	unsigned int i;
+
+	for (i = 0; i < HISTOGRAM_BUCKETS; i++)
+		into->counts[i] += from->counts[i];
+	into->count += from->count;
+	into->sum += from->sum;
+	if (from->max > into->max)
+		into->max = from->max;
+}
+
+/****
+ * Get the value at or below which a percentage of the recorded values fall
+ * percentile: Percentage between 0 and 100
+ * return: The largest value of the bucket holding the percentile, at most the largest value
+ *         recorded. 0 if nothing was recorded
+ ****/
+unsigned long long histogram_percentile(const struct histogram *histogram, double percentile) {
+	unsigned long long rank = (unsigned long long)(percentile / 100.0 * histogram->count + 0.5);
+	unsigned long long seen = 0;
+	unsigned int i;
+
+	if (rank == 0)
+		rank = 1;
+	for (i = 0; i < HISTOGRAM_BUCKETS; i++) {
+		seen += histogram->counts[i];
+		if (seen >= rank)
+			return bucket_max(i) < histogram->max ? bucket_max(i) : histogram->max;
+	}
+	return histogram->max;
+}
+
+double histogram_mean(const struct histogram *histogram) {
+	return histogram->count ? histogram->sum / histogram->count : 0.0;
+}
@@ -0,0 +1,25 @@
+/*
+ * histogram.h - Log-linear latency histograms with bounded relative error
+ */
+
+#ifndef _HISTOGRAM_H_
+#define _HISTOGRAM_H_
+
+#define HISTOGRAM_SUB_BITS 7
+#define HISTOGRAM_SUB_BUCKETS (1 << HISTOGRAM_SUB_BITS)
+#define HISTOGRAM_BUCKETS ((64 - HISTOGRAM_SUB_BITS + 1) * HISTOGRAM_SUB_BUCKETS)
+
+struct histogram {
+	unsigned long long counts[HISTOGRAM_BUCKETS];
+	unsigned long long count;		/* Values recorded */
+	unsigned long long max;			/* Largest value recorded */
+	double sum;				/* Sum of the values recorded */
+};
+
+void histogram_init(struct histogram *histogram);
+void histogram_record(struct histogram *histogram, unsigned long long value);
+void histogram_merge(struct histogram *into, const struct histogram *from);
+unsigned long long histogram_percentile(const struct histogram *histogram, double percentile);
+double histogram_mean(const struct histogram *histogram);
+
+#endif // _HISTOGRAM_H_
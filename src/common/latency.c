@@ -0,0 +1,232 @@
+/*
+ * latency.c - Per-stage latency histograms shared by the processes of a program
+ *
+ * A program names the stages a request goes through and times each one with the
+ * monotonic clock. Recording a latency only appends it to a small buffer of the
+ * calling thread. The buffer is flushed into histograms in shared memory at the end
+ * of every connection or when it fills up, so the histograms collect the stages of
+ * every thread and of every process forked after latency_init, including processes
+ * that have already exited. The shared histograms are protected by a robust
+ * process-shared mutex, so a process that dies while flushing cannot block the
+ * others. Latencies are recorded in nanoseconds and printed in microseconds.
+ */
+
+#include <sys/types.h>
+#include <sys/mman.h>
+
+#include <err.h>
+#include <errno.h>
+#include <pthread.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "histogram.h"
+#include "latency.h"
+#include "trace.h"
+
+#define LATENCY_BUFFER_LEN 256
+
+struct latency_sample {
+	unsigned int stage;
+	unsigned long long ns;
+};
+
+struct latency_shared {
+	pthread_mutex_t lock;
+	struct histogram stages[];		/* One histogram per stage */
+};
+
+static const char *const *stage_names;
+static unsigned int num_stages;
+static struct latency_shared *shared;
+static int dump_signal;
+
+static __thread struct {
+	unsigned int count;
+	struct latency_sample samples[LATENCY_BUFFER_LEN];
+} buffer;
+
+/****
+ * Map the shared histograms. Must be called before the processes that record
+ * latencies are forked
+ * names: Name of every stage, indexed by stage number. Must stay valid
+ * return: Nothing
+ ****/
+void latency_init(const char *const names[], unsigned int count) {
+	pthread_mutexattr_t attr;
+	unsigned int i;
+
+	if (count > MAX_LATENCY_STAGES)
+		errx(1, "Too many latency stages");
+	stage_names = names;
+	num_stages = count;
+	shared = mmap(NULL, sizeof(*shared) + count * sizeof(shared->stages[0]), PROT_READ | PROT_WRITE,
+	    MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+	if (shared == MAP_FAILED)
+		err(1, "mmap");
+
+	pthread_mutexattr_init(&attr);
+	pthread_mutexattr_setpshared(&attr, PTHREAD_PROCESS_SHARED);
+	pthread_mutexattr_setrobust(&attr, PTHREAD_MUTEX_ROBUST);
+	pthread_mutex_init(&shared->lock, &attr);
+	pthread_mutexattr_destroy(&attr);
+	for (i = 0; i < count; i++)
+		histogram_init(&shared->stages[i]);
+}
+
+/****
+ * Read the monotonic clock
+ * return: Nanoseconds since an arbitrary starting point
+ ****/
+unsigned long long latency_clock(void) {
+	struct timespec now;
+
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return now.tv_sec * 1000000000ULL + now.tv_nsec;
+}
+
+/****
+ * Record the time from start until now for a stage. Also a span of the request
+ * being traced, if any
+ * start: Time the stage started, from latency_clock
+ * return: The current time, so the next stage can start where this one ended
+ ****/
+unsigned long long latency_record(unsigned int stage, unsigned long long start) {
+	unsigned long long now = latency_clock();
+
+	if (shared == NULL)
+		return now;
+	trace_span(stage_names[stage], start, now);
+	if (buffer.count == LATENCY_BUFFER_LEN)
+		latency_flush();
+	buffer.samples[buffer.count].stage = stage;
+	buffer.samples[buffer.count++].ns = now - start;
+	return now;
+}
+
+static void lock_shared() {
+	if (pthread_mutex_lock(&shared->lock) == EOWNERDEAD)
+		pthread_mutex_consistent(&shared->lock);	// A histogram may miss part of the dead process's samples
+}
+
+/****
+ * Add the latencies buffered by the calling thread to the shared histograms
+ * return: Nothing
+ ****/
+void latency_flush(void) {
+	unsigned int i;
+
+	if (shared == NULL || buffer.count == 0)
+		return;
+	lock_shared();
+	for (i = 0; i < buffer.count; i++)
+		histogram_record(&shared->stages[buffer.samples[i].stage], buffer.samples[i].ns);
+	pthread_mutex_unlock(&shared->lock);
+	buffer.count = 0;
+}
+
+static double us(unsigned long long ns) {
+	return ns / 1000.0;
+}
+
+/****
+ * Print the count, mean, percentiles and maximum of every stage recorded so far
+ * return: Nothing
+ ****/
+void latency_dump(FILE *fp) {
+	struct histogram *copy;
+	unsigned int i;
+
+	if (shared == NULL)
+		return;
+	if ((copy = malloc(num_stages * sizeof(*copy))) == NULL) {
+		warn("malloc");
+		return;
+	}
+	latency_flush();
+	lock_shared();
+	memcpy(copy, shared->stages, num_stages * sizeof(*copy));
+	pthread_mutex_unlock(&shared->lock);
+
+	fprintf(fp, "%-16s %10s %12s %12s %12s %12s %12s\n", "Stage (us)", "count", "mean", "p50", "p90", "p99", "max");
+	for (i = 0; i < num_stages; i++) {
+		const struct histogram *h = &copy[i];
+		fprintf(fp, "%-16s %10llu %12.1f %12.1f %12.1f %12.1f %12.1f\n", stage_names[i], h->count,
+		    histogram_mean(h) / 1000.0, us(histogram_percentile(h, 50)), us(histogram_percentile(h, 90)),
+		    us(histogram_percentile(h, 99)), us(h->max));
+	}
+	fflush(fp);
+	free(copy);
+}
+
+/****
+ * Write the latency of every stage as a Prometheus summary in seconds
+ * name: Name of the summary. Stages are told apart by a "stage" label
+ * return: Nothing
+ ****/
+void latency_write_metrics(FILE *fp, const char *name) {
+	const double QUANTILES[] = {0.5, 0.9, 0.99};
+	struct histogram *copy;
+	unsigned int i, j;
+
+	if (shared == NULL)
+		return;
+	if ((copy = malloc(num_stages * sizeof(*copy))) == NULL) {
+		warn("malloc");
+		return;
+	}
+	latency_flush();
+	lock_shared();
+	memcpy(copy, shared->stages, num_stages * sizeof(*copy));
+	pthread_mutex_unlock(&shared->lock);
+
+	fprintf(fp, "# HELP %s Time spent in each stage of serving a request\n# TYPE %s summary\n", name, name);
+	for (i = 0; i < num_stages; i++) {
+		const struct histogram *h = &copy[i];
+
+		for (j = 0; j < sizeof(QUANTILES) / sizeof(QUANTILES[0]); j++)
+			fprintf(fp, "%s{stage=\"%s\",quantile=\"%g\"} %.9f\n", name, stage_names[i], QUANTILES[j],
+			    histogram_percentile(h, QUANTILES[j] * 100) / 1e9);
+		fprintf(fp, "%s_sum{stage=\"%s\"} %.9f\n", name, stage_names[i], histogram_mean(h) * h->count / 1e9);
+		fprintf(fp, "%s_count{stage=\"%s\"} %llu\n", name, stage_names[i], h->count);
+	}
+	free(copy);
+}
+
+static void *run_dumper(void *arg) {
+	sigset_t mask;
+	int signum;
+
+	sigemptyset(&mask);
+	sigaddset(&mask, dump_signal);
+	for (;;) {
+		if (sigwait(&mask, &signum) == 0)
+			latency_dump(stdout);
+	}
+	return NULL;
+}
+
+/****
+ * Print the stage latencies to stdout whenever the calling process receives a signal.
+ * The signal is blocked and waited for by a thread of its own, so this must be
+ * called before any other thread is started. Processes forked later inherit the
+ * blocked signal and ignore it
+ * return: Nothing
+ ****/
+void latency_dump_on_signal(int signum) {
+	pthread_t thread;
+	sigset_t mask, all;
+
+	dump_signal = signum;
+	sigemptyset(&mask);
+	sigaddset(&mask, signum);
+	pthread_sigmask(SIG_BLOCK, &mask, NULL);
+	sigfillset(&all);				// Other signals, such as SIGCHLD, stay with the calling thread
+	pthread_sigmask(SIG_SETMASK, &all, &mask);
+	if (pthread_create(&thread, NULL, run_dumper, NULL) != 0)
+		errx(1, "pthread_create failed");
+	pthread_sigmask(SIG_SETMASK, &mask, NULL);
+	pthread_detach(thread);
+}
@@ -0,0 +1,20 @@
+/*
+ * latency.h - Per-stage latency histograms shared by the processes of a program
+ */
+
+#ifndef _LATENCY_H_
+#define _LATENCY_H_
+
+#include <stdio.h>
+
+#define MAX_LATENCY_STAGES 16
+
+void latency_init(const char *const names[], unsigned int num_stages);
+unsigned long long latency_clock(void);
+unsigned long long latency_record(unsigned int stage, unsigned long long start);
+void latency_flush(void);
+void latency_dump(FILE *fp);
+void latency_write_metrics(FILE *fp, const char *name);
+void latency_dump_on_signal(int signum);
+
+#endif // _LATENCY_H_
@@ -0,0 +1,322 @@
+/*
+ * log.c - Leveled logging through per-thread rings drained by a background thread
+ *
+ * Logging a message only formats it into the next slot of a ring owned by the
+ * calling thread and publishes the slot with a release store, so threads never
+ * wait for each other or for the output. A drain thread started by the first
+ * message of every process empties the rings every LOG_DRAIN_MS milliseconds and
+ * writes the lines in large blocks. A thread whose ring is full drops its message
+ * and the drain thread reports how many were dropped.
+ *
+ * Every line has the same fields: UTC time with microseconds, level, process and
+ * thread number, then the message. Before a fork every ring is drained, so lines
+ * logged before the fork are written once. The child keeps only the ring of the
+ * forking thread and starts its own drain thread when it logs.
+ */
+
+#include <sys/types.h>
+
+#include <err.h>
+#include <pthread.h>
+#include <signal.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include "log.h"
+
+#define LOG_RING_SLOTS 512
+#define LOG_RECORD_LEN 480
+#define LOG_OUTPUT_LEN 65536
+
+const unsigned int LOG_DRAIN_MS = 10;
+const char *LEVEL_NAMES[] = {"error", "warn", "info", "debug"};
+
+struct log_record {
+	struct timespec time;			/* CLOCK_REALTIME */
+	unsigned short len;
+	unsigned char level;
+	char text[LOG_RECORD_LEN];
+};
+
+struct log_ring {
+	struct log_ring *next;			/* Rings of the process, newest first */
+	unsigned int thread;			/* Order the thread first logged in */
+	unsigned long head;			/* Next slot to fill. Written by the owning thread */
+	unsigned long tail;			/* Next slot to write out. Written by the drain */
+	unsigned long long dropped;
+	unsigned long long reported;		/* Drops already reported by the drain */
+	struct log_record records[LOG_RING_SLOTS];
+};
+
+enum log_level log_threshold = LOG_LEVEL_INFO;
+int log_content_enabled;
+
+static int output_fd = STDOUT_FILENO;
+static struct log_ring *rings;
+static unsigned int num_rings;
+static int drain_running;
+static pthread_mutex_t rings_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_mutex_t drain_lock = PTHREAD_MUTEX_INITIALIZER;	/* Held while rings are written out */
+static char output[LOG_OUTPUT_LEN];		/* Lines waiting to be written. Protected by drain_lock */
+static size_t output_len;
+static __thread struct log_ring *thread_ring;
+
+static void write_output() {
+	size_t done = 0;
+
+	while (done < output_len) {
+		ssize_t n = write(output_fd, output + done, output_len - done);
+		if (n <= 0)
+			break;				// Nowhere to report it. The lines are lost
+		done += n;
+	}
+	output_len = 0;
+}
+
+static void append_line(const struct timespec *time, unsigned int level, unsigned int thread, const char *text,
+    unsigned int len)
+{
+	struct tm tm;
+	int n;
+
+	if (output_len + len + 96 > sizeof(output))
+		write_output();
+	gmtime_r(&time->tv_sec, &tm);
+	n = snprintf(output + output_len, sizeof(output) - output_len, "%04d-%02d-%02dT%02d:%02d:%02d.%06ldZ %-5s %ld/%u ",
+	    tm.tm_year + 1900, tm.tm_mon + 1, tm.tm_mday, tm.tm_hour, tm.tm_min, tm.tm_sec, time->tv_nsec / 1000,
+	    LEVEL_NAMES[level], (long)getpid(), thread);
+	output_len += n;
+	memcpy(output + output_len, text, len);
+	output_len += len;
+	output[output_len++] = '\n';
+}
+
+/****
+ * Write out every published record of every ring. Called with drain_lock held
+ * return: Nothing
+ ****/
+static void drain_rings() {
+	struct log_ring *ring;
+
+	for (ring = __atomic_load_n(&rings, __ATOMIC_ACQUIRE); ring != NULL; ring = ring->next) {
+		unsigned long tail = ring->tail;
+		unsigned long head = __atomic_load_n(&ring->head, __ATOMIC_ACQUIRE);
+		unsigned long long dropped;
+
+		for (; tail != head; tail++) {
+			const struct log_record *record = &ring->records[tail % LOG_RING_SLOTS];
+			append_line(&record->time, record->level, ring->thread, record->text, record->len);
+		}
+		__atomic_store_n(&ring->tail, tail, __ATOMIC_RELEASE);
+
+		dropped = __atomic_load_n(&ring->dropped, __ATOMIC_RELAXED);
+		if (dropped != ring->reported) {
+			char text[64];
+			struct timespec now;
+			int len = snprintf(text, sizeof(text), "Dropped %llu log messages", dropped - ring->reported);
+
+			clock_gettime(CLOCK_REALTIME, &now);
+			append_line(&now, LOG_LEVEL_WARN, ring->thread, text, len);
+			ring->reported = dropped;
+		}
+	}
+	write_output();
+}
+
+static void *run_drain(void *arg) {
+	for (;;) {
+		usleep(LOG_DRAIN_MS * 1000);
+		pthread_mutex_lock(&drain_lock);
+		drain_rings();
+		pthread_mutex_unlock(&drain_lock);
+	}
+	return NULL;
+}
+
+/****
+ * Write out the lines of every thread before forking, so the child does not repeat them
+ * return: Nothing
+ ****/
+static void prepare_fork() {
+	pthread_mutex_lock(&rings_lock);
+	pthread_mutex_lock(&drain_lock);
+	drain_rings();
+}
+
+static void resume_parent() {
+	pthread_mutex_unlock(&drain_lock);
+	pthread_mutex_unlock(&rings_lock);
+}
+
+/****
+ * Forget the parent's other threads and drain thread in a forked child
+ * return: Nothing
+ ****/
+static void reset_child() {
+	pthread_mutex_init(&rings_lock, NULL);
+	pthread_mutex_init(&drain_lock, NULL);
+	rings = thread_ring;
+	num_rings = 0;
+	if (thread_ring != NULL) {
+		thread_ring->next = NULL;
+		thread_ring->thread = num_rings++;
+	}
+	drain_running = 0;
+}
+
+/****
+ * Start the drain thread of this process. Called with rings_lock held. The thread
+ * blocks every signal so signals stay with the threads waiting for them
+ * return: Nothing
+ ****/
+static void start_drain() {
+	static int registered;
+	sigset_t all, mask;
+	pthread_t thread;
+
+	if (!registered && pthread_atfork(prepare_fork, resume_parent, reset_child) != 0)
+		errx(1, "pthread_atfork failed");
+	registered = 1;
+
+	sigfillset(&all);
+	pthread_sigmask(SIG_SETMASK, &all, &mask);
+	if (pthread_create(&thread, NULL, run_drain, NULL) != 0)
+		errx(1, "pthread_create failed");
+	pthread_sigmask(SIG_SETMASK, &mask, NULL);
+	pthread_detach(thread);
+	__atomic_store_n(&drain_running, 1, __ATOMIC_RELEASE);
+}
+
+/****
+ * Give the calling thread a ring and make sure the process has a drain thread
+ * return: The calling thread's ring. Exits if it cannot be allocated
+ ****/
+static struct log_ring *register_thread() {
+	struct log_ring *ring = thread_ring;
+
+	pthread_mutex_lock(&rings_lock);
+	if (ring == NULL) {
+		if ((ring = calloc(1, sizeof(*ring))) == NULL)
+			err(1, "calloc");
+		ring->thread = num_rings++;
+		ring->next = rings;
+		__atomic_store_n(&rings, ring, __ATOMIC_RELEASE);
+		thread_ring = ring;
+	}
+	if (!drain_running)
+		start_drain();
+	pthread_mutex_unlock(&rings_lock);
+	return ring;
+}
+
+/****
+ * Set where lines are written and what is logged. Lines are written when the
+ * program exits even if the drain thread has not got to them
+ * fd: File descriptor lines are written to
+ * level: Most detailed level logged
+ * content: 1 to log the content of objects sent
+ * return: Nothing
+ ****/
+void log_init(int fd, enum log_level level, int content) {
+	output_fd = fd;
+	log_threshold = level;
+	log_content_enabled = content;
+	atexit(log_flush);
+}
+
+/****
+ * Look up a level by name
+ * level: Set to the level named
+ * return: 0 on success. -1 if there is no level of that name
+ ****/
+int log_parse_level(const char *name, enum log_level *level) {
+	unsigned int i;
+
+	for (i = 0; i < sizeof(LEVEL_NAMES) / sizeof(LEVEL_NAMES[0]); i++) {
+		if (strcmp(name, LEVEL_NAMES[i]) == 0) {
+			*level = i;
+			return 0;
+		}
+	}
+	return -1;
+}
+
+/****
+ * Log a message. Use the log_error, log_warn, log_info and log_debug macros, which
+ * skip formatting the message if its level is not logged. Messages longer than a
+ * ring slot are truncated
+ * format: printf format of the message, without a trailing newline
+ * return: Nothing
+ ****/
+void log_message(enum log_level level, const char *format, ...) {
+	struct log_ring *ring = thread_ring;
+	struct log_record *record;
+	unsigned long head;
+	va_list ap;
+	int len;
+
+	if (ring == NULL || !__atomic_load_n(&drain_running, __ATOMIC_ACQUIRE))
+		ring = register_thread();
+	head = ring->head;
+	if (head - __atomic_load_n(&ring->tail, __ATOMIC_ACQUIRE) == LOG_RING_SLOTS) {
+		__atomic_fetch_add(&ring->dropped, 1, __ATOMIC_RELAXED);
+		return;
+	}
+
+	record = &ring->records[head % LOG_RING_SLOTS];
+	clock_gettime(CLOCK_REALTIME, &record->time);
+	va_start(ap, format);
+	len = vsnprintf(record->text, sizeof(record->text), format, ap);
+	va_end(ap);
+	if (len < 0)
+		len = 0;
+	else if (len >= (int)sizeof(record->text))
+		len = sizeof(record->text) - 1;
+	record->len = len;
+	record->level = level;
+	__atomic_store_n(&ring->head, head + 1, __ATOMIC_RELEASE);
+}
+
+/****
+ * Log the content of an object sent, if content logging is enabled. Line breaks and
+ * other control characters are escaped so every chunk stays on one line
+ * return: Nothing
+ ****/
+void log_content(const char *data, size_t len) {
+	char chunk[LOG_RECORD_LEN - 16];
+	size_t used = 0, i;
+
+	if (!log_content_enabled || log_threshold < LOG_LEVEL_INFO)
+		return;
+	for (i = 0; i < len; i++) {
+		unsigned char c = data[i];
+
+		if (used + 5 > sizeof(chunk)) {		// Room for the longest escape and its terminator
+			log_message(LOG_LEVEL_INFO, "Content: %.*s", (int)used, chunk);
+			used = 0;
+		}
+		if (c == '\n')
+			used += snprintf(chunk + used, sizeof(chunk) - used, "\\n");
+		else if (c == '\\')
+			used += snprintf(chunk + used, sizeof(chunk) - used, "\\\\");
+		else if (c < 0x20 || c >= 0x7f)
+			used += snprintf(chunk + used, sizeof(chunk) - used, "\\x%02x", c);
+		else
+			chunk[used++] = c;
+	}
+	if (used > 0)
+		log_message(LOG_LEVEL_INFO, "Content: %.*s", (int)used, chunk);
+}
+
+/****
+ * Write out every line logged so far by any thread of the process
+ * return: Nothing
+ ****/
+void log_flush(void) {
+	pthread_mutex_lock(&drain_lock);
+	drain_rings();
+	pthread_mutex_unlock(&drain_lock);
+}
@@ -0,0 +1,39 @@
+/*
+ * log.h - Leveled logging through per-thread rings drained by a background thread
+ */
+
+#ifndef _LOG_H_
+#define _LOG_H_
+
+#include <stddef.h>
+
+enum log_level {
+	LOG_LEVEL_ERROR,
+	LOG_LEVEL_WARN,
+	LOG_LEVEL_INFO,
+	LOG_LEVEL_DEBUG
+};
+
+extern enum log_level log_threshold;
+extern int log_content_enabled;
+
+void log_init(int fd, enum log_level level, int content);
+int log_parse_level(const char *name, enum log_level *level);
+void log_message(enum log_level level, const char *format, ...) __attribute__((format(printf, 2, 3)));
+void log_content(const char *data, size_t len);
+void log_flush(void);
+
+#define log_at(level, ...) do { if (log_threshold >= (level)) log_message((level), __VA_ARGS__); } while (0)
+#define log_error(...) log_at(LOG_LEVEL_ERROR, __VA_ARGS__)
+#define log_warn(...) log_at(LOG_LEVEL_WARN, __VA_ARGS__)
+#define log_info(...) log_at(LOG_LEVEL_INFO, __VA_ARGS__)
+
+/* Debug messages are only compiled in with DEBUG_LOG. Otherwise their arguments are
+ * still type checked but the calls are removed as dead code */
+#ifdef DEBUG_LOG
+#define log_debug(...) log_at(LOG_LEVEL_DEBUG, __VA_ARGS__)
+#else
+#define log_debug(...) do { if (0) log_message(LOG_LEVEL_DEBUG, __VA_ARGS__); } while (0)
+#endif
+
+#endif // _LOG_H_
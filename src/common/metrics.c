@@ -0,0 +1,232 @@
+/*
+ * metrics.c - Counters shared by the processes of a program and served in Prometheus text format
+ *
+ * A program describes its counters and gauges in a table, optionally with one label
+ * whose values are known up front. Their values live in shared memory mapped by
+ * metrics_init, so they collect the counts of every process forked afterwards. The
+ * memory is split into METRIC_SHARDS cache-line aligned shards. Every thread, and
+ * every forked process, picks a shard the first time it records something and only
+ * adds to that shard with relaxed atomic adds, so recording does not take a lock and
+ * threads rarely share a cache line. Readers add up the shards.
+ *
+ * metrics_serve answers plaintext HTTP requests for /metrics on a loopback admin
+ * port from a thread of the calling process.
+ */
+
+#include <sys/types.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <netinet/in.h>
+
+#include <err.h>
+#include <errno.h>
+#include <pthread.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "metrics.h"
+
+#define METRIC_SHARDS 64
+
+const unsigned int ADMIN_TIMEOUT_S = 1;
+
+struct metrics_shard {
+	long long values[MAX_METRIC_VALUES];
+};
+
+struct metrics_shared {
+	unsigned int next_shard;
+	struct metrics_shard shards[METRIC_SHARDS] __attribute__((aligned(64)));
+};
+
+static const struct metric *metrics;
+static unsigned int num_metrics;
+static unsigned int first_value[MAX_METRIC_VALUES];	/* Index of each metric's first value in a shard */
+static struct metrics_shared *shared;
+static __thread int thread_shard = -1;
+static int admin_sd;
+static void (*admin_extra)(FILE *fp);
+
+static void reset_child() {
+	thread_shard = -1;				// The forking thread is the only one left
+}
+
+/****
+ * Map the shared counters. Must be called before the processes that record them are forked
+ * table: Description of every metric, indexed by metric number. Must stay valid
+ * return: Nothing
+ ****/
+void metrics_init(const struct metric table[], unsigned int count) {
+	unsigned int i, values = 0;
+
+	if (count > MAX_METRIC_VALUES)
+		errx(1, "Too many metrics");
+	for (i = 0; i < count; i++) {
+		first_value[i] = values;
+		values += table[i].label != NULL ? table[i].num_label_values : 1;
+	}
+	if (values > MAX_METRIC_VALUES)
+		errx(1, "Too many metrics");
+	metrics = table;
+	num_metrics = count;
+	shared = mmap(NULL, sizeof(*shared), PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+	if (shared == MAP_FAILED)
+		err(1, "mmap");
+	if (pthread_atfork(NULL, NULL, reset_child) != 0)
+		errx(1, "pthread_atfork failed");
+}
+
+/****
+ * Add to a counter or gauge. Gauges go down by adding a negative amount
+ * label: Index of the label value. 0 for metrics without a label
+ * return: Nothing
+ ****/
+void metrics_add(unsigned int metric, unsigned int label, long long n) {
+	if (shared == NULL)
+		return;
+	if (thread_shard == -1)
+		thread_shard = __atomic_fetch_add(&shared->next_shard, 1, __ATOMIC_RELAXED) % METRIC_SHARDS;
+	__atomic_fetch_add(&shared->shards[thread_shard].values[first_value[metric] + label], n, __ATOMIC_RELAXED);
+}
+
+/****
+ * Add up a metric over every shard
+ * return: The metric's current value
+ ****/
+long long metrics_value(unsigned int metric, unsigned int label) {
+	long long sum = 0;
+	unsigned int i;
+
+	if (shared == NULL)
+		return 0;
+	for (i = 0; i < METRIC_SHARDS; i++)
+		sum += __atomic_load_n(&shared->shards[i].values[first_value[metric] + label], __ATOMIC_RELAXED);
+	return sum;
+}
+
+/****
+ * Write every metric in Prometheus text format
+ * return: Nothing
+ ****/
+void metrics_write(FILE *fp) {
+	unsigned int i, j;
+
+	for (i = 0; i < num_metrics; i++) {
+		const struct metric *metric = &metrics[i];
+
+		fprintf(fp, "# HELP %s %s\n# TYPE %s %s\n", metric->name, metric->help, metric->name,
+		    metric->type == METRIC_GAUGE ? "gauge" : "counter");
+		if (metric->label == NULL) {
+			fprintf(fp, "%s %lld\n", metric->name, metrics_value(i, 0));
+			continue;
+		}
+		for (j = 0; j < metric->num_label_values; j++)
+			fprintf(fp, "%s{%s=\"%s\"} %lld\n", metric->name, metric->label, metric->label_values[j], metrics_value(i, j));
+	}
+}
+
+static int send_all(int fd, const char *buf, size_t len) {
+	while (len > 0) {
+		ssize_t n = send(fd, buf, len, MSG_NOSIGNAL);
+		if (n <= 0)
+			return -1;
+		buf += n;
+		len -= n;
+	}
+	return 0;
+}
+
+/****
+ * Answer one HTTP request on the admin port. Anything but a GET of /metrics is answered 404
+ * return: Nothing
+ ****/
+static void serve_admin(int fd) {
+	struct timeval timeout = { ADMIN_TIMEOUT_S, 0 };
+	char request[1024];
+	char header[256];
+	char *body = NULL;
+	size_t len = 0, body_len = 0;
+	const char *status = "200 OK";
+	ssize_t n;
+	FILE *fp;
+
+	setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+	setsockopt(fd, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout));
+	request[0] = '\0';
+	while (len < sizeof(request) - 1 && strstr(request, "\r\n\r\n") == NULL && strstr(request, "\n\n") == NULL &&
+	    (n = read(fd, request + len, sizeof(request) - 1 - len)) > 0) {
+		len += n;
+		request[len] = '\0';
+	}
+
+	if ((fp = open_memstream(&body, &body_len)) == NULL) {
+		warn("open_memstream");
+		return;
+	}
+	if (strncmp(request, "GET /metrics ", 13) == 0 || strncmp(request, "GET /metrics\r", 13) == 0) {
+		metrics_write(fp);
+		if (admin_extra != NULL)
+			admin_extra(fp);
+	} else {
+		status = "404 Not Found";
+		fprintf(fp, "Only /metrics is served\n");
+	}
+	fclose(fp);
+
+	n = snprintf(header, sizeof(header), "HTTP/1.0 %s\r\nContent-Type: text/plain; version=0.0.4\r\n"
+	    "Content-Length: %zu\r\nConnection: close\r\n\r\n", status, body_len);
+	if (send_all(fd, header, n) == 0)
+		send_all(fd, body, body_len);
+	free(body);
+}
+
+static void *run_admin(void *arg) {
+	for (;;) {
+		int fd = accept(admin_sd, NULL, NULL);
+		if (fd == -1) {
+			if (errno != EINTR && errno != ECONNABORTED)
+				warn("accept on admin port");
+			continue;
+		}
+		serve_admin(fd);
+		close(fd);
+	}
+	return NULL;
+}
+
+/****
+ * Serve the metrics over plaintext HTTP on a loopback port from a thread of the
+ * calling process. The thread blocks every signal
+ * write_extra: Called to append metrics that are not counters of the table. May be NULL
+ * return: Nothing. Exits if the port cannot be bound
+ ****/
+void metrics_serve(u_short port, void (*write_extra)(FILE *fp)) {
+	struct sockaddr_in sockname;
+	sigset_t all, mask;
+	pthread_t thread;
+	int on = 1;
+
+	memset(&sockname, 0, sizeof(sockname));
+	sockname.sin_family = AF_INET;
+	sockname.sin_port = htons(port);
+	sockname.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+	if ((admin_sd = socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0)) == -1)
+		err(1, "socket failed");
+	if (setsockopt(admin_sd, SOL_SOCKET, SO_REUSEADDR, &on, sizeof(on)) == -1)
+		err(1, "setsockopt failed");
+	if (bind(admin_sd, (struct sockaddr *)&sockname, sizeof(sockname)) == -1)
+		err(1, "bind admin port failed");
+	if (listen(admin_sd, 16) == -1)
+		err(1, "listen failed");
+	admin_extra = write_extra;
+
+	sigfillset(&all);
+	pthread_sigmask(SIG_SETMASK, &all, &mask);
+	if (pthread_create(&thread, NULL, run_admin, NULL) != 0)
+		errx(1, "pthread_create failed");
+	pthread_sigmask(SIG_SETMASK, &mask, NULL);
+	pthread_detach(thread);
+}
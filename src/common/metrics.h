@@ -0,0 +1,33 @@
+/*
+ * metrics.h - Counters shared by the processes of a program and served in Prometheus text format
+ */
+
+#ifndef _METRICS_H_
+#define _METRICS_H_
+
+#include <sys/types.h>
+#include <stdio.h>
+
+#define MAX_METRIC_VALUES 256
+
+enum metric_type {
+	METRIC_COUNTER,
+	METRIC_GAUGE
+};
+
+struct metric {
+	const char *name;
+	const char *help;
+	enum metric_type type;
+	const char *label;			/* Name of the metric's label. NULL if it has none */
+	const char *const *label_values;	/* Values of the label, indexed by the label passed to metrics_add */
+	unsigned int num_label_values;
+};
+
+void metrics_init(const struct metric metrics[], unsigned int count);
+void metrics_add(unsigned int metric, unsigned int label, long long n);
+long long metrics_value(unsigned int metric, unsigned int label);
+void metrics_write(FILE *fp);
+void metrics_serve(u_short port, void (*write_extra)(FILE *fp));
+
+#endif // _METRICS_H_
@@ -0,0 +1,37 @@
+/*
+ * options.c - Parsing command line arguments shared by the executables
+ */
+
+#include <errno.h>
+#include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "options.h"
+
+/****
+ * Parse a decimal argument
+ * max: Largest value accepted
+ * return: The value. Prints the usage and exits if the argument is not a number or
+ *         is out of range
+ ****/
+u_long parse_number(const char *arg, u_long max)
+{
+	char *ep;
+	u_long p;
+
+	errno = 0;
+	p = strtoul(arg, &ep, 10);
+	if (*arg == '\0' || *ep != '\0') {
+		/* parameter wasn't a number, or was empty */
+		fprintf(stderr, "%s - not a number\n", arg);
+		usage();
+	}
+	if ((errno == ERANGE && p == ULONG_MAX) || (p > max)) {
+		/* It's a number, but it either can't fit in an unsigned
+		 * long, or is bigger than max
+		 */
+		fprintf(stderr, "%s - value out of range\n", arg);
+		usage();
+	}
+	return p;
+}
@@ -0,0 +1,15 @@
+/*
+ * options.h - Parsing command line arguments shared by the executables
+ */
+
+#ifndef _OPTIONS_H_
+#define _OPTIONS_H_
+
+#include <sys/types.h>
+
+/* Defined by the program parsing its options: prints how to run it and exits */
+void usage(void);
+
+u_long parse_number(const char *arg, u_long max);
+
+#endif // _OPTIONS_H_
@@ -0,0 +1,197 @@
+/*
+ * protocol.c - Message framing shared by the client, proxy and server
+ */
+
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "protocol.h"
+
+/****
+ * Fill the stream's buffer with the next chunk of data from the TLS connection
+ * stream: Stream whose buffer has been fully consumed
+ * return: Number of bytes buffered. 0 on end of stream. -1 on error
+ ****/
+static ssize_t stream_fill(struct tls_stream *stream) {
+	ssize_t ret;
+
+	do {
+		ret = tls_read(stream->ctx, stream->buf, sizeof(stream->buf));
+	} while (ret == TLS_WANT_POLLIN || ret == TLS_WANT_POLLOUT);
+
+	if (ret < 0)
+		return -1;
+
+	stream->pos = 0;
+	stream->len = ret;
+	return ret;
+}
+
+/****
+ * Prepare a stream for reading from a TLS connection
+ * stream: Stream to initialize
+ * ctx: Connected TLS context to read from
+ * return: Nothing
+ ****/
+void stream_init(struct tls_stream *stream, struct tls *ctx) {
+	stream->ctx = ctx;
+	stream->pos = 0;
+	stream->len = 0;
+}
+
+/****
+ * Wait until the stream has buffered data, reading from the connection only if the buffer is empty
+ * return: 1 if data is buffered. 0 on end of stream. -1 on error
+ ****/
+int stream_wait(struct tls_stream *stream) {
+	ssize_t ret;
+
+	if (stream->pos < stream->len)
+		return 1;
+	if ((ret = stream_fill(stream)) < 0)
+		return -1;
+	return ret > 0;
+}
+
+/****
+ * Read one '\n' terminated line. The newline is stripped from the result
+ * line: Buffer the line is copied into. Always NUL terminated on success
+ * size: Size of line
+ * return: 1 if a line was read. 0 on end of stream. -1 on error or if the line does not fit
+ ****/
+int stream_read_line(struct tls_stream *stream, char *line, size_t size) {
+	size_t n = 0;
+
+	for (;;) {
+		if (stream->pos == stream->len) {
+			ssize_t ret = stream_fill(stream);
+			if (ret < 0)
+				return -1;
+			if (ret == 0) {
+				if (n == 0)
+					return 0;
+				break;			// Last line was not terminated
+			}
+		}
+
+		char c = stream->buf[stream->pos++];
+		if (c == '\n')
+			break;
+		if (n + 1 >= size)
+			return -1;
+		line[n++] = c;
+	}
+
+	if (n > 0 && line[n - 1] == '\r')
+		n--;
+	line[n] = '\0';
+	return 1;
+}
+
+/****
+ * Read up to size bytes, draining buffered data before touching the connection
+ * return: Number of bytes read. 0 on end of stream. -1 on error
+ ****/
+ssize_t stream_read(struct tls_stream *stream, void *buf, size_t size) {
+	if (stream->pos == stream->len) {
+		ssize_t ret = stream_fill(stream);
+		if (ret <= 0)
+			return ret;
+	}
+
+	size_t n = stream->len - stream->pos;
+	if (n > size)
+		n = size;
+	memcpy(buf, stream->buf + stream->pos, n);
+	stream->pos += n;
+	return n;
+}
+
+/****
+ * Write a whole buffer to a TLS connection, retrying short writes
+ * return: 0 on success. -1 on error
+ ****/
+int tls_write_all(struct tls *ctx, const void *buf, size_t len) {
+	const char *p = buf;
+
+	while (len > 0) {
+		ssize_t ret = tls_write(ctx, p, len);
+		if (ret == TLS_WANT_POLLIN || ret == TLS_WANT_POLLOUT)
+			continue;
+		if (ret < 0)
+			return -1;
+		p += ret;
+		len -= ret;
+	}
+
+	return 0;
+}
+
+/****
+ * Format a protocol line and write it to a TLS connection
+ * return: 0 on success. -1 on error
+ ****/
+int tls_printf(struct tls *ctx, const char *fmt, ...) {
+	char line[MAX_LINE];
+	va_list ap;
+	int len;
+
+	va_start(ap, fmt);
+	len = vsnprintf(line, sizeof(line), fmt, ap);
+	va_end(ap);
+
+	if (len < 0 || (size_t)len >= sizeof(line))
+		return -1;
+	return tls_write_all(ctx, line, len);
+}
+
+/****
+ * Check that an object name can safely be used as a file name in a cache directory.
+ * Names containing '/' or starting with '.' are rejected so requests cannot reach
+ * outside the cache or into its bookkeeping files
+ * return: 1 if the name is valid. 0 otherwise
+ ****/
+int valid_object_name(const char *object_name) {
+	size_t len = strlen(object_name);
+
+	return len > 0 && len <= MAX_OBJECT_NAME && object_name[0] != '.' && strchr(object_name, '/') == NULL;
+}
+
+/****
+ * Parse a byte range of the form "start-end" or "start-"
+ * end: Filled with the last byte of the range, or -1 if the range is open ended
+ * return: 0 on success. -1 if the range is malformed
+ ****/
+int parse_range(const char *str, long long *start, long long *end) {
+	char *ep;
+
+	*start = strtoll(str, &ep, 10);
+	if (ep == str || *ep != '-' || *start < 0)
+		return -1;
+
+	str = ep + 1;
+	if (*str == '\0') {
+		*end = -1;
+		return 0;
+	}
+
+	*end = strtoll(str, &ep, 10);
+	if (ep == str || *ep != '\0' || *end < *start)
+		return -1;
+	return 0;
+}
+
+/****
+ * Clamp a parsed byte range to an object of the given size
+ * first, last: Filled with the first and last byte to send. last is first - 1 for an empty object
+ * return: 0 on success. -1 if the range starts past the end of the object
+ ****/
+int resolve_range(long long start, long long end, long long size, long long *first, long long *last) {
+	if (start >= size && !(start == 0 && size == 0))
+		return -1;
+
+	*first = start;
+	*last = (end == -1 || end >= size) ? size - 1 : end;
+	return 0;
+}
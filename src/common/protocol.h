@@ -0,0 +1,90 @@
+/*
+ * protocol.h - Message framing shared by the client, proxy and server
+ *
+ * Requests are single text lines terminated by '\n'. Responses start with a
+ * status line, optionally followed by a body whose length is given in the
+ * status line.
+ */
+
+#ifndef _PROTOCOL_H_
+#define _PROTOCOL_H_
+
+#include <sys/types.h>
+#include <tls.h>
+
+#define MAX_OBJECT_NAME 255
+#define MAX_LINE 1024
+#define VALIDATOR_LEN 64
+#define MAX_BATCH 64
+
+/*
+ * Requests from the client to the proxy have the form "proxy_name object_name [range]".
+ * A range is "start-end" or "start-", with inclusive byte offsets. A client may send
+ * several requests on one connection without waiting for their responses. The proxy
+ * answers them in order and closes the connection once the client closes its side
+ */
+
+/*
+ * Any request line, including the object lines of a batch, may end with a
+ * "trace=id-flags" field carrying the request ID of the client request it serves.
+ * See trace.h
+ */
+
+/* Requests from the proxy to the server */
+#define REQ_GET "GET"				/* GET object_name [range] */
+#define REQ_REVALIDATE "REVALIDATE"		/* REVALIDATE object_name validator [range] */
+#define REQ_BATCH "BATCH"			/* BATCH count, followed by count lines "object_name [validator]" */
+
+/*
+ * Requests from a proxy node to its peers. A peer answers PEER like a GET of the
+ * whole object if it has the object cached and fresh, and with NOT_FOUND otherwise.
+ * It answers DIGEST with "OK size bloom-bits-hashes" followed by the Bloom filter of
+ * the names it caches, as 32-bit words in network byte order
+ */
+#define REQ_PEER "PEER"				/* PEER object_name */
+#define REQ_DIGEST "DIGEST"			/* DIGEST */
+
+/*
+ * The objects of a batch are answered in order, each with the response a GET or
+ * REVALIDATE of the whole object would get
+ */
+
+/* Responses from the server to the proxy and from the proxy to the client */
+#define RESP_OK "OK"				/* OK size validator, followed by size bytes */
+#define RESP_PARTIAL "PARTIAL"			/* PARTIAL length validator start-end/size, followed by length bytes */
+#define RESP_NOT_MODIFIED "NOT_MODIFIED"	/* NOT_MODIFIED validator */
+#define RESP_NOT_FOUND "NOT_FOUND"		/* NOT_FOUND */
+#define RESP_BAD_RANGE "BAD_RANGE"		/* BAD_RANGE size */
+
+/*
+ * An OK or PARTIAL response from the proxy to the client may end with a "hot=k" field:
+ * the object is hot, and the client may send requests for it to any of the k proxy
+ * servers rendezvous hashing ranks highest for it, which replicate it
+ */
+#define HOT_FIELD "hot="
+
+/* Responses only sent from the proxy to the client */
+#define RESP_BLACKLISTED "BLACKLISTED"		/* BLACKLISTED */
+#define RESP_INVALID "INVALID"			/* INVALID */
+#define RESP_UNAVAILABLE "UNAVAILABLE"		/* UNAVAILABLE */
+#define RESP_BUSY "BUSY"			/* BUSY seconds, sent instead of reading the request when the proxy sheds load */
+
+/* Buffered reader over a TLS connection */
+struct tls_stream {
+	struct tls *ctx;
+	size_t pos;
+	size_t len;
+	char buf[4096];
+};
+
+void stream_init(struct tls_stream *stream, struct tls *ctx);
+int stream_wait(struct tls_stream *stream);
+int stream_read_line(struct tls_stream *stream, char *line, size_t size);
+ssize_t stream_read(struct tls_stream *stream, void *buf, size_t size);
+int tls_write_all(struct tls *ctx, const void *buf, size_t len);
+int tls_printf(struct tls *ctx, const char *fmt, ...);
+int valid_object_name(const char *object_name);
+int parse_range(const char *str, long long *start, long long *end);
+int resolve_range(long long start, long long end, long long size, long long *first, long long *last);
+
+#endif // _PROTOCOL_H_
@@ -0,0 +1,149 @@
+/*
+ * rendezvous.c - Choosing the proxy server responsible for an object and where to reach it
+ *
+ * Every proxy server name is hashed together with the object name, and the proxy
+ * server with the highest hash is responsible for the object. The proxy servers
+ * agree on the same choice when they build their blacklist filters.
+ *
+ * Each proxy server is served by a node: a proxy process listening on its own
+ * address. A node table maps every proxy server name to the host and port of its
+ * node, one "name host:port" line each. Several names may map to the same node, and
+ * without a table every name maps to one local port.
+ */
+
+#include <err.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "murmur3.h"
+#include "protocol.h"
+#include "rendezvous.h"
+
+/****
+ * Choose the proxy server responsible for an object
+ * return: Index of the proxy server in PROXY_NAMES
+ ****/
+unsigned int rendezvous_proxy(const char *object_name) {
+	unsigned int ranked[NUM_PROXIES];
+
+	rendezvous_rank(object_name, ranked);
+	return ranked[0];
+}
+
+/****
+ * Rank the proxy servers for an object, as rendezvous_proxy would choose them if the
+ * ones ahead were gone
+ * ranked: Filled with the NUM_PROXIES indices in PROXY_NAMES, highest hash first
+ * return: Nothing
+ ****/
+void rendezvous_rank(const char *object_name, unsigned int *ranked) {
+	uint32_t hashes[NUM_PROXIES];
+	unsigned int i, j;
+
+	for (i = 0; i < NUM_PROXIES; i++) {
+		char str[MAX_OBJECT_NAME + 16];
+		snprintf(str, sizeof(str), "%s%s", object_name, PROXY_NAMES[i]);
+		MurmurHash3_x86_32(str, strlen(str), 42, &hashes[i]);
+		for (j = i; j > 0 && hashes[ranked[j - 1]] < hashes[i]; j--)	// Insertion sort. Ties keep the lower index first
+			ranked[j] = ranked[j - 1];
+		ranked[j] = i;
+	}
+}
+
+/****
+ * Build the request line for a line of an object list
+ * request: Filled with "proxy_name object_name [range]\n"
+ * line: Object name, optionally followed by a range
+ * return: Index of the proxy server the request is for. -1 if the line is empty
+ ****/
+int format_request(char *request, size_t size, const char *line) {
+	char object_name[MAX_OBJECT_NAME + 1];
+	char range[64];
+	unsigned int proxy;
+
+	range[0] = '\0';
+	if (sscanf(line, "%255s %63s", object_name, range) < 1)
+		return -1;
+	proxy = rendezvous_proxy(object_name);
+	snprintf(request, size, "%s %s%s%s\n", PROXY_NAMES[proxy], object_name, range[0] ? " " : "", range);
+	return proxy;
+}
+
+static struct node *nodes;			/* Indexed like PROXY_NAMES */
+
+static void alloc_nodes() {
+	free(nodes);
+	if ((nodes = calloc(NUM_PROXIES, sizeof(*nodes))) == NULL)
+		err(1, "calloc");
+}
+
+/****
+ * Reach every proxy server through one port on this host
+ * return: Nothing
+ ****/
+void nodes_local(const char *port) {
+	unsigned int i;
+
+	alloc_nodes();
+	for (i = 0; i < NUM_PROXIES; i++) {
+		strcpy(nodes[i].host, "localhost");
+		snprintf(nodes[i].port, sizeof(nodes[i].port), "%s", port);
+	}
+}
+
+/****
+ * Read a node table. Blank lines and lines starting with '#' are skipped
+ * return: Nothing. Exits if the table is malformed or does not list every proxy server exactly once
+ ****/
+void nodes_load(const char *path) {
+	char line[MAX_LINE], name[64], address[300];
+	unsigned int i, line_number = 0;
+	char *port;
+	FILE *fp;
+
+	alloc_nodes();
+	if ((fp = fopen(path, "r")) == NULL)
+		err(1, "%s", path);
+	while (fgets(line, sizeof(line), fp) != NULL) {
+		line_number++;
+		if (sscanf(line, "%63s", name) != 1 || name[0] == '#')
+			continue;
+		for (i = 0; i < NUM_PROXIES && strcmp(name, PROXY_NAMES[i]) != 0; i++)
+			;
+		if (i == NUM_PROXIES || sscanf(line, "%*s %299s", address) != 1 || (port = strrchr(address, ':')) == NULL ||
+		    port == address || port[1] == '\0' || strlen(port + 1) >= sizeof(nodes[i].port) ||
+		    port - address >= (long)sizeof(nodes[i].host))
+			errx(1, "%s:%u: expected \"proxyname host:port\" with a known proxy server name", path, line_number);
+		if (nodes[i].host[0] != '\0')
+			errx(1, "%s:%u: proxy server %s is listed again", path, line_number, name);
+		*port = '\0';
+		strcpy(nodes[i].host, address);
+		strcpy(nodes[i].port, port + 1);
+	}
+	fclose(fp);
+	for (i = 0; i < NUM_PROXIES; i++) {
+		if (nodes[i].host[0] == '\0')
+			errx(1, "%s does not list proxy server %s", path, PROXY_NAMES[i]);
+	}
+}
+
+/****
+ * return: The node serving a proxy server
+ ****/
+const struct node *node_of(unsigned int proxy) {
+	return &nodes[proxy];
+}
+
+/****
+ * return: 1 if one node serves every proxy server. 0 otherwise
+ ****/
+int nodes_shared(void) {
+	unsigned int i;
+
+	for (i = 1; i < NUM_PROXIES; i++) {
+		if (strcmp(nodes[i].host, nodes[0].host) != 0 || strcmp(nodes[i].port, nodes[0].port) != 0)
+			return 0;
+	}
+	return 1;
+}
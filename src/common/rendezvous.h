@@ -0,0 +1,28 @@
+/*
+ * rendezvous.h - Choosing the proxy server responsible for an object and where to reach it
+ */
+
+#ifndef _RENDEZVOUS_H_
+#define _RENDEZVOUS_H_
+
+#include <stddef.h>
+
+/* Defined by the program choosing proxy servers */
+extern const unsigned int NUM_PROXIES;
+extern const char *PROXY_NAMES[];
+
+/* Address of the node serving a proxy server */
+struct node {
+	char host[256];
+	char port[16];
+};
+
+unsigned int rendezvous_proxy(const char *object_name);
+void rendezvous_rank(const char *object_name, unsigned int *ranked);
+int format_request(char *request, size_t size, const char *line);
+void nodes_local(const char *port);
+void nodes_load(const char *path);
+const struct node *node_of(unsigned int proxy);
+int nodes_shared(void);
+
+#endif // _RENDEZVOUS_H_
@@ -0,0 +1,151 @@
+/*
+ * shard.c - Listening sockets shared by shard processes pinned to cores
+ *
+ * In shard mode a program forks one process per shard before it sets up TLS or
+ * any other per-connection state. Each shard binds its own listening socket to
+ * the same port with SO_REUSEPORT, so the kernel spreads incoming connections
+ * across the shards' accept queues instead of serializing them on one socket.
+ *
+ * The process started from the command line does not serve. It supervises the
+ * shards and forks a replacement for any shard that exits, so the port never
+ * loses a share of its connections to a dead shard. A shard is killed when the
+ * supervisor dies.
+ */
+
+#define _GNU_SOURCE
+
+#include <sys/types.h>
+#include <sys/prctl.h>
+#include <sys/socket.h>
+#include <sys/wait.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+
+#include <err.h>
+#include <errno.h>
+#include <sched.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include "log.h"
+#include "shard.h"
+
+/****
+ * Pin the calling process to one online CPU
+ * return: Nothing
+ ****/
+static void pin_to_cpu(unsigned int shard) {
+	long num_cpus = sysconf(_SC_NPROCESSORS_ONLN);
+	cpu_set_t set;
+
+	if (num_cpus < 1)
+		return;
+	CPU_ZERO(&set);
+	CPU_SET(shard % num_cpus, &set);
+	if (sched_setaffinity(0, sizeof(set), &set) == -1)
+		warn("sched_setaffinity");
+}
+
+/****
+ * Fork one shard
+ * return: The shard's pid in the supervisor. 0 in the shard
+ ****/
+static pid_t fork_shard(unsigned int shard, unsigned int num_shards) {
+	pid_t pid = fork();
+
+	if (pid == -1)
+		err(1, "fork failed");
+	if (pid > 0)
+		return pid;
+	if (prctl(PR_SET_PDEATHSIG, SIGTERM) == -1)
+		warn("prctl");
+	pin_to_cpu(shard);
+	log_info("Shard %u of %u running with pid %ld", shard, num_shards, (long)getpid());
+	return 0;
+}
+
+/****
+ * Fork the shard processes and supervise them. Every shard is pinned to its own CPU,
+ * wrapping around if there are more shards than CPUs. A shard that exits is forked
+ * again, at most once a second
+ * num_shards: Number of shards. 1 runs a single unpinned process
+ * return: Index of the calling shard. Never returns in the supervisor
+ ****/
+unsigned int start_shards(unsigned int num_shards) {
+	struct timespec *started;
+	struct timespec now;
+	unsigned int shard;
+	pid_t *pids, pid;
+	int status;
+
+	if (num_shards <= 1)
+		return 0;
+
+	if ((pids = calloc(num_shards, sizeof(*pids))) == NULL || (started = calloc(num_shards, sizeof(*started))) == NULL)
+		err(1, "calloc");
+	for (shard = 0; shard < num_shards; shard++) {
+		clock_gettime(CLOCK_MONOTONIC, &started[shard]);
+		if ((pids[shard] = fork_shard(shard, num_shards)) == 0)
+			break;
+	}
+
+	while (shard == num_shards) {
+		if ((pid = waitpid(-1, &status, 0)) == -1) {
+			if (errno == EINTR)
+				continue;
+			err(1, "waitpid");
+		}
+		for (shard = 0; shard < num_shards && pids[shard] != pid; shard++)
+			;
+		if (shard == num_shards)		// Another child of the supervisor, such as a batch coordinator
+			continue;
+		if (WIFSIGNALED(status))
+			log_warn("Shard %u was killed by signal %d. Restarting it", shard, WTERMSIG(status));
+		else
+			log_warn("Shard %u exited with status %d. Restarting it", shard, WEXITSTATUS(status));
+		clock_gettime(CLOCK_MONOTONIC, &now);
+		if (now.tv_sec - started[shard].tv_sec < 1)		// Do not spin on a shard that dies as it starts
+			sleep(1);
+		clock_gettime(CLOCK_MONOTONIC, &started[shard]);
+		if ((pids[shard] = fork_shard(shard, num_shards)) != 0)
+			shard = num_shards;
+	}
+	free(pids);
+	free(started);
+	return shard;
+}
+
+/****
+ * Create a TCP socket listening on all addresses
+ * backlog: Length of the accept queue
+ * reuse_port: 1 to let every shard bind its own socket to the port
+ * return: The listening socket. Exits on error
+ ****/
+int listen_socket(u_short port, int backlog, int reuse_port) {
+	struct sockaddr_in sockname;
+	int sd, on = 1;
+
+	memset(&sockname, 0, sizeof(sockname));
+	sockname.sin_family = AF_INET;
+	sockname.sin_port = htons(port);
+	sockname.sin_addr.s_addr = htonl(INADDR_ANY);
+	sd = socket(AF_INET,SOCK_STREAM,0);
+	if (sd == -1)
+		err(1, "socket failed");
+
+	if (reuse_port && setsockopt(sd, SOL_SOCKET, SO_REUSEPORT, &on, sizeof(on)) == -1)
+		err(1, "setsockopt SO_REUSEPORT failed");
+	if (setsockopt(sd, IPPROTO_TCP, TCP_NODELAY, &on, sizeof(on)) == -1)	// Inherited by accepted connections
+		err(1, "setsockopt TCP_NODELAY failed");
+
+	if (bind(sd, (struct sockaddr *) &sockname, sizeof(sockname)) == -1)
+		err(1, "bind failed");
+
+	if (listen(sd, backlog) == -1)
+		err(1, "listen failed");
+
+	return sd;
+}
@@ -0,0 +1,15 @@
+/*
+ * shard.h - Listening sockets shared by shard processes pinned to cores
+ */
+
+#ifndef _SHARD_H_
+#define _SHARD_H_
+
+#include <sys/types.h>
+
+#define DEFAULT_BACKLOG 128
+
+unsigned int start_shards(unsigned int num_shards);
+int listen_socket(u_short port, int backlog, int reuse_port);
+
+#endif // _SHARD_H_
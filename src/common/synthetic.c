@@ -0,0 +1,178 @@
+/*
+ * synthetic.c - Deterministic generated objects for benchmarking without stored files
+ *
+ * An object is identified by a 64-bit key, a hash of its name and a seed shared by
+ * the server and the client. Its size and content are functions of the key alone:
+ * the 8 byte word at offset 8 * i is a mix of the key and i, stored little endian.
+ * Any range of an object can therefore be generated without generating what comes
+ * before it, and a client that knows the seed can check every byte it receives.
+ */
+
+#include <limits.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "protocol.h"
+#include "synthetic.h"
+
+#define PARETO_SHAPE 1.2
+
+const uint64_t WORD_STEP = 0x9e3779b97f4a7c15ULL;
+const uint64_t SIZE_SALT = 0x5bd1e9955bd1e995ULL;
+
+static uint64_t mix(uint64_t x) {
+	x ^= x >> 30;
+	x *= 0xbf58476d1ce4e5b9ULL;
+	x ^= x >> 27;
+	x *= 0x94d049bb133111ebULL;
+	return x ^ (x >> 31);
+}
+
+static uint64_t word(uint64_t key, unsigned long long index) {
+	return mix(key + (index + 1) * WORD_STEP);
+}
+
+static void store_word(unsigned char *buf, uint64_t value) {
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+	memcpy(buf, &value, 8);
+#else
+	unsigned int i;
+	for (i = 0; i < 8; i++)
+		buf[i] = value >> (8 * i);
+#endif
+}
+
+/****
+ * Parse a size distribution of the form "bytes", "uniform:min-max" or "pareto:min-max"
+ * return: 0 on success. -1 if the distribution is malformed
+ ****/
+int synthetic_parse_sizes(const char *spec, struct synthetic_sizes *sizes) {
+	const char *range = strchr(spec, ':');
+	char *ep;
+
+	if (range == NULL) {
+		sizes->distribution = SYNTHETIC_FIXED;
+		sizes->min = sizes->max = strtoull(spec, &ep, 10);
+		return *spec >= '0' && *spec <= '9' && *ep == '\0' ? 0 : -1;
+	}
+	if (strncmp(spec, "uniform:", range + 1 - spec) == 0)
+		sizes->distribution = SYNTHETIC_UNIFORM;
+	else if (strncmp(spec, "pareto:", range + 1 - spec) == 0)
+		sizes->distribution = SYNTHETIC_PARETO;
+	else
+		return -1;
+	range++;
+	if (*range < '0' || *range > '9')
+		return -1;
+	sizes->min = strtoull(range, &ep, 10);
+	if (*ep != '-' || ep[1] < '0' || ep[1] > '9')
+		return -1;
+	sizes->max = strtoull(ep + 1, &ep, 10);
+	if (*ep != '\0' || sizes->min > sizes->max || (sizes->distribution == SYNTHETIC_PARETO && sizes->min == 0))
+		return -1;
+	return 0;
+}
+
+/****
+ * return: The key an object's size and content are generated from
+ ****/
+uint64_t synthetic_key(const char *object_name, uint64_t seed) {
+	uint64_t hash = 0xcbf29ce484222325ULL;		// FNV-1a
+
+	for (; *object_name != '\0'; object_name++) {
+		hash ^= (unsigned char)*object_name;
+		hash *= 0x100000001b3ULL;
+	}
+	return mix(hash ^ mix(seed));
+}
+
+/****
+ * Get the size of an object, from its name if it ends with "@bytes" and from the
+ * distribution otherwise
+ * key: The object's key, from synthetic_key
+ * return: Size in bytes
+ ****/
+long long synthetic_size(const char *object_name, uint64_t key, const struct synthetic_sizes *sizes) {
+	const char *suffix = strrchr(object_name, SYNTHETIC_SIZE_SEPARATOR);
+	double u = (mix(key ^ SIZE_SALT) >> 11) * (1.0 / 9007199254740992.0);	// 53 random bits in [0, 1)
+	double size;
+	char *ep;
+
+	if (suffix != NULL && suffix[1] >= '0' && suffix[1] <= '9') {
+		unsigned long long named = strtoull(suffix + 1, &ep, 10);
+		if (*ep == '\0' && named <= LLONG_MAX)
+			return named;
+	}
+
+	switch (sizes->distribution) {
+	case SYNTHETIC_UNIFORM:
+		size = sizes->min + u * (sizes->max - sizes->min + 1.0);
+		break;
+	case SYNTHETIC_PARETO:			// Inverse of the bounded Pareto distribution function
+		size = sizes->min / pow(1 - u * (1 - pow((double)sizes->min / sizes->max, PARETO_SHAPE)), 1 / PARETO_SHAPE);
+		break;
+	default:
+		size = sizes->min;
+		break;
+	}
+	if (size > sizes->max)
+		size = sizes->max;
+	return size;
+}
+
+/****
+ * Build the validator of a generated object, which never changes
+ * validator: Buffer of at least VALIDATOR_LEN bytes
+ * return: Nothing
+ ****/
+void synthetic_validator(uint64_t key, long long size, char *validator) {
+	snprintf(validator, VALIDATOR_LEN, "syn-%016llx-%llx", (unsigned long long)key, (unsigned long long)size);
+}
+
+/****
+ * Generate a range of an object's content
+ * offset: Position of the first byte in the object
+ * return: Nothing
+ ****/
+void synthetic_fill(uint64_t key, unsigned long long offset, void *buf, size_t len) {
+	unsigned char *out = buf, bytes[8];
+	unsigned long long index = offset / 8;
+	size_t skip = offset % 8, n;
+
+	while (len > 0) {
+		if (skip == 0 && len >= 8) {
+			store_word(out, word(key, index++));
+			out += 8;
+			len -= 8;
+			continue;
+		}
+		store_word(bytes, word(key, index++));
+		n = 8 - skip < len ? 8 - skip : len;
+		memcpy(out, bytes + skip, n);
+		out += n;
+		len -= n;
+		skip = 0;
+	}
+}
+
+/****
+ * Check a range of an object's content
+ * offset: Position of the first byte in the object
+ * return: 0 if every byte is what synthetic_fill generates. -1 otherwise
+ ****/
+int synthetic_verify(uint64_t key, unsigned long long offset, const void *buf, size_t len) {
+	const unsigned char *in = buf;
+	unsigned char expected[4096];
+
+	while (len > 0) {
+		size_t n = len < sizeof(expected) ? len : sizeof(expected);
+		synthetic_fill(key, offset, expected, n);
+		if (memcmp(in, expected, n) != 0)
+			return -1;
+		in += n;
+		offset += n;
+		len -= n;
+	}
+	return 0;
+}
@@ -0,0 +1,40 @@
+/*
+ * synthetic.h - Deterministic generated objects for benchmarking without stored files
+ */
+
+#ifndef _SYNTHETIC_H_
+#define _SYNTHETIC_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+ * The object named "name@bytes" is bytes long. Every other object's size is drawn
+ * from a distribution by a hash of its name and the seed. Sizes are given as
+ *   bytes                 every object is that size
+ *   uniform:min-max       uniform between min and max bytes
+ *   pareto:min-max        bounded Pareto between min and max bytes: most objects are
+ *                         near min and a few are much larger, like web objects
+ */
+#define SYNTHETIC_SIZE_SEPARATOR '@'
+
+enum synthetic_distribution {
+	SYNTHETIC_FIXED,
+	SYNTHETIC_UNIFORM,
+	SYNTHETIC_PARETO
+};
+
+struct synthetic_sizes {
+	enum synthetic_distribution distribution;
+	unsigned long long min;
+	unsigned long long max;			/* Equal to min for fixed sizes */
+};
+
+int synthetic_parse_sizes(const char *spec, struct synthetic_sizes *sizes);
+uint64_t synthetic_key(const char *object_name, uint64_t seed);
+long long synthetic_size(const char *object_name, uint64_t key, const struct synthetic_sizes *sizes);
+void synthetic_validator(uint64_t key, long long size, char *validator);
+void synthetic_fill(uint64_t key, unsigned long long offset, void *buf, size_t len);
+int synthetic_verify(uint64_t key, unsigned long long offset, const void *buf, size_t len);
+
+#endif // _SYNTHETIC_H_
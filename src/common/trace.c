@@ -0,0 +1,244 @@
+/*
+ * trace.c - Request IDs carried from the client through the proxy to the server, and
+ * sampled span timings written as Chrome trace JSON
+ *
+ * A thread serving a request makes the request's trace current with trace_begin.
+ * Every stage latency_record times while it is current becomes a span, and trace_end
+ * adds a span covering the whole request. Spans are only written for sampled
+ * requests of a process started with a trace file. Stages timed before the request
+ * line is read, such as the handshake, are held back by the thread until trace_begin
+ * tells it which request they belong to.
+ *
+ * Spans are written in the Chrome trace event JSON array format, one complete event
+ * per line with a single append, so the client, the proxy and the server and all of
+ * their processes can share one trace file. The closing bracket of the array is
+ * optional in that format, so the file can be loaded while it is still written.
+ * Times are the monotonic clock of latency_clock, shifted to the wall clock so
+ * spans of different programs line up.
+ */
+
+#include <sys/types.h>
+#include <sys/file.h>
+#include <sys/syscall.h>
+
+#include <err.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include "latency.h"
+#include "trace.h"
+
+#define TRACE_PENDING_SPANS 8
+#define TRACE_EVENT_LEN 1024
+
+struct pending_span {
+	const char *name;
+	unsigned long long start;
+	unsigned long long end;
+};
+
+static int trace_fd = -1;
+static const char *trace_process;
+static long long clock_offset;			/* Wall clock minus monotonic clock in nanoseconds */
+static pid_t named_pid;				/* Process whose name was last written */
+static __thread struct trace_context current;
+static __thread struct pending_span pending[TRACE_PENDING_SPANS];
+static __thread unsigned int num_pending;
+static __thread unsigned long long random_state;
+static __thread long thread_id;
+
+/****
+ * Append spans of sampled requests to a trace file, creating it if needed
+ * path: Trace file. May be shared with other programs
+ * process_name: Name the processes of the program are shown with
+ * return: Nothing. Exits if the file cannot be opened
+ ****/
+void trace_init(const char *path, const char *process_name) {
+	struct timespec now;
+
+	if ((trace_fd = open(path, O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC, 0644)) == -1)
+		err(1, "%s", path);
+	flock(trace_fd, LOCK_EX);			// Only the first program to open the file starts the array
+	if (lseek(trace_fd, 0, SEEK_END) == 0 && write(trace_fd, "[\n", 2) != 2)
+		err(1, "%s", path);
+	flock(trace_fd, LOCK_UN);
+
+	trace_process = process_name;
+	clock_gettime(CLOCK_REALTIME, &now);
+	clock_offset = now.tv_sec * 1000000000LL + now.tv_nsec - (long long)latency_clock();
+}
+
+/****
+ * Give a request a new random ID
+ * sample_every: One in this many requests is sampled. 0 samples none
+ * return: Nothing
+ ****/
+void trace_new(struct trace_context *trace, unsigned long sample_every) {
+	unsigned long long z;
+
+	if (random_state == 0) {
+		struct timespec now;
+		clock_gettime(CLOCK_REALTIME, &now);
+		random_state = (now.tv_sec * 1000000000ULL + now.tv_nsec) ^ ((unsigned long long)getpid() << 32) ^
+		    (unsigned long long)(size_t)&random_state;
+	}
+	do {						// splitmix64
+		z = (random_state += 0x9e3779b97f4a7c15ULL);
+		z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+		z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+		z ^= z >> 31;
+	} while (z == 0);
+	trace->id = z;
+	trace->flags = sample_every != 0 && z % sample_every == 0 ? TRACE_SAMPLED : 0;
+}
+
+/****
+ * Take the trace field off the end of a request line
+ * line: Request line without its newline. The trace field and the space before it are removed
+ * trace: Set to the request's trace. Its ID is 0 if the line has no valid trace field
+ * return: 0 if the line had a trace field. -1 otherwise
+ ****/
+int trace_extract(char *line, struct trace_context *trace) {
+	char *field = strrchr(line, ' ');
+	unsigned long long id;
+	unsigned int flags;
+	int len;
+
+	trace->id = 0;
+	trace->flags = 0;
+	if (field == NULL || strncmp(field + 1, TRACE_FIELD, strlen(TRACE_FIELD)) != 0 ||
+	    sscanf(field + 1 + strlen(TRACE_FIELD), "%16llx-%2x%n", &id, &flags, &len) != 2 ||
+	    field[1 + strlen(TRACE_FIELD) + len] != '\0' || id == 0)
+		return -1;
+	trace->id = id;
+	trace->flags = flags;
+	*field = '\0';
+	return 0;
+}
+
+/****
+ * Format the trace field of a request line, with the space before it
+ * buf: Filled with " trace=id-flags", or with an empty string if the trace has no ID
+ * return: Length of the field
+ ****/
+int trace_format(const struct trace_context *trace, char *buf, size_t size) {
+	if (trace == NULL || trace->id == 0) {
+		buf[0] = '\0';
+		return 0;
+	}
+	return snprintf(buf, size, " %s%016llx-%02x", TRACE_FIELD, trace->id, trace->flags);
+}
+
+/****
+ * Make a request's trace current for the calling thread, and write the spans
+ * held back for it if it is sampled
+ * return: Nothing
+ ****/
+void trace_begin(const struct trace_context *trace) {
+	unsigned int i, count = num_pending;
+
+	current = *trace;
+	num_pending = 0;
+	for (i = 0; i < count; i++)
+		trace_span(pending[i].name, pending[i].start, pending[i].end);
+}
+
+/****
+ * return: The trace of the request the calling thread is serving. Its ID is 0 if there is none
+ ****/
+const struct trace_context *trace_current(void) {
+	return &current;
+}
+
+/****
+ * Append text to a JSON string being built, escaping what JSON requires
+ * return: New length of the event
+ ****/
+static size_t append_json(char *event, size_t len, size_t size, const char *text) {
+	for (; *text != '\0' && len + 7 < size; text++) {
+		unsigned char c = *text;
+		if (c == '"' || c == '\\')
+			len += snprintf(event + len, size - len, "\\%c", c);
+		else if (c < 0x20)
+			len += snprintf(event + len, size - len, "\\u%04x", c);
+		else
+			event[len++] = c;
+	}
+	return len;
+}
+
+/****
+ * Write one complete event
+ * detail: Object or other description added to the event's arguments. May be NULL
+ * return: Nothing
+ ****/
+static void write_event(const char *name, unsigned long long start, unsigned long long end, const char *detail) {
+	char event[TRACE_EVENT_LEN];
+	unsigned long long ts = start + clock_offset;
+	pid_t pid = getpid();
+	size_t len = 0;
+
+	if (thread_id == 0)
+		thread_id = syscall(SYS_gettid);
+	if (named_pid != pid) {				// Name each forked process the first time it writes
+		named_pid = pid;
+		thread_id = syscall(SYS_gettid);	// The forking thread's number was inherited
+		len = snprintf(event, sizeof(event), "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":%ld,\"args\":{\"name\":\"%s\"}},\n",
+		    (long)pid, trace_process);
+	}
+	len += snprintf(event + len, sizeof(event) - len, "{\"name\":\"%s\",\"cat\":\"%s\",\"ph\":\"X\",\"ts\":%llu.%03llu,"
+	    "\"dur\":%llu.%03llu,\"pid\":%ld,\"tid\":%ld,\"args\":{\"request\":\"%016llx\"", name, trace_process, ts / 1000,
+	    ts % 1000, (end - start) / 1000, (end - start) % 1000, (long)pid, thread_id, current.id);
+	if (detail != NULL) {
+		len += snprintf(event + len, sizeof(event) - len, ",\"object\":\"");
+		len = append_json(event, len, sizeof(event) - 8, detail);
+		event[len++] = '"';
+	}
+	len += snprintf(event + len, sizeof(event) - len, "}},\n");
+	if (write(trace_fd, event, len) == -1)
+		warn("write trace");
+}
+
+/****
+ * Record a span of the request the calling thread is serving. Called by
+ * latency_record for every stage. A span timed before the thread knows its request
+ * is held back until trace_begin
+ * start, end: Times from latency_clock
+ * return: Nothing
+ ****/
+void trace_span(const char *name, unsigned long long start, unsigned long long end) {
+	if (trace_fd == -1)
+		return;
+	if (current.id == 0) {
+		if (num_pending < TRACE_PENDING_SPANS)
+			pending[num_pending++] = (struct pending_span){ name, start, end };
+		return;
+	}
+	if (current.flags & TRACE_SAMPLED)
+		write_event(name, start, end, NULL);
+}
+
+/****
+ * Record a span covering the whole request and stop tracing it
+ * start: Time the request started, from latency_clock
+ * detail: Object the request was for. May be NULL
+ * return: Nothing
+ ****/
+void trace_end(const char *name, unsigned long long start, const char *detail) {
+	if (trace_fd != -1 && (current.flags & TRACE_SAMPLED))
+		write_event(name, start, latency_clock(), detail);
+	trace_clear();
+}
+
+/****
+ * Stop tracing the current request and forget the spans held back by the calling
+ * thread. Called when a thread starts on a new connection
+ * return: Nothing
+ ****/
+void trace_clear(void) {
+	current.id = 0;
+	current.flags = 0;
+	num_pending = 0;
+}
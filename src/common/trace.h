@@ -0,0 +1,36 @@
+/*
+ * trace.h - Request IDs carried from the client through the proxy to the server, and
+ * sampled span timings written as Chrome trace JSON
+ */
+
+#ifndef _TRACE_H_
+#define _TRACE_H_
+
+#include <stddef.h>
+
+/*
+ * A request line may end with the field "trace=id-flags": a 16 digit hexadecimal
+ * request ID and 2 hexadecimal digits of flags. The client generates it, the proxy
+ * forwards it on the requests it sends the server for that client request, and
+ * generates one for requests that arrive without it. Spans are only written for
+ * requests whose flags have TRACE_SAMPLED set
+ */
+#define TRACE_FIELD "trace="
+#define TRACE_SAMPLED 0x01
+
+struct trace_context {
+	unsigned long long id;			/* 0 if the request has no ID */
+	unsigned int flags;
+};
+
+void trace_init(const char *path, const char *process_name);
+void trace_new(struct trace_context *trace, unsigned long sample_every);
+int trace_extract(char *line, struct trace_context *trace);
+int trace_format(const struct trace_context *trace, char *buf, size_t size);
+void trace_begin(const struct trace_context *trace);
+const struct trace_context *trace_current(void);
+void trace_span(const char *name, unsigned long long start, unsigned long long end);
+void trace_end(const char *name, unsigned long long start, const char *detail);
+void trace_clear(void);
+
+#endif // _TRACE_H_
@@ -0,0 +1,80 @@
+/*
+ * zipf.c - Uniform and Zipf distributed keys over a keyspace
+ *
+ * Key k (counting from 0) is drawn with probability proportional to 1 / (k + 1)^s.
+ * An exponent of 0 gives every key the same probability. The cumulative
+ * distribution is computed once, so drawing a key is a binary search. Callers keep
+ * their own random state, so threads draw keys without sharing anything.
+ */
+
+#include <err.h>
+#include <math.h>
+#include <stdlib.h>
+#include "zipf.h"
+
+/****
+ * Compute the distribution of a keyspace
+ * num_keys: Size of the keyspace. At least 1
+ * exponent: Skew of the distribution. 0 for uniform
+ * return: Nothing
+ ****/
+void zipf_init(struct zipf *zipf, unsigned int num_keys, double exponent) {
+	double total = 0;
+	unsigned int k;
+
+	zipf->num_keys = num_keys;
+	if (exponent == 0) {
+		zipf->cdf = NULL;
+		return;
+	}
+	if ((zipf->cdf = malloc(num_keys * sizeof(*zipf->cdf))) == NULL)
+		err(1, "malloc");
+	for (k = 0; k < num_keys; k++) {
+		total += pow(k + 1, -exponent);
+		zipf->cdf[k] = total;
+	}
+	for (k = 0; k < num_keys; k++)
+		zipf->cdf[k] /= total;
+}
+
+void zipf_free(struct zipf *zipf) {
+	free(zipf->cdf);
+	zipf->cdf = NULL;
+}
+
+/****
+ * Advance a xorshift64* generator
+ * state: Generator state. Must not be 0
+ * return: The next 64 bit random number
+ ****/
+uint64_t random_next(uint64_t *state) {
+	uint64_t x = *state;
+	x ^= x >> 12;
+	x ^= x << 25;
+	x ^= x >> 27;
+	*state = x;
+	return x * 0x2545F4914F6CDD1DULL;
+}
+
+/****
+ * Draw a key
+ * state: Random state of the calling thread
+ * return: Rank of the key, from 0 (most popular) to num_keys - 1
+ ****/
+unsigned int zipf_next(const struct zipf *zipf, uint64_t *state) {
+	uint64_t r = random_next(state);
+
+	if (zipf->cdf == NULL)
+		return r % zipf->num_keys;
+
+	double u = (r >> 11) * (1.0 / 9007199254740992.0);	// 53 random bits in [0, 1)
+	unsigned int low = 0, high = zipf->num_keys - 1;
+	while (low < high) {
+		unsigned int mid = low + (high - low) / 2;
+		if (zipf->cdf[mid] > u)
+			high = mid;
+		else
+			low = mid + 1;
+	}
+	return low;
+}
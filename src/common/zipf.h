@@ -0,0 +1,20 @@
+/*
+ * zipf.h - Uniform and Zipf distributed keys over a keyspace
+ */
+
+#ifndef _ZIPF_H_
+#define _ZIPF_H_
+
+#include <stdint.h>
+
+struct zipf {
+	unsigned int num_keys;
+	double *cdf;				/* Probability of drawing a key at or below each rank */
+};
+
+void zipf_init(struct zipf *zipf, unsigned int num_keys, double exponent);
+void zipf_free(struct zipf *zipf);
+unsigned int zipf_next(const struct zipf *zipf, uint64_t *state);
+uint64_t random_next(uint64_t *state);
+
+#endif // _ZIPF_H_
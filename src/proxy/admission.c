@@ -0,0 +1,384 @@
+/*
+ * admission.c - Admission control and load shedding for forked connections
+ *
+ * The accepting process only forks a child for a connection while fewer than
+ * max_in_flight children are serving. Other connections wait in a bounded FIFO
+ * until a child exits. A connection is shed if the queue is full, if it waited
+ * longer than queue_timeout, or if its client address ran out of tokens in its
+ * token bucket.
+ *
+ * Shed connections are passed to a separate shedding process, so the accepting
+ * process never does a TLS handshake itself. The shedder completes the handshake,
+ * answers "BUSY seconds" with the number of seconds the client should wait before
+ * retrying, and closes the connection.
+ *
+ * Outcomes are counted in the shared COUNTER_ADMISSION metric, which adds up the
+ * accepting processes of every shard, and in a per-process summary that is logged.
+ */
+
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <sys/uio.h>
+
+#include <err.h>
+#include <errno.h>
+#include <signal.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include "admission.h"
+#include "counters.h"
+#include "log.h"
+#include "murmur3.h"
+#include "protocol.h"
+
+const unsigned int NUM_CLIENT_BUCKETS = 4096;
+const int SHED_IO_TIMEOUT_MS = 1000;
+const unsigned int REPORT_INTERVAL = 10;
+
+struct waiting {
+	int fd;
+	struct timespec arrived;
+};
+
+struct token_bucket {
+	struct in_addr addr;
+	double tokens;
+	struct timespec refilled;
+};
+
+struct admission_counters {
+	unsigned long long admitted;		/* Connections started without waiting */
+	unsigned long long queued;		/* Connections that had to wait for a slot */
+	unsigned long long dequeued;		/* Waiting connections that got a slot */
+	unsigned long long shed_queue_full;	/* Connections rejected because the wait queue was full */
+	unsigned long long shed_deadline;	/* Waiting connections rejected when their deadline passed */
+	unsigned long long shed_client_rate;	/* Connections rejected by their client's token bucket */
+	unsigned long long queue_time_ms;	/* Total time dequeued connections waited */
+	unsigned long long max_queue_time_ms;	/* Longest time a dequeued connection waited */
+};
+
+static struct admission_config config;
+static struct admission_counters counters;
+static struct admission_counters reported;
+static time_t last_report;
+
+static pid_t *in_flight;			/* Children serving connections. 0 marks a free slot */
+static unsigned int num_in_flight;
+static unsigned int in_flight_capacity;
+
+static struct waiting *queue;
+static unsigned int queue_head;
+static unsigned int queue_count;
+
+static struct token_bucket *client_buckets;
+static int shed_fd = -1;			/* Socket the shedding process receives connections on */
+
+static double elapsed_ms(const struct timespec *start, const struct timespec *end) {
+	return (end->tv_sec - start->tv_sec) * 1000.0 + (end->tv_nsec - start->tv_nsec) / 1000000.0;
+}
+
+/****
+ * Answer shed connections with BUSY until the accepting process goes away
+ * ctx: Configured TLS server context
+ * return: Never returns
+ ****/
+static void run_shedder(int fd, struct tls *ctx) {
+	signal(SIGPIPE, SIG_IGN);
+
+	for (;;) {
+		char control[CMSG_SPACE(sizeof(int))];
+		unsigned int retry_after;
+		struct iovec iov = { &retry_after, sizeof(retry_after) };
+		struct msghdr msg;
+		struct cmsghdr *cmsg;
+		struct tls *cctx = NULL;
+		int clientsd;
+
+		memset(&msg, 0, sizeof(msg));
+		msg.msg_iov = &iov;
+		msg.msg_iovlen = 1;
+		msg.msg_control = control;
+		msg.msg_controllen = sizeof(control);
+		ssize_t n = recvmsg(fd, &msg, 0);
+		if (n == 0)
+			exit(0);
+		if (n == -1 && errno == EINTR)
+			continue;
+		if (n == -1)
+			err(1, "recvmsg");
+		if (n != sizeof(retry_after) || (cmsg = CMSG_FIRSTHDR(&msg)) == NULL || cmsg->cmsg_type != SCM_RIGHTS)
+			continue;
+		memcpy(&clientsd, CMSG_DATA(cmsg), sizeof(clientsd));
+
+		struct timeval tv = { SHED_IO_TIMEOUT_MS / 1000, (SHED_IO_TIMEOUT_MS % 1000) * 1000 };
+		setsockopt(clientsd, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+		setsockopt(clientsd, SOL_SOCKET, SO_SNDTIMEO, &tv, sizeof(tv));
+
+		if (tls_accept_socket(ctx, &cctx, clientsd) == 0 && tls_printf(cctx, "%s %u\n", RESP_BUSY, retry_after) == 0) {
+			struct tls_stream stream;
+			char request[MAX_LINE];
+			stream_init(&stream, cctx);
+			stream_read_line(&stream, request, sizeof(request));	// Let the client finish sending before closing
+			tls_close(cctx);
+		}
+		tls_free(cctx);
+		close(clientsd);
+	}
+}
+
+/****
+ * Reject a connection with a retry-after hint. If the shedder cannot take it, the
+ * connection is simply closed. Once the shedder is gone, every shed connection is
+ * closed
+ * return: Nothing
+ ****/
+static void shed(int fd, unsigned int retry_after) {
+	char control[CMSG_SPACE(sizeof(int))];
+	struct iovec iov = { &retry_after, sizeof(retry_after) };
+	struct msghdr msg;
+	struct cmsghdr *cmsg;
+
+	memset(&msg, 0, sizeof(msg));
+	memset(control, 0, sizeof(control));
+	msg.msg_iov = &iov;
+	msg.msg_iovlen = 1;
+	msg.msg_control = control;
+	msg.msg_controllen = sizeof(control);
+	cmsg = CMSG_FIRSTHDR(&msg);
+	cmsg->cmsg_level = SOL_SOCKET;
+	cmsg->cmsg_type = SCM_RIGHTS;
+	cmsg->cmsg_len = CMSG_LEN(sizeof(int));
+	memcpy(CMSG_DATA(cmsg), &fd, sizeof(fd));
+
+	if (shed_fd != -1 && sendmsg(shed_fd, &msg, MSG_DONTWAIT | MSG_NOSIGNAL) == -1 && errno != EAGAIN &&
+	    errno != EWOULDBLOCK && errno != EINTR) {
+		log_warn("Shedding process is gone (%s). Closing shed connections without an answer", strerror(errno));
+		close(shed_fd);
+		shed_fd = -1;
+	}
+	close(fd);
+}
+
+/****
+ * Estimate how long a rejected client should wait before retrying
+ * return: Seconds to wait. At least 1
+ ****/
+static unsigned int retry_after() {
+	return config.queue_timeout < 1000 ? 1 : (config.queue_timeout + 999) / 1000;
+}
+
+/****
+ * Take a token from a client address's bucket, refilling it for the time since it was last used
+ * return: 1 if the client may connect. 0 if it is over its rate
+ ****/
+static int take_token(struct in_addr addr) {
+	struct token_bucket *bucket;
+	struct timespec now;
+	uint32_t hash;
+
+	MurmurHash3_x86_32(&addr, sizeof(addr), 0, &hash);
+	bucket = &client_buckets[hash % NUM_CLIENT_BUCKETS];
+	clock_gettime(CLOCK_MONOTONIC, &now);
+
+	if (bucket->addr.s_addr != addr.s_addr || bucket->refilled.tv_sec == 0) {
+		bucket->addr = addr;			// New client, or one that replaced an idle client with the same hash
+		bucket->tokens = config.client_burst;
+	} else {
+		bucket->tokens += elapsed_ms(&bucket->refilled, &now) / 1000.0 * config.client_rate;
+		if (bucket->tokens > config.client_burst)
+			bucket->tokens = config.client_burst;
+	}
+	bucket->refilled = now;
+
+	if (bucket->tokens < 1)
+		return 0;
+	bucket->tokens--;
+	return 1;
+}
+
+/****
+ * Set up admission control and start the shedding process
+ * ctx: Configured TLS server context used to answer shed connections
+ * listen_sd: Listening socket, closed in the shedding process
+ * return: Nothing
+ ****/
+void admission_init(const struct admission_config *admission_config, struct tls *ctx, int listen_sd) {
+	int fds[2];
+
+	config = *admission_config;
+	in_flight_capacity = config.max_in_flight ? config.max_in_flight : 64;
+	if ((in_flight = calloc(in_flight_capacity, sizeof(*in_flight))) == NULL ||
+	    (queue = calloc(config.max_queue + 1, sizeof(*queue))) == NULL ||
+	    (client_buckets = calloc(NUM_CLIENT_BUCKETS, sizeof(*client_buckets))) == NULL)
+		err(1, "calloc");
+	last_report = time(NULL);
+
+	if (config.max_in_flight == 0 && config.client_rate == 0)
+		return;					// Nothing is ever shed
+	if (socketpair(AF_UNIX, SOCK_SEQPACKET, 0, fds) == -1)
+		err(1, "socketpair");
+	pid_t pid = fork();
+	if (pid == -1)
+		err(1, "fork failed");
+	if (pid == 0) {
+		close(listen_sd);
+		close(fds[0]);
+		run_shedder(fds[1], ctx);
+	}
+	close(fds[1]);
+	shed_fd = fds[0];
+
+	if (config.max_in_flight)
+		log_info("Admitting %u connections at once, queueing %u for up to %u ms", config.max_in_flight,
+		    config.max_queue, config.queue_timeout);
+	if (config.client_rate > 0)
+		log_info("Limiting each client address to %u connections per second, bursts of %u", config.client_rate,
+		    config.client_burst);
+}
+
+/****
+ * Decide what to do with a newly accepted connection
+ * fd: The connection. Queued or shed unless it may start now
+ * addr: Client address
+ * return: 1 if a child should be started for the connection now. 0 if it was queued or shed
+ ****/
+int admission_offer(int fd, struct in_addr addr) {
+	if (config.client_rate > 0 && !take_token(addr)) {
+		counters.shed_client_rate++;
+		metrics_add(COUNTER_ADMISSION, ADMISSION_SHED_CLIENT_RATE, 1);
+		shed(fd, 1);
+		return 0;
+	}
+
+	if (config.max_in_flight == 0 || (num_in_flight < config.max_in_flight && queue_count == 0)) {
+		counters.admitted++;
+		metrics_add(COUNTER_ADMISSION, ADMISSION_ADMITTED, 1);
+		return 1;
+	}
+
+	if (queue_count == config.max_queue) {
+		counters.shed_queue_full++;
+		metrics_add(COUNTER_ADMISSION, ADMISSION_SHED_QUEUE_FULL, 1);
+		shed(fd, retry_after());
+		return 0;
+	}
+
+	struct waiting *waiting = &queue[(queue_head + queue_count++) % (config.max_queue + 1)];
+	waiting->fd = fd;
+	clock_gettime(CLOCK_MONOTONIC, &waiting->arrived);
+	counters.queued++;
+	metrics_add(COUNTER_ADMISSION, ADMISSION_QUEUED, 1);
+	return 0;
+}
+
+/****
+ * Take the next waiting connection if a slot is free. Connections that waited
+ * past their deadline are shed on the way
+ * return: A connection to start a child for. -1 if none can start now
+ ****/
+int admission_next() {
+	struct timespec now;
+
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	while (queue_count > 0) {
+		struct waiting *waiting = &queue[queue_head];
+		double waited = elapsed_ms(&waiting->arrived, &now);
+
+		if (waited < config.queue_timeout && num_in_flight >= config.max_in_flight)
+			return -1;
+
+		queue_head = (queue_head + 1) % (config.max_queue + 1);
+		queue_count--;
+		if (waited >= config.queue_timeout) {
+			counters.shed_deadline++;
+			metrics_add(COUNTER_ADMISSION, ADMISSION_SHED_DEADLINE, 1);
+			shed(waiting->fd, retry_after());
+			continue;
+		}
+
+		counters.dequeued++;
+		metrics_add(COUNTER_ADMISSION, ADMISSION_DEQUEUED, 1);
+		counters.queue_time_ms += waited;
+		if (waited > counters.max_queue_time_ms)
+			counters.max_queue_time_ms = waited;
+		return waiting->fd;
+	}
+	return -1;
+}
+
+/****
+ * Record a child started for a connection
+ * return: Nothing
+ ****/
+void admission_started(pid_t pid) {
+	unsigned int i;
+
+	if (num_in_flight == in_flight_capacity) {		// Only happens without a limit
+		in_flight_capacity *= 2;
+		if ((in_flight = realloc(in_flight, in_flight_capacity * sizeof(*in_flight))) == NULL)
+			err(1, "realloc");
+		memset(in_flight + num_in_flight, 0, (in_flight_capacity - num_in_flight) * sizeof(*in_flight));
+	}
+	for (i = 0; in_flight[i] != 0; i++)
+		;
+	in_flight[i] = pid;
+	num_in_flight++;
+}
+
+/****
+ * Record that a child exited. Children that were not serving a connection are ignored
+ * return: Nothing
+ ****/
+void admission_finished(pid_t pid) {
+	unsigned int i;
+
+	for (i = 0; i < in_flight_capacity; i++) {
+		if (in_flight[i] == pid) {
+			in_flight[i] = 0;
+			num_in_flight--;
+			return;
+		}
+	}
+}
+
+/****
+ * Get how long the accepting process may wait for a connection before the oldest
+ * waiting connection passes its deadline
+ * return: Milliseconds to wait. -1 if no connection is waiting
+ ****/
+int admission_timeout() {
+	struct timespec now;
+
+	if (queue_count == 0)
+		return -1;
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	double left = config.queue_timeout - elapsed_ms(&queue[queue_head].arrived, &now);
+	return left > 0 ? (int)left + 1 : 0;
+}
+
+/****
+ * Print the counters every REPORT_INTERVAL seconds if anything was queued or shed
+ * return: Nothing
+ ****/
+void admission_report() {
+	time_t now = time(NULL);
+
+	if (now - last_report < (time_t)REPORT_INTERVAL)
+		return;
+	last_report = now;
+	if (counters.queued == reported.queued && counters.shed_client_rate == reported.shed_client_rate &&
+	    counters.shed_queue_full == reported.shed_queue_full)
+		return;
+	reported = counters;
+
+	log_info("Admission: %llu admitted, %llu queued, %llu dequeued, mean queue time %.1f ms, max %llu ms, "
+	    "shed %llu (queue full), %llu (deadline), %llu (client rate), %u in flight, %u waiting",
+	    counters.admitted, counters.queued, counters.dequeued,
+	    counters.dequeued ? (double)counters.queue_time_ms / counters.dequeued : 0.0, counters.max_queue_time_ms,
+	    counters.shed_queue_full, counters.shed_deadline, counters.shed_client_rate, num_in_flight, queue_count);
+}
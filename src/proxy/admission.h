@@ -0,0 +1,28 @@
+/*
+ * admission.h - Admission control and load shedding for forked connections
+ */
+
+#ifndef _ADMISSION_H_
+#define _ADMISSION_H_
+
+#include <sys/types.h>
+#include <netinet/in.h>
+#include <tls.h>
+
+struct admission_config {
+	unsigned int max_in_flight;		/* Connections served at once. 0 for no limit */
+	unsigned int max_queue;			/* Connections waiting for a slot */
+	unsigned int queue_timeout;		/* Milliseconds a connection may wait before it is shed */
+	unsigned int client_rate;		/* Connections per second allowed per client address. 0 for no limit */
+	unsigned int client_burst;		/* Connections a client address may make at once */
+};
+
+void admission_init(const struct admission_config *config, struct tls *ctx, int listen_sd);
+int admission_offer(int fd, struct in_addr addr);
+int admission_next();
+void admission_started(pid_t pid);
+void admission_finished(pid_t pid);
+int admission_timeout();
+void admission_report();
+
+#endif // _ADMISSION_H_
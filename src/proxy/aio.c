@@ -0,0 +1,485 @@
+/*
+ * aio.c - Asynchronous disk I/O for proxy cache reads and fills
+ *
+ * Each context owns a fixed set of I/O buffers. A buffer has at most one read or
+ * write in flight and completions are reported by buffer index, so callers can
+ * keep several reads ahead of the data they are sending to a client, or keep
+ * writing a fill to disk while the next part arrives from the server.
+ *
+ * Operations are queued with aio_read()/aio_write() and handed to the kernel in
+ * one batch by aio_submit(). With io_uring the buffers are registered with the
+ * ring and the fixed-buffer opcodes are used, so the kernel does not have to map
+ * the pages on every operation. Where io_uring is unavailable (old kernels,
+ * seccomp filters) a small thread pool runs the same operations with
+ * pread()/pwrite().
+ */
+
+#include <sys/types.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+
+#include <linux/io_uring.h>
+
+#include <err.h>
+#include <errno.h>
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "aio.h"
+
+#define AIO_MAX_THREADS 4
+
+enum aio_op {
+	AIO_OP_READ,
+	AIO_OP_WRITE
+};
+
+struct aio_request {
+	enum aio_op op;
+	int fd;
+	size_t len;
+	off_t offset;
+	ssize_t result;
+};
+
+struct uring {
+	int fd;
+	int fixed_buffers;			/* 1 if the buffers are registered with the ring */
+	unsigned int *sq_head, *sq_tail, *sq_mask, *sq_entries, *sq_array;
+	unsigned int *cq_head, *cq_tail, *cq_mask;
+	struct io_uring_sqe *sqes;
+	struct io_uring_cqe *cqes;
+	void *sq_ring, *cq_ring;
+	size_t sq_ring_size, cq_ring_size, sqes_size;
+	unsigned int queued;			/* Entries added to the submission queue but not submitted */
+};
+
+struct thread_pool {
+	pthread_t threads[AIO_MAX_THREADS];
+	unsigned int num_threads;
+	pthread_mutex_t lock;
+	pthread_cond_t work;			/* Signalled when requests are submitted */
+	pthread_cond_t done;			/* Signalled when a request completes */
+	unsigned int *staged, num_staged;	/* Queued requests not yet visible to the threads */
+	unsigned int *submitted, num_submitted;
+	unsigned int *completed, num_completed;
+	int stop;
+};
+
+struct aio_ctx {
+	enum aio_backend backend;
+	unsigned int num_buffers;
+	size_t buffer_size;
+	char *buffers;
+	unsigned int in_flight;
+	struct aio_request *requests;		/* One per buffer */
+	struct uring ring;
+	struct thread_pool pool;
+};
+
+/**** io_uring backend ****/
+
+static int uring_setup(unsigned int entries, struct io_uring_params *p) {
+	return syscall(__NR_io_uring_setup, entries, p);
+}
+
+static int uring_enter(int fd, unsigned int to_submit, unsigned int min_complete, unsigned int flags) {
+	return syscall(__NR_io_uring_enter, fd, to_submit, min_complete, flags, NULL, 0);
+}
+
+static int uring_register(int fd, unsigned int opcode, void *arg, unsigned int nr_args) {
+	return syscall(__NR_io_uring_register, fd, opcode, arg, nr_args);
+}
+
+/****
+ * Create an io_uring and map its submission and completion queues
+ * return: 0 on success. -1 if io_uring is unavailable
+ ****/
+static int uring_open(struct aio_ctx *aio) {
+	struct uring *ring = &aio->ring;
+	struct io_uring_params p;
+
+	memset(&p, 0, sizeof(p));
+	if ((ring->fd = uring_setup(aio->num_buffers, &p)) == -1)
+		return -1;
+
+	ring->sq_ring_size = p.sq_off.array + p.sq_entries * sizeof(unsigned int);
+	ring->cq_ring_size = p.cq_off.cqes + p.cq_entries * sizeof(struct io_uring_cqe);
+	if (p.features & IORING_FEAT_SINGLE_MMAP) {
+		if (ring->cq_ring_size > ring->sq_ring_size)
+			ring->sq_ring_size = ring->cq_ring_size;
+		ring->cq_ring_size = ring->sq_ring_size;
+	}
+
+	ring->sq_ring = mmap(NULL, ring->sq_ring_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring->fd, IORING_OFF_SQ_RING);
+	if (ring->sq_ring == MAP_FAILED)
+		goto fail;
+	if (p.features & IORING_FEAT_SINGLE_MMAP) {
+		ring->cq_ring = ring->sq_ring;
+	} else {
+		ring->cq_ring = mmap(NULL, ring->cq_ring_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring->fd, IORING_OFF_CQ_RING);
+		if (ring->cq_ring == MAP_FAILED)
+			goto fail_sq;
+	}
+
+	ring->sqes_size = p.sq_entries * sizeof(struct io_uring_sqe);
+	ring->sqes = mmap(NULL, ring->sqes_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring->fd, IORING_OFF_SQES);
+	if (ring->sqes == MAP_FAILED)
+		goto fail_cq;
+
+	ring->sq_head = (unsigned int *)((char *)ring->sq_ring + p.sq_off.head);
+	ring->sq_tail = (unsigned int *)((char *)ring->sq_ring + p.sq_off.tail);
+	ring->sq_mask = (unsigned int *)((char *)ring->sq_ring + p.sq_off.ring_mask);
+	ring->sq_entries = (unsigned int *)((char *)ring->sq_ring + p.sq_off.ring_entries);
+	ring->sq_array = (unsigned int *)((char *)ring->sq_ring + p.sq_off.array);
+	ring->cq_head = (unsigned int *)((char *)ring->cq_ring + p.cq_off.head);
+	ring->cq_tail = (unsigned int *)((char *)ring->cq_ring + p.cq_off.tail);
+	ring->cq_mask = (unsigned int *)((char *)ring->cq_ring + p.cq_off.ring_mask);
+	ring->cqes = (struct io_uring_cqe *)((char *)ring->cq_ring + p.cq_off.cqes);
+
+	/* Registering the buffers can fail under a low RLIMIT_MEMLOCK. Plain reads and writes still work */
+	struct iovec *iov = calloc(aio->num_buffers, sizeof(*iov));
+	if (iov == NULL)
+		err(1, "calloc");
+	unsigned int i;
+	for (i = 0; i < aio->num_buffers; i++) {
+		iov[i].iov_base = aio->buffers + i * aio->buffer_size;
+		iov[i].iov_len = aio->buffer_size;
+	}
+	ring->fixed_buffers = uring_register(ring->fd, IORING_REGISTER_BUFFERS, iov, aio->num_buffers) == 0;
+	free(iov);
+
+	return 0;
+
+fail_cq:
+	if (ring->cq_ring != ring->sq_ring)
+		munmap(ring->cq_ring, ring->cq_ring_size);
+fail_sq:
+	munmap(ring->sq_ring, ring->sq_ring_size);
+fail:
+	close(ring->fd);
+	return -1;
+}
+
+static void uring_close(struct aio_ctx *aio) {
+	struct uring *ring = &aio->ring;
+
+	munmap(ring->sqes, ring->sqes_size);
+	if (ring->cq_ring != ring->sq_ring)
+		munmap(ring->cq_ring, ring->cq_ring_size);
+	munmap(ring->sq_ring, ring->sq_ring_size);
+	close(ring->fd);
+}
+
+static int uring_submit(struct aio_ctx *aio) {
+	struct uring *ring = &aio->ring;
+
+	while (ring->queued > 0) {
+		int ret = uring_enter(ring->fd, ring->queued, 0, 0);
+		if (ret == -1) {
+			if (errno == EINTR)
+				continue;
+			return -1;
+		}
+		ring->queued -= ret;
+	}
+	return 0;
+}
+
+static int uring_queue(struct aio_ctx *aio, unsigned int buf) {
+	struct uring *ring = &aio->ring;
+	struct aio_request *req = &aio->requests[buf];
+	unsigned int tail = *ring->sq_tail;
+
+	if (tail - __atomic_load_n(ring->sq_head, __ATOMIC_ACQUIRE) >= *ring->sq_entries && uring_submit(aio) == -1)
+		return -1;
+
+	unsigned int index = tail & *ring->sq_mask;
+	struct io_uring_sqe *sqe = &ring->sqes[index];
+	memset(sqe, 0, sizeof(*sqe));
+	if (ring->fixed_buffers) {
+		sqe->opcode = req->op == AIO_OP_READ ? IORING_OP_READ_FIXED : IORING_OP_WRITE_FIXED;
+		sqe->buf_index = buf;
+	} else {
+		sqe->opcode = req->op == AIO_OP_READ ? IORING_OP_READ : IORING_OP_WRITE;
+	}
+	sqe->fd = req->fd;
+	sqe->addr = (unsigned long)(aio->buffers + buf * aio->buffer_size);
+	sqe->len = req->len;
+	sqe->off = req->offset;
+	sqe->user_data = buf;
+
+	ring->sq_array[index] = index;
+	__atomic_store_n(ring->sq_tail, tail + 1, __ATOMIC_RELEASE);
+	ring->queued++;
+	return 0;
+}
+
+static int uring_wait(struct aio_ctx *aio, unsigned int *buf, ssize_t *result) {
+	struct uring *ring = &aio->ring;
+
+	for (;;) {
+		unsigned int head = *ring->cq_head;
+		if (head != __atomic_load_n(ring->cq_tail, __ATOMIC_ACQUIRE)) {
+			struct io_uring_cqe *cqe = &ring->cqes[head & *ring->cq_mask];
+			*buf = cqe->user_data;
+			*result = cqe->res;
+			__atomic_store_n(ring->cq_head, head + 1, __ATOMIC_RELEASE);
+			return 0;
+		}
+
+		int ret = uring_enter(ring->fd, ring->queued, 1, IORING_ENTER_GETEVENTS);
+		if (ret == -1) {
+			if (errno == EINTR)
+				continue;
+			return -1;
+		}
+		ring->queued -= ret;
+	}
+}
+
+/**** Thread pool backend ****/
+
+static void *pool_thread(void *arg) {
+	struct aio_ctx *aio = arg;
+	struct thread_pool *pool = &aio->pool;
+
+	pthread_mutex_lock(&pool->lock);
+	for (;;) {
+		while (pool->num_submitted == 0 && !pool->stop)
+			pthread_cond_wait(&pool->work, &pool->lock);
+		if (pool->stop)
+			break;
+
+		unsigned int buf = pool->submitted[--pool->num_submitted];
+		struct aio_request *req = &aio->requests[buf];
+		char *data = aio->buffers + buf * aio->buffer_size;
+		pthread_mutex_unlock(&pool->lock);
+
+		if (req->op == AIO_OP_READ)
+			req->result = pread(req->fd, data, req->len, req->offset);
+		else
+			req->result = pwrite(req->fd, data, req->len, req->offset);
+		if (req->result == -1)
+			req->result = -errno;
+
+		pthread_mutex_lock(&pool->lock);
+		pool->completed[pool->num_completed++] = buf;
+		pthread_cond_signal(&pool->done);
+	}
+	pthread_mutex_unlock(&pool->lock);
+
+	return NULL;
+}
+
+static int pool_open(struct aio_ctx *aio) {
+	struct thread_pool *pool = &aio->pool;
+	unsigned int i;
+
+	if ((pool->staged = calloc(aio->num_buffers, sizeof(unsigned int))) == NULL ||
+	    (pool->submitted = calloc(aio->num_buffers, sizeof(unsigned int))) == NULL ||
+	    (pool->completed = calloc(aio->num_buffers, sizeof(unsigned int))) == NULL)
+		err(1, "calloc");
+	pthread_mutex_init(&pool->lock, NULL);
+	pthread_cond_init(&pool->work, NULL);
+	pthread_cond_init(&pool->done, NULL);
+
+	pool->num_threads = aio->num_buffers < AIO_MAX_THREADS ? aio->num_buffers : AIO_MAX_THREADS;
+	for (i = 0; i < pool->num_threads; i++) {
+		if (pthread_create(&pool->threads[i], NULL, pool_thread, aio) != 0)
+			err(1, "pthread_create");
+	}
+	return 0;
+}
+
+static void pool_close(struct aio_ctx *aio) {
+	struct thread_pool *pool = &aio->pool;
+	unsigned int i;
+
+	pthread_mutex_lock(&pool->lock);
+	pool->stop = 1;
+	pthread_cond_broadcast(&pool->work);
+	pthread_mutex_unlock(&pool->lock);
+	for (i = 0; i < pool->num_threads; i++)
+		pthread_join(pool->threads[i], NULL);
+
+	pthread_mutex_destroy(&pool->lock);
+	pthread_cond_destroy(&pool->work);
+	pthread_cond_destroy(&pool->done);
+	free(pool->staged);
+	free(pool->submitted);
+	free(pool->completed);
+}
+
+static int pool_submit(struct aio_ctx *aio) {
+	struct thread_pool *pool = &aio->pool;
+
+	if (pool->num_staged == 0)
+		return 0;
+
+	pthread_mutex_lock(&pool->lock);
+	while (pool->num_staged > 0)
+		pool->submitted[pool->num_submitted++] = pool->staged[--pool->num_staged];
+	pthread_cond_broadcast(&pool->work);
+	pthread_mutex_unlock(&pool->lock);
+	return 0;
+}
+
+static int pool_wait(struct aio_ctx *aio, unsigned int *buf, ssize_t *result) {
+	struct thread_pool *pool = &aio->pool;
+
+	pool_submit(aio);
+	pthread_mutex_lock(&pool->lock);
+	while (pool->num_completed == 0)
+		pthread_cond_wait(&pool->done, &pool->lock);
+	*buf = pool->completed[--pool->num_completed];
+	pthread_mutex_unlock(&pool->lock);
+
+	*result = aio->requests[*buf].result;
+	return 0;
+}
+
+/**** End thread pool backend ****/
+
+/****
+ * Create an I/O context
+ * backend: Preferred backend. AIO_URING falls back to AIO_THREADS if io_uring is unavailable
+ * num_buffers: Number of I/O buffers, which is also the maximum number of operations in flight
+ * buffer_size: Size of each buffer in bytes
+ * return: The new context
+ ****/
+struct aio_ctx *aio_create(enum aio_backend backend, unsigned int num_buffers, size_t buffer_size) {
+	struct aio_ctx *aio;
+
+	if ((aio = calloc(1, sizeof(*aio))) == NULL)
+		err(1, "calloc");
+	aio->num_buffers = num_buffers;
+	aio->buffer_size = buffer_size;
+	if (posix_memalign((void **)&aio->buffers, 4096, num_buffers * buffer_size) != 0)
+		err(1, "posix_memalign");
+	if ((aio->requests = calloc(num_buffers, sizeof(*aio->requests))) == NULL)
+		err(1, "calloc");
+
+	if (backend == AIO_URING && uring_open(aio) == 0) {
+		aio->backend = AIO_URING;
+	} else {
+		aio->backend = AIO_THREADS;
+		pool_open(aio);
+	}
+
+	return aio;
+}
+
+/****
+ * Wait for all operations in flight, then release the context
+ * return: Nothing
+ ****/
+void aio_destroy(struct aio_ctx *aio) {
+	aio_drain(aio);
+	if (aio->backend == AIO_URING)
+		uring_close(aio);
+	else
+		pool_close(aio);
+
+	free(aio->requests);
+	free(aio->buffers);
+	free(aio);
+}
+
+enum aio_backend aio_get_backend(const struct aio_ctx *aio) {
+	return aio->backend;
+}
+
+unsigned int aio_num_buffers(const struct aio_ctx *aio) {
+	return aio->num_buffers;
+}
+
+size_t aio_buffer_size(const struct aio_ctx *aio) {
+	return aio->buffer_size;
+}
+
+char *aio_buffer(struct aio_ctx *aio, unsigned int buf) {
+	return aio->buffers + buf * aio->buffer_size;
+}
+
+/****
+ * Queue an operation on a buffer. It is started by the next aio_submit() or aio_wait()
+ * return: 0 on success. -1 on error
+ ****/
+static int aio_queue(struct aio_ctx *aio, enum aio_op op, unsigned int buf, int fd, size_t len, off_t offset) {
+	struct aio_request *req = &aio->requests[buf];
+
+	if (len > aio->buffer_size)
+		len = aio->buffer_size;
+	req->op = op;
+	req->fd = fd;
+	req->len = len;
+	req->offset = offset;
+	req->result = 0;
+
+	if (aio->backend == AIO_URING) {
+		if (uring_queue(aio, buf) == -1)
+			return -1;
+	} else {
+		aio->pool.staged[aio->pool.num_staged++] = buf;
+	}
+
+	aio->in_flight++;
+	return 0;
+}
+
+/****
+ * Queue a read of up to len bytes at offset into a buffer
+ * return: 0 on success. -1 on error
+ ****/
+int aio_read(struct aio_ctx *aio, unsigned int buf, int fd, size_t len, off_t offset) {
+	return aio_queue(aio, AIO_OP_READ, buf, fd, len, offset);
+}
+
+/****
+ * Queue a write of the first len bytes of a buffer at offset
+ * return: 0 on success. -1 on error
+ ****/
+int aio_write(struct aio_ctx *aio, unsigned int buf, int fd, size_t len, off_t offset) {
+	return aio_queue(aio, AIO_OP_WRITE, buf, fd, len, offset);
+}
+
+/****
+ * Start every queued operation with a single system call or wakeup
+ * return: 0 on success. -1 on error
+ ****/
+int aio_submit(struct aio_ctx *aio) {
+	return aio->backend == AIO_URING ? uring_submit(aio) : pool_submit(aio);
+}
+
+/****
+ * Wait for the next operation to complete. Queued operations are submitted first
+ * buf: Filled with the buffer of the completed operation
+ * result: Filled with the number of bytes transferred, or a negative errno value
+ * return: 0 on success. -1 if nothing is in flight or waiting failed
+ ****/
+int aio_wait(struct aio_ctx *aio, unsigned int *buf, ssize_t *result) {
+	int ret;
+
+	if (aio->in_flight == 0)
+		return -1;
+
+	ret = aio->backend == AIO_URING ? uring_wait(aio, buf, result) : pool_wait(aio, buf, result);
+	if (ret == 0)
+		aio->in_flight--;
+	return ret;
+}
+
+/****
+ * Wait for every operation in flight, discarding the results
+ * return: Nothing
+ ****/
+void aio_drain(struct aio_ctx *aio) {
+	unsigned int buf;
+	ssize_t result;
+
+	while (aio->in_flight > 0 && aio_wait(aio, &buf, &result) == 0)
+		;
+}
@@ -0,0 +1,29 @@
+/*
+ * aio.h - Asynchronous disk I/O for proxy cache reads and fills
+ */
+
+#ifndef _AIO_H_
+#define _AIO_H_
+
+#include <sys/types.h>
+
+enum aio_backend {
+	AIO_URING,		/* io_uring with registered buffers */
+	AIO_THREADS		/* Thread pool running pread/pwrite */
+};
+
+struct aio_ctx;
+
+struct aio_ctx *aio_create(enum aio_backend backend, unsigned int num_buffers, size_t buffer_size);
+void aio_destroy(struct aio_ctx *aio);
+enum aio_backend aio_get_backend(const struct aio_ctx *aio);
+unsigned int aio_num_buffers(const struct aio_ctx *aio);
+size_t aio_buffer_size(const struct aio_ctx *aio);
+char *aio_buffer(struct aio_ctx *aio, unsigned int buf);
+int aio_read(struct aio_ctx *aio, unsigned int buf, int fd, size_t len, off_t offset);
+int aio_write(struct aio_ctx *aio, unsigned int buf, int fd, size_t len, off_t offset);
+int aio_submit(struct aio_ctx *aio);
+int aio_wait(struct aio_ctx *aio, unsigned int *buf, ssize_t *result);
+void aio_drain(struct aio_ctx *aio);
+
+#endif // _AIO_H_
@@ -0,0 +1,57 @@
+/*
+ * bloom.c - Bloom filters of object names
+ *
+ * A filter is an array of ints in which every bit is a slot. A string sets or
+ * checks one slot per hash function, each a MurmurHash3_x86_32 of the string with
+ * its own seed.
+ */
+
+#include <stdint.h>
+#include <string.h>
+#include "bloom.h"
+#include "murmur3.h"
+
+const unsigned int NUM_BLOOM_BITS = 303658;
+const unsigned int NUM_BLOOM_INTS = 10000;
+const unsigned int NUM_BLOOM_HASHES = 5;
+
+/****
+ * Insert a string into a bloom filter
+ * bloom_filter: An array of ints. Each bit in each int is a slot in the bloom filter
+ * num_hashes: Number of hash functions
+ * num_bits: Number of slots in the bloom filter
+ * return: Nothing
+ ****/
+void insert_bloom_filter(unsigned int bloom_filter[], unsigned int num_hashes, unsigned int num_bits, const char str[]) {
+	unsigned int int_bit_size = sizeof(unsigned int) * 8;
+	
+	unsigned int i;
+	for (i = 0; i < num_hashes; i++) {
+		uint32_t hash[4];
+		MurmurHash3_x86_32(str, strlen(str), i + 46, hash);
+		unsigned int index = (*hash % num_bits) / int_bit_size;
+		bloom_filter[index] |= (1 << (*hash % int_bit_size));	
+	}
+}
+
+/****
+ * Check if a string has been inserted into a bloom filter
+ * bloom_filter: An array of ints. Each bit in each int is a slot in the bloom filter
+ * num_hashes: Number of hash functions
+ * num_bits: Number of slots in the bloom filter
+ * return: 1 if string has been inserted. 0 if string has not been inserted
+ ****/
+unsigned int search_bloom_filter(const unsigned int bloom_filter[], unsigned int num_hashes, unsigned int num_bits, const char str[]) {
+	unsigned int int_bit_size = sizeof(unsigned int) * 8;
+	
+	unsigned int i;
+	for (i = 0; i < num_hashes; i++) {
+		uint32_t hash[4];
+		MurmurHash3_x86_32(str, strlen(str), i + 46, hash);
+		unsigned int index = (*hash % num_bits) / int_bit_size;
+		if ((bloom_filter[index] & (1 << (*hash % int_bit_size))) == 0)
+			return 0;
+	}
+
+	return 1;
+}
@@ -0,0 +1,15 @@
+/*
+ * bloom.h - Bloom filters of object names
+ */
+
+#ifndef _BLOOM_H_
+#define _BLOOM_H_
+
+extern const unsigned int NUM_BLOOM_BITS;
+extern const unsigned int NUM_BLOOM_INTS;
+extern const unsigned int NUM_BLOOM_HASHES;
+
+void insert_bloom_filter(unsigned int bloom_filter[], unsigned int num_hashes, unsigned int num_bits, const char str[]);
+unsigned int search_bloom_filter(const unsigned int bloom_filter[], unsigned int num_hashes, unsigned int num_bits, const char str[]);
+
+#endif // _BLOOM_H_
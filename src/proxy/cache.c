@@ -0,0 +1,909 @@
+/*
+ * cache.c - Proxy cache bookkeeping: freshness lifetimes, validators, chunk extents and
+ *           content-addressed storage
+ *
+ * Every cached object "name" has a data file "name" in the cache directory and a
+ * metadata file ".meta/name" holding the time it was last fetched or revalidated,
+ * its freshness lifetime, the server's validator, its size and a bitmap of the
+ * CHUNK_SIZE extents that are present in the data file. Data files are sparse:
+ * ranges are written in place as they arrive from the server, so an interrupted
+ * transfer keeps the extents it completed and only the missing ones are fetched
+ * later.
+ *
+ * The metadata file doubles as the object's lock. Readers hold a shared lock while
+ * reading it and opening the data file, writers hold an exclusive lock while
+ * updating it or replacing the data file with a new version, so the data file a
+ * reader opens always belongs to the metadata it read.
+ *
+ * Once every extent of an object is present, its content is stored once in
+ * ".objects/" under its MurmurHash3_x64_128 digest. The data file becomes a hard link
+ * to that content file, so names with identical bytes share one copy on disk and in
+ * the page cache, and a content file's reference count is its link count minus one.
+ * Digests are confirmed by comparing bytes; a colliding object is stored under the
+ * digest with a "-n" suffix. The metadata records the content file a name refers to
+ * so it can be released when the name is removed or replaced by a new version. A
+ * linked data file is only ever opened for reading: before a name is written to
+ * again it gets a private copy, so the other names sharing the content are untouched.
+ *
+ * The cache may be limited to a number of bytes. An eviction policy shared by all of
+ * the proxy server's processes is then told of every object served, and the objects
+ * it evicts are removed.
+ */
+
+#include <sys/types.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include <ctype.h>
+#include <dirent.h>
+#include <err.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "cache.h"
+#include "log.h"
+#include "murmur3.h"
+
+const char META_DIR[] = ".meta/";
+const char OBJECTS_DIR[] = ".objects/";
+const char OBJECTS_LOCK[] = ".lock";
+const char TTL_FILENAME[] = "Object_TTLs";
+const uint32_t DIGEST_SEED = 0x165;
+const int MAX_COLLISIONS = 16;
+
+struct ttl_entry {
+	char name[MAX_OBJECT_NAME + 1];
+	unsigned int ttl;
+};
+
+static char cache_dir[255];
+static unsigned int cache_default_ttl;
+static struct ttl_entry *ttl_table;
+static size_t ttl_count;
+
+/* Eviction policy state shared by the proxy server's processes. NULL if the cache is unlimited */
+static struct cache_limits {
+	pthread_mutex_t lock;
+	unsigned int max_objects;
+	char (*names)[MAX_OBJECT_NAME + 1];	/* Name of the object in each policy slot */
+	struct policy *policy;
+} *limits;
+
+/* Names of the objects evicted by one access, removed once the policy is unlocked */
+struct evictions {
+	char (*names)[MAX_OBJECT_NAME + 1];
+	unsigned int count;
+	unsigned int size;
+};
+
+static int compare_ttl_entries(const void *a, const void *b) {
+	return strcmp(((const struct ttl_entry *)a)->name, ((const struct ttl_entry *)b)->name);
+}
+
+/****
+ * Load per-object freshness lifetimes. Each line of the TTL file has the form
+ * "object_name seconds". The file is optional
+ * return: Nothing
+ ****/
+static void load_ttl_table(const char *config_dir) {
+	char filename[512];
+	snprintf(filename, sizeof(filename), "%s%s", config_dir, TTL_FILENAME);
+
+	FILE *fp;
+	if ((fp = fopen(filename, "r")) == NULL)
+		return;
+
+	size_t capacity = 0;
+	char name[MAX_OBJECT_NAME + 1];
+	unsigned int ttl;
+	while (fscanf(fp, "%255s %u", name, &ttl) == 2) {
+		if (ttl_count == capacity) {
+			capacity = capacity ? capacity * 2 : 64;
+			if ((ttl_table = realloc(ttl_table, capacity * sizeof(*ttl_table))) == NULL)
+				err(1, "realloc");
+		}
+		strcpy(ttl_table[ttl_count].name, name);
+		ttl_table[ttl_count].ttl = ttl;
+		ttl_count++;
+	}
+	fclose(fp);
+
+	qsort(ttl_table, ttl_count, sizeof(*ttl_table), compare_ttl_entries);
+	log_info("Loaded %zu per-object freshness lifetimes", ttl_count);
+}
+
+/****
+ * Build the path of a cache directory entry
+ * prefix: Subdirectory of the cache directory including its trailing '/', or ""
+ * return: Nothing
+ ****/
+static void entry_path(char *path, size_t size, const char *prefix, const char *object_name) {
+	snprintf(path, size, "%s%s%s", cache_dir, prefix, object_name);
+}
+
+/****
+ * Size an entry's chunk bitmap for an object
+ * complete: 1 if every chunk is present. 0 if none is
+ * return: Nothing
+ ****/
+static void set_size(struct cache_entry *entry, long long size, int complete) {
+	entry->size = size;
+	entry->num_chunks = (size + CHUNK_SIZE - 1) / CHUNK_SIZE;
+
+	free(entry->chunks);
+	if ((entry->chunks = malloc(entry->num_chunks / 8 + 1)) == NULL)
+		err(1, "malloc");
+	memset(entry->chunks, complete ? 0xff : 0, entry->num_chunks / 8 + 1);
+}
+
+static int chunk_present(const struct cache_entry *entry, size_t chunk) {
+	return (entry->chunks[chunk / 8] >> (chunk % 8)) & 1;
+}
+
+static int all_chunks_present(const struct cache_entry *entry) {
+	size_t i;
+	for (i = 0; i < entry->num_chunks; i++) {
+		if (!chunk_present(entry, i))
+			return 0;
+	}
+	return 1;
+}
+
+/****
+ * Open and lock an object's metadata file
+ * operation: LOCK_SH or LOCK_EX
+ * return: The locked file descriptor. -1 on error
+ ****/
+static int lock_meta(const char *object_name, int operation) {
+	char path[512];
+	int fd;
+
+	entry_path(path, sizeof(path), META_DIR, object_name);
+	if ((fd = open(path, operation == LOCK_EX ? O_RDWR | O_CREAT : O_RDONLY, 0644)) == -1)
+		return -1;
+	if (flock(fd, operation) == -1) {
+		close(fd);
+		return -1;
+	}
+	return fd;
+}
+
+/****
+ * Parse a locked metadata file of the form "fetched ttl validator size bitmap".
+ * The bitmap is written in hex, or as "*" once every chunk is present
+ * entry: Filled with the metadata. Its size is -1 if the file only has the first three fields
+ * return: 0 on success. -1 if the file is empty or malformed
+ ****/
+static int read_meta(int fd, struct cache_entry *entry) {
+	struct stat st;
+	char *buf;
+	long long fetched, size;
+	unsigned int ttl;
+	char validator[VALIDATOR_LEN];
+	int fields, offset = 0;
+
+	if (fstat(fd, &st) == -1 || st.st_size == 0)
+		return -1;
+	if ((buf = malloc(st.st_size + 1)) == NULL)
+		err(1, "malloc");
+	if (pread(fd, buf, st.st_size, 0) != st.st_size) {
+		free(buf);
+		return -1;
+	}
+	buf[st.st_size] = '\0';
+
+	fields = sscanf(buf, "%lld %u %63s %lld %n", &fetched, &ttl, validator, &size, &offset);
+	if (fields < 3) {
+		free(buf);
+		return -1;
+	}
+
+	entry->fetched = fetched;
+	entry->ttl = ttl;
+	strcpy(entry->validator, strcmp(validator, "-") == 0 ? "" : validator);
+	if (fields < 4 || offset == 0) {
+		entry->size = -1;
+		free(buf);
+		return 0;
+	}
+
+	char *bitmap = buf + offset;
+	set_size(entry, size, bitmap[0] == '*');
+	if (bitmap[0] != '*') {
+		size_t i;
+		for (i = 0; i < entry->num_chunks / 8 + 1 && isxdigit((unsigned char)bitmap[2 * i]) &&
+		    isxdigit((unsigned char)bitmap[2 * i + 1]); i++) {
+			unsigned int byte;
+			sscanf(bitmap + 2 * i, "%2x", &byte);
+			entry->chunks[i] = byte;
+		}
+	}
+	if (sscanf(bitmap, "%*s %47s", entry->blob) != 1)
+		entry->blob[0] = '\0';
+
+	free(buf);
+	return 0;
+}
+
+/****
+ * Replace the contents of a locked metadata file
+ * return: 0 on success. -1 on error
+ ****/
+static int write_meta(int fd, const struct cache_entry *entry) {
+	size_t bitmap_len = entry->num_chunks / 8 + 1;
+	size_t len = 128 + VALIDATOR_LEN + BLOB_NAME_LEN + 2 * bitmap_len;
+	char *buf;
+	int n;
+
+	if ((buf = malloc(len)) == NULL)
+		err(1, "malloc");
+
+	n = snprintf(buf, len, "%lld %u %s %lld ", (long long)entry->fetched, entry->ttl,
+	    entry->validator[0] ? entry->validator : "-", entry->size);
+	if (all_chunks_present(entry)) {
+		buf[n++] = '*';
+	} else {
+		size_t i;
+		for (i = 0; i < bitmap_len; i++)
+			n += snprintf(buf + n, len - n, "%02x", entry->chunks[i]);
+	}
+	if (entry->blob[0] != '\0')
+		n += snprintf(buf + n, len - n, " %s", entry->blob);
+	buf[n++] = '\n';
+
+	int ret = (ftruncate(fd, 0) == 0 && pwrite(fd, buf, n, 0) == n) ? 0 : -1;
+	free(buf);
+	return ret;
+}
+
+/****
+ * Take the lock serializing changes to the content files' links
+ * return: The locked file descriptor. -1 on error
+ ****/
+static int lock_objects() {
+	char path[512];
+	int fd;
+
+	entry_path(path, sizeof(path), OBJECTS_DIR, OBJECTS_LOCK);
+	if ((fd = open(path, O_RDWR | O_CREAT, 0644)) == -1)
+		return -1;
+	if (flock(fd, LOCK_EX) == -1) {
+		close(fd);
+		return -1;
+	}
+	return fd;
+}
+
+/****
+ * Compare a content file with the bytes of a data file
+ * st: Status of the data file
+ * data: Mapped contents of the data file
+ * return: 1 if the contents are identical. 0 if they differ. -1 on error
+ ****/
+static int same_content(const char *blob_path, const struct stat *st, const unsigned char *data) {
+	struct stat blob_st;
+	unsigned char *blob_data;
+	int fd, ret;
+
+	if ((fd = open(blob_path, O_RDONLY)) == -1 || fstat(fd, &blob_st) == -1) {
+		if (fd != -1)
+			close(fd);
+		return -1;
+	}
+	if (blob_st.st_dev == st->st_dev && blob_st.st_ino == st->st_ino) {
+		close(fd);
+		return 1;
+	}
+	if (blob_st.st_size != st->st_size) {
+		close(fd);
+		return 0;
+	}
+
+	if ((blob_data = mmap(NULL, blob_st.st_size, PROT_READ, MAP_SHARED, fd, 0)) == MAP_FAILED) {
+		close(fd);
+		return -1;
+	}
+	ret = memcmp(blob_data, data, blob_st.st_size) == 0;
+	munmap(blob_data, blob_st.st_size);
+	close(fd);
+	return ret;
+}
+
+/****
+ * Store a complete object by content. Its data file is linked into the objects
+ * directory under its digest, or replaced by a link to an existing content file
+ * with the same bytes. Must be called with the object's metadata locked exclusively
+ * entry: Complete entry of the object. Its blob is set on success
+ * return: Nothing. On failure the object simply keeps a private copy
+ ****/
+static void store_blob(const char *object_name, struct cache_entry *entry) {
+	char path[512], blob_path[512], tmp_path[512];
+	uint64_t digest[2];
+	struct stat st;
+	unsigned char *data;
+	int lock_fd, i;
+
+	if (entry->size <= 0 || entry->size > INT_MAX || fstat(entry->fd, &st) == -1 || st.st_size != entry->size)
+		return;
+	if ((data = mmap(NULL, entry->size, PROT_READ, MAP_SHARED, entry->fd, 0)) == MAP_FAILED)
+		return;
+	MurmurHash3_x64_128(data, entry->size, DIGEST_SEED, digest);
+
+	if ((lock_fd = lock_objects()) == -1) {
+		munmap(data, entry->size);
+		return;
+	}
+
+	cache_path(path, sizeof(path), object_name);
+	for (i = 0; i < MAX_COLLISIONS; i++) {
+		char blob[BLOB_NAME_LEN];
+		if (i == 0)
+			snprintf(blob, sizeof(blob), "%016llx%016llx", (unsigned long long)digest[0], (unsigned long long)digest[1]);
+		else
+			snprintf(blob, sizeof(blob), "%016llx%016llx-%d", (unsigned long long)digest[0], (unsigned long long)digest[1], i);
+		entry_path(blob_path, sizeof(blob_path), OBJECTS_DIR, blob);
+
+		if (link(path, blob_path) == 0) {
+			strcpy(entry->blob, blob);
+			break;
+		}
+		if (errno != EEXIST)
+			break;
+
+		int same = same_content(blob_path, &st, data);
+		if (same == -1)
+			break;
+		if (same == 0) {
+			log_info("Digest collision between %s and content %s", object_name, blob);
+			continue;
+		}
+
+		snprintf(tmp_path, sizeof(tmp_path), "%s%s%s.%ld.dedup", cache_dir, META_DIR, object_name, (long)getpid());
+		unlink(tmp_path);
+		if (link(blob_path, tmp_path) == 0 && rename(tmp_path, path) == 0) {
+			strcpy(entry->blob, blob);
+			log_debug("Stored %s as a reference to identical content %s", object_name, blob);
+		} else {
+			unlink(tmp_path);
+		}
+		break;
+	}
+
+	close(lock_fd);
+	munmap(data, entry->size);
+}
+
+/****
+ * Drop a name's reference to a content file, removing the file once no name refers to it
+ * return: Nothing
+ ****/
+static void release_blob(const char *blob) {
+	char blob_path[512];
+	struct stat st;
+	int lock_fd;
+
+	if (blob[0] == '\0' || (lock_fd = lock_objects()) == -1)
+		return;
+
+	entry_path(blob_path, sizeof(blob_path), OBJECTS_DIR, blob);
+	if (stat(blob_path, &st) == 0 && st.st_nlink <= 1)
+		unlink(blob_path);
+	close(lock_fd);
+}
+
+/****
+ * Set up the cache directory's bookkeeping. Must be called before any other cache function
+ * dir: Cache directory including its trailing '/'
+ * config_dir: Directory of the TTL file including its trailing '/'
+ * default_ttl: Freshness lifetime in seconds of objects without an entry in the TTL file
+ * return: Nothing
+ ****/
+void cache_init(const char *dir, const char *config_dir, unsigned int default_ttl) {
+	strncpy(cache_dir, dir, sizeof(cache_dir) - 1);
+	cache_default_ttl = default_ttl;
+
+	char meta_dir[512];
+	entry_path(meta_dir, sizeof(meta_dir), META_DIR, "");
+	if (mkdir(meta_dir, 0755) == -1 && errno != EEXIST)
+		err(1, "mkdir %s", meta_dir);
+
+	char objects_dir[512];
+	entry_path(objects_dir, sizeof(objects_dir), OBJECTS_DIR, "");
+	if (mkdir(objects_dir, 0755) == -1 && errno != EEXIST)
+		err(1, "mkdir %s", objects_dir);
+
+	load_ttl_table(config_dir);
+
+	unsigned long long names, logical_bytes, stored_bytes;
+	cache_dedup_stats(&names, &logical_bytes, &stored_bytes);
+	if (stored_bytes > 0)
+		log_info("Content store holds %llu bytes for %llu names totalling %llu bytes (dedup ratio %.2f)",
+		    stored_bytes, names, logical_bytes, (double)logical_bytes / stored_bytes);
+}
+
+/****
+ * Build the path of a cached object's data file
+ * return: Nothing
+ ****/
+void cache_path(char *path, size_t size, const char *object_name) {
+	entry_path(path, size, "", object_name);
+}
+
+/****
+ * Get the freshness lifetime of an object
+ * return: Lifetime in seconds
+ ****/
+unsigned int cache_ttl(const char *object_name) {
+	struct ttl_entry key;
+	struct ttl_entry *entry;
+
+	strncpy(key.name, object_name, sizeof(key.name) - 1);
+	key.name[sizeof(key.name) - 1] = '\0';
+	entry = bsearch(&key, ttl_table, ttl_count, sizeof(*ttl_table), compare_ttl_entries);
+	return entry != NULL ? entry->ttl : cache_default_ttl;
+}
+
+/****
+ * Prepare an empty entry for an object that is not cached
+ * return: Nothing
+ ****/
+void cache_entry_init(struct cache_entry *entry) {
+	memset(entry, 0, sizeof(*entry));
+	entry->size = -1;
+	entry->fd = -1;
+}
+
+/****
+ * Release the bitmap and data file of an entry
+ * return: Nothing
+ ****/
+void cache_entry_free(struct cache_entry *entry) {
+	free(entry->chunks);
+	if (entry->fd != -1)
+		close(entry->fd);
+	cache_entry_init(entry);
+}
+
+/****
+ * Look up an object in the cache and open its data file. Objects cached without
+ * metadata are treated as complete, fetched at their modification time and with an
+ * unknown validator
+ * entry: Initialized entry, filled with the object's metadata if it is cached
+ * return: 0 if the object is cached. -1 otherwise
+ ****/
+int cache_lookup(const char *object_name, struct cache_entry *entry) {
+	char path[512];
+	struct stat st;
+	int meta_fd;
+
+	cache_entry_free(entry);
+	meta_fd = lock_meta(object_name, LOCK_SH);
+	int have_meta = meta_fd != -1 && read_meta(meta_fd, entry) == 0;
+
+	cache_path(path, sizeof(path), object_name);
+	if ((entry->fd = open(path, entry->blob[0] != '\0' ? O_RDONLY : O_RDWR)) == -1 || fstat(entry->fd, &st) == -1 ||
+	    !S_ISREG(st.st_mode)) {
+		if (meta_fd != -1)
+			close(meta_fd);
+		cache_entry_free(entry);
+		return -1;
+	}
+
+	if (!have_meta) {
+		entry->fetched = st.st_mtime;
+		entry->ttl = cache_ttl(object_name);
+		entry->validator[0] = '\0';
+		entry->size = -1;
+	}
+	if (entry->size < 0)
+		set_size(entry, st.st_size, 1);
+
+	if (meta_fd != -1)
+		close(meta_fd);
+	return 0;
+}
+
+/****
+ * Check whether a cached object is still within its freshness lifetime
+ * return: 1 if fresh. 0 if stale
+ ****/
+int cache_fresh(const struct cache_entry *entry, time_t now) {
+	return now - entry->fetched < (time_t)entry->ttl;
+}
+
+/****
+ * Check whether every byte of a range of an object is cached
+ * start, end: First and last byte of the range. Must be inside the object
+ * return: 1 if the whole range is cached. 0 otherwise
+ ****/
+int cache_has_range(const struct cache_entry *entry, long long start, long long end) {
+	long long chunk;
+
+	if (entry->chunks == NULL)
+		return 0;
+	for (chunk = start / CHUNK_SIZE; chunk <= end / CHUNK_SIZE && (size_t)chunk < entry->num_chunks; chunk++) {
+		if (!chunk_present(entry, chunk))
+			return 0;
+	}
+	return 1;
+}
+
+/****
+ * Find the first run of missing chunks overlapping a range of an object
+ * start, end: First and last byte of the range. Must be inside the object
+ * run_start, run_end: Filled with the chunk aligned first and last byte of the missing run
+ * return: 1 if a missing run was found. 0 if the whole range is cached
+ ****/
+int cache_missing_range(const struct cache_entry *entry, long long start, long long end, long long *run_start, long long *run_end) {
+	long long chunk = start / CHUNK_SIZE;
+	long long last = end / CHUNK_SIZE;
+
+	while (chunk <= last && chunk_present(entry, chunk))
+		chunk++;
+	if (chunk > last)
+		return 0;
+
+	*run_start = chunk * CHUNK_SIZE;
+	while (chunk <= last && !chunk_present(entry, chunk))
+		chunk++;
+	*run_end = chunk * CHUNK_SIZE - 1;
+	if (*run_end >= entry->size)
+		*run_end = entry->size - 1;
+	return 1;
+}
+
+/****
+ * Start caching a new version of an object: an empty sparse data file of the given
+ * size replaces any previous version. If another process already started the same
+ * version, its data file and progress are adopted instead
+ * entry: Entry of the object. Updated to the new version
+ * return: 0 on success. -1 on error
+ ****/
+int cache_begin_version(const char *object_name, struct cache_entry *entry, long long size, const char *validator) {
+	struct cache_entry current;
+	char path[512];
+	char tmp_path[512];
+	int meta_fd, fd;
+
+	if ((meta_fd = lock_meta(object_name, LOCK_EX)) == -1)
+		return -1;
+
+	cache_path(path, sizeof(path), object_name);
+	cache_entry_init(&current);
+	if (read_meta(meta_fd, &current) == 0 && validator[0] != '\0' && current.size == size &&
+	    strcmp(current.validator, validator) == 0 && (fd = open(path, current.blob[0] != '\0' ? O_RDONLY : O_RDWR)) != -1) {
+		cache_entry_free(entry);
+		*entry = current;
+		entry->fd = fd;
+		close(meta_fd);
+		return 0;
+	}
+
+	snprintf(tmp_path, sizeof(tmp_path), "%s%s%s.%ld.fill", cache_dir, META_DIR, object_name, (long)getpid());
+	if ((fd = open(tmp_path, O_RDWR | O_CREAT | O_TRUNC, 0644)) == -1 || ftruncate(fd, size) == -1 ||
+	    rename(tmp_path, path) == -1) {
+		if (fd != -1)
+			close(fd);
+		unlink(tmp_path);
+		cache_entry_free(&current);
+		close(meta_fd);
+		return -1;
+	}
+	release_blob(current.blob);
+	cache_entry_free(&current);
+
+	cache_entry_free(entry);
+	entry->fetched = time(NULL);
+	entry->ttl = cache_ttl(object_name);
+	strncpy(entry->validator, validator, sizeof(entry->validator) - 1);
+	set_size(entry, size, size == 0);
+	entry->fd = fd;
+
+	int ret = write_meta(meta_fd, entry);
+	close(meta_fd);
+	return ret;
+}
+
+/****
+ * Copy a data file into a new file
+ * return: The new file, open for reading and writing. -1 on error
+ ****/
+static int copy_data(int fd, const char *copy_path, long long size) {
+	char buf[CHUNK_SIZE];
+	long long offset = 0;
+	int copy_fd;
+
+	if ((copy_fd = open(copy_path, O_RDWR | O_CREAT | O_TRUNC, 0644)) == -1)
+		return -1;
+	while (offset < size) {
+		ssize_t n = pread(fd, buf, size - offset < (long long)sizeof(buf) ? size - offset : (long long)sizeof(buf), offset);
+		if (n <= 0 || pwrite(copy_fd, buf, n, offset) != n) {
+			close(copy_fd);
+			return -1;
+		}
+		offset += n;
+	}
+	return copy_fd;
+}
+
+/****
+ * Make an object's data file writable before a range is written into it. A data file
+ * linked to a content file is replaced by a private copy and the name's reference to
+ * the content file is dropped, so names sharing the content keep their bytes
+ * entry: Entry of the object. Its data file is replaced by one open for writing
+ * return: 0 on success. -1 on error or if the version was replaced meanwhile
+ ****/
+int cache_unshare(const char *object_name, struct cache_entry *entry) {
+	struct cache_entry current;
+	char path[512], copy_path[512];
+	int meta_fd, fd = -1, ret = -1;
+
+	if ((meta_fd = lock_meta(object_name, LOCK_EX)) == -1)
+		return -1;
+
+	cache_path(path, sizeof(path), object_name);
+	cache_entry_init(&current);
+	if (read_meta(meta_fd, &current) == 0 && (current.size != entry->size || strcmp(current.validator, entry->validator) != 0)) {
+		;						// Another process started a new version
+	} else if (current.blob[0] != '\0') {		// Linked since it was opened, possibly by another process
+		snprintf(copy_path, sizeof(copy_path), "%s%s%s.%ld.copy", cache_dir, META_DIR, object_name, (long)getpid());
+		if ((fd = copy_data(entry->fd, copy_path, entry->size)) != -1 && rename(copy_path, path) == 0) {
+			log_debug("Copied %s out of content %s before writing to it", object_name, current.blob);
+			release_blob(current.blob);
+			current.blob[0] = '\0';
+			ret = write_meta(meta_fd, &current);
+		} else {
+			unlink(copy_path);
+		}
+	} else if ((fcntl(entry->fd, F_GETFL) & O_ACCMODE) != O_RDONLY) {
+		ret = 0;
+	} else if ((fd = open(path, O_RDWR)) != -1) {		// Opened while linked, and another process copied it since
+		ret = 0;
+	}
+	if (ret == 0 && fd != -1) {
+		close(entry->fd);
+		entry->fd = fd;
+	} else if (fd != -1) {
+		close(fd);
+	}
+	if (ret == 0)
+		entry->blob[0] = '\0';
+	cache_entry_free(&current);
+	close(meta_fd);
+	return ret;
+}
+
+/****
+ * Record that a byte range of an object has been written to its data file. Only
+ * chunks covered completely are marked present. Progress recorded by other
+ * processes for the same version is merged in
+ * start, end: First byte of the range and the byte after its last one
+ * return: 0 on success. -1 on error or if the version was replaced meanwhile
+ ****/
+int cache_mark_range(const char *object_name, struct cache_entry *entry, long long start, long long end) {
+	struct cache_entry current;
+	long long chunk;
+	int meta_fd, ret = -1;
+
+	for (chunk = (start + CHUNK_SIZE - 1) / CHUNK_SIZE; (size_t)chunk < entry->num_chunks; chunk++) {
+		long long chunk_end = (chunk + 1) * CHUNK_SIZE;
+		if (chunk_end > entry->size)
+			chunk_end = entry->size;
+		if (chunk_end > end)
+			break;
+		entry->chunks[chunk / 8] |= 1 << (chunk % 8);
+	}
+
+	if ((meta_fd = lock_meta(object_name, LOCK_EX)) == -1)
+		return -1;
+
+	cache_entry_init(&current);
+	if (read_meta(meta_fd, &current) == 0 && (current.size == entry->size || current.size < 0) &&
+	    strcmp(current.validator, entry->validator) == 0) {
+		size_t i;
+		for (i = 0; current.chunks != NULL && i < entry->num_chunks / 8 + 1; i++)
+			entry->chunks[i] |= current.chunks[i];
+		if (current.blob[0] != '\0')
+			strcpy(entry->blob, current.blob);
+		else if (entry->blob[0] == '\0' && all_chunks_present(entry))
+			store_blob(object_name, entry);
+		ret = write_meta(meta_fd, entry);
+	}
+	cache_entry_free(&current);
+	close(meta_fd);
+	return ret;
+}
+
+/****
+ * Restart an object's freshness lifetime after the server confirmed it is unchanged
+ * return: 0 on success. -1 on error or if the version was replaced meanwhile
+ ****/
+int cache_renew(const char *object_name, struct cache_entry *entry) {
+	entry->fetched = time(NULL);
+	return cache_mark_range(object_name, entry, 0, 0);
+}
+
+/****
+ * Remove an object and its metadata from the cache
+ * return: Nothing
+ ****/
+void cache_remove(const char *object_name) {
+	struct cache_entry current;
+	char path[512];
+	int meta_fd = lock_meta(object_name, LOCK_EX);
+
+	cache_entry_init(&current);
+	if (meta_fd != -1)
+		read_meta(meta_fd, &current);
+
+	cache_path(path, sizeof(path), object_name);
+	unlink(path);
+	entry_path(path, sizeof(path), META_DIR, object_name);
+	unlink(path);
+	release_blob(current.blob);
+	cache_entry_free(&current);
+
+	if (meta_fd != -1)
+		close(meta_fd);
+}
+
+/****
+ * Measure how much space content-addressed storage saves
+ * names: Filled with the number of names referring to stored content
+ * logical_bytes: Filled with the total size of those names' objects
+ * stored_bytes: Filled with the size of the stored content files
+ * return: Nothing
+ ****/
+void cache_dedup_stats(unsigned long long *names, unsigned long long *logical_bytes, unsigned long long *stored_bytes) {
+	char path[512];
+	struct dirent *de;
+	struct stat st;
+	DIR *dir;
+
+	*names = *logical_bytes = *stored_bytes = 0;
+	entry_path(path, sizeof(path), OBJECTS_DIR, "");
+	if ((dir = opendir(path)) == NULL)
+		return;
+
+	while ((de = readdir(dir)) != NULL) {
+		if (de->d_name[0] == '.')
+			continue;
+		entry_path(path, sizeof(path), OBJECTS_DIR, de->d_name);
+		if (stat(path, &st) == -1 || !S_ISREG(st.st_mode) || st.st_nlink < 2)
+			continue;
+		*names += st.st_nlink - 1;
+		*logical_bytes += (unsigned long long)st.st_size * (st.st_nlink - 1);
+		*stored_bytes += st.st_size;
+	}
+	closedir(dir);
+}
+
+static void lock_limits() {
+	if (pthread_mutex_lock(&limits->lock) == EOWNERDEAD)
+		pthread_mutex_consistent(&limits->lock);	// The policy may still count an object the dead process evicted
+}
+
+static void add_eviction(struct evictions *evictions, const char *object_name) {
+	if (evictions->count == evictions->size) {
+		evictions->size = evictions->size == 0 ? 16 : 2 * evictions->size;
+		if ((evictions->names = realloc(evictions->names, evictions->size * sizeof(evictions->names[0]))) == NULL)
+			err(1, "realloc");
+	}
+	strcpy(evictions->names[evictions->count++], object_name);
+}
+
+static void collect_eviction(unsigned int slot, void *arg) {
+	add_eviction(arg, limits->names[slot]);
+}
+
+/****
+ * Call a function for every object with metadata, in the order of their names
+ * return: Number of objects. -1 if the metadata directory cannot be read
+ ****/
+int cache_scan(void (*fn)(const char *object_name, void *arg), void *arg) {
+	char path[512];
+	struct dirent **names;
+	int i, n, count = 0;
+
+	entry_path(path, sizeof(path), META_DIR, "");
+	if ((n = scandir(path, &names, NULL, alphasort)) == -1)
+		return -1;
+	for (i = 0; i < n; i++) {
+		if (names[i]->d_name[0] != '.' && names[i]->d_type != DT_DIR) {
+			fn(names[i]->d_name, arg);
+			count++;
+		}
+		free(names[i]);
+	}
+	free(names);
+	return count;
+}
+
+static void account_cached(const char *object_name, void *arg) {
+	char path[512];
+	struct stat st;
+
+	cache_path(path, sizeof(path), object_name);
+	if (stat(path, &st) == 0 && S_ISREG(st.st_mode))
+		cache_account(object_name, st.st_size);
+}
+
+/****
+ * Limit the bytes of cached objects, evicting objects as chosen by a policy. Objects
+ * cached earlier are counted in the order of their names. Must be called after
+ * cache_init and before the processes that serve requests are forked
+ * capacity: Bytes the cached objects may take up
+ * return: Nothing
+ ****/
+void cache_limit(unsigned long long capacity, enum policy_kind kind) {
+	unsigned int max_objects = policy_objects(capacity);
+	pthread_mutexattr_t attr;
+	size_t size;
+
+	size = sizeof(*limits) + max_objects * sizeof(limits->names[0]) + policy_size(max_objects);
+	if ((limits = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0)) == MAP_FAILED)
+		err(1, "mmap");
+	limits->max_objects = max_objects;
+	limits->names = (void *)(limits + 1);
+	limits->policy = (void *)(limits->names + max_objects);
+	policy_init(limits->policy, kind, capacity, max_objects);
+
+	pthread_mutexattr_init(&attr);
+	pthread_mutexattr_setpshared(&attr, PTHREAD_PROCESS_SHARED);
+	pthread_mutexattr_setrobust(&attr, PTHREAD_MUTEX_ROBUST);
+	pthread_mutex_init(&limits->lock, &attr);
+	pthread_mutexattr_destroy(&attr);
+
+	cache_scan(account_cached, NULL);
+	log_info("Cache limited to %llu bytes with %s eviction. %u objects totalling %llu bytes already cached", capacity,
+	    POLICY_NAMES[kind], policy_count(limits->policy), policy_used(limits->policy));
+}
+
+/****
+ * Tell the eviction policy an object was served from the cache, and remove the
+ * objects it evicts. Does nothing if the cache is unlimited
+ * size: Size of the object
+ * return: Number of objects removed, including the object itself if it was not admitted
+ ****/
+unsigned int cache_account(const char *object_name, long long size) {
+	struct evictions evictions = {NULL, 0, 0};
+	uint64_t key[2];
+	unsigned int slot, i;
+
+	if (limits == NULL)
+		return 0;
+	MurmurHash3_x64_128(object_name, strlen(object_name), POLICY_SEED, key);
+	lock_limits();
+	if (policy_access(limits->policy, key[0], size, &slot, collect_eviction, &evictions) == POLICY_REJECTED)
+		add_eviction(&evictions, object_name);
+	else
+		strcpy(limits->names[slot], object_name);
+	pthread_mutex_unlock(&limits->lock);
+
+	for (i = 0; i < evictions.count; i++) {
+		log_debug("Evicting %s from the cache", evictions.names[i]);
+		cache_remove(evictions.names[i]);
+	}
+	free(evictions.names);
+	return evictions.count;
+}
+
+/****
+ * Measure the cached objects counted against the cache's limit
+ * return: 0 on success. -1 if the cache is unlimited
+ ****/
+int cache_usage(unsigned long long *bytes, unsigned int *objects) {
+	if (limits == NULL)
+		return -1;
+	lock_limits();
+	*bytes = policy_used(limits->policy);
+	*objects = policy_count(limits->policy);
+	pthread_mutex_unlock(&limits->lock);
+	return 0;
+}
@@ -0,0 +1,47 @@
+/*
+ * cache.h - Proxy cache bookkeeping: freshness lifetimes, validators, chunk extents and
+ *           content-addressed storage
+ */
+
+#ifndef _CACHE_H_
+#define _CACHE_H_
+
+#include <time.h>
+#include "policy.h"
+#include "protocol.h"
+
+#define CHUNK_SIZE (64 * 1024)
+#define BLOB_NAME_LEN 48
+
+struct cache_entry {
+	time_t fetched;				/* Time of the last fetch or successful revalidation */
+	unsigned int ttl;			/* Freshness lifetime in seconds */
+	char validator[VALIDATOR_LEN];		/* Validator handed out by the server. Empty if unknown */
+	long long size;				/* Object size in bytes */
+	size_t num_chunks;			/* Number of CHUNK_SIZE extents of the object */
+	unsigned char *chunks;			/* Bitmap of the extents present in the data file */
+	int fd;					/* Data file of this version of the object */
+	char blob[BLOB_NAME_LEN];		/* Shared content file the data file is linked to. Empty if not stored yet */
+};
+
+void cache_init(const char *dir, const char *config_dir, unsigned int default_ttl);
+void cache_path(char *path, size_t size, const char *object_name);
+unsigned int cache_ttl(const char *object_name);
+int cache_lookup(const char *object_name, struct cache_entry *entry);
+void cache_entry_init(struct cache_entry *entry);
+void cache_entry_free(struct cache_entry *entry);
+int cache_fresh(const struct cache_entry *entry, time_t now);
+int cache_has_range(const struct cache_entry *entry, long long start, long long end);
+int cache_missing_range(const struct cache_entry *entry, long long start, long long end, long long *run_start, long long *run_end);
+int cache_begin_version(const char *object_name, struct cache_entry *entry, long long size, const char *validator);
+int cache_unshare(const char *object_name, struct cache_entry *entry);
+int cache_mark_range(const char *object_name, struct cache_entry *entry, long long start, long long end);
+int cache_renew(const char *object_name, struct cache_entry *entry);
+void cache_remove(const char *object_name);
+int cache_scan(void (*fn)(const char *object_name, void *arg), void *arg);
+void cache_limit(unsigned long long capacity, enum policy_kind kind);
+unsigned int cache_account(const char *object_name, long long size);
+int cache_usage(unsigned long long *bytes, unsigned int *objects);
+void cache_dedup_stats(unsigned long long *names, unsigned long long *logical_bytes, unsigned long long *stored_bytes);
+
+#endif // _CACHE_H_
@@ -0,0 +1,50 @@
+/*
+ * counters.h - Counters of the proxy server exported on the admin port
+ */
+
+#ifndef _COUNTERS_H_
+#define _COUNTERS_H_
+
+#include "metrics.h"
+
+enum counter {
+	COUNTER_REQUESTS,			/* Requests per logical proxy server */
+	COUNTER_INVALID_REQUESTS,		/* Malformed requests, unknown proxy servers and invalid object names */
+	COUNTER_BLACKLISTED,			/* Requests denied by a proxy server's blacklist */
+	COUNTER_CACHE_HITS,			/* Requests answered from the cache without contacting the server first */
+	COUNTER_CACHE_MISSES,			/* Requests that had to fetch or revalidate from the server first */
+	COUNTER_CACHE_EVICTIONS,		/* Objects removed by the eviction policy */
+	COUNTER_ORIGIN_FETCHES,			/* Requests sent to the server, single or batch */
+	COUNTER_PEER_FETCHES,			/* Misses fetched from a peer first, by result */
+	COUNTER_PEER_REQUESTS,			/* Requests from peers, by result */
+	COUNTER_HOT_RESPONSES,			/* Responses that advertised a hot object */
+	COUNTER_BYTES_SERVED,			/* Body bytes sent to clients */
+	COUNTER_OPEN_CONNECTIONS,		/* Established client sessions */
+	COUNTER_DEADLINES_EXPIRED,		/* Expired deadlines by kind */
+	COUNTER_ADMISSION,			/* Connections by admission outcome when forking per connection */
+	NUM_COUNTERS
+};
+
+enum origin_fetch_kind {
+	ORIGIN_FETCH_SINGLE,
+	ORIGIN_FETCH_BATCH
+};
+
+enum peer_result {
+	PEER_HIT,				/* The peer sent the object */
+	PEER_MISS,				/* The peer did not have the object cached */
+	PEER_ERROR				/* The peer could not be reached or the transfer failed */
+};
+
+enum admission_outcome {
+	ADMISSION_ADMITTED,			/* Started without waiting */
+	ADMISSION_QUEUED,			/* Had to wait for a slot */
+	ADMISSION_DEQUEUED,			/* Got a slot after waiting */
+	ADMISSION_SHED_QUEUE_FULL,		/* Rejected because the wait queue was full */
+	ADMISSION_SHED_DEADLINE,		/* Rejected when its deadline passed while waiting */
+	ADMISSION_SHED_CLIENT_RATE		/* Rejected by its client's token bucket */
+};
+
+extern const struct metric COUNTERS[];
+
+#endif // _COUNTERS_H_
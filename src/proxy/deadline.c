@@ -0,0 +1,148 @@
+/*
+ * deadline.c - Read, write, idle, keep-alive and origin deadlines for blocking connections
+ *
+ * Connections are served with blocking reads and writes, so a deadline does not
+ * interrupt the code waiting on it directly. Every process keeps its armed deadlines
+ * in one timer wheel, advanced by a ticker thread every TICK_MS milliseconds. An
+ * expired deadline shuts down its socket, which makes the blocked tls_read or
+ * tls_write fail, and the request unwinds through its normal error path, closing
+ * its files and keeping whatever was already cached.
+ *
+ * The ticker thread is started by the first deadline armed in a process. Forked
+ * children start their own and drop the deadlines of their parent.
+ */
+
+#include <sys/types.h>
+#include <sys/socket.h>
+
+#include <err.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <time.h>
+#include <unistd.h>
+#include "counters.h"
+#include "deadline.h"
+#include "log.h"
+
+const unsigned int TICK_MS = 10;
+const char *DEADLINE_NAMES[] = {"idle", "keepalive", "read", "write", "origin"};
+
+static unsigned int timeouts[NUM_DEADLINE_KINDS];	/* Milliseconds. 0 disables the deadline */
+static unsigned long long expired_counts[NUM_DEADLINE_KINDS];
+static struct timer_wheel wheel;
+static pthread_mutex_t lock = PTHREAD_MUTEX_INITIALIZER;
+static pid_t ticker_pid;				/* Process the ticker thread runs in */
+
+static uint64_t current_tick() {
+	struct timespec now;
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return ((uint64_t)now.tv_sec * 1000 + now.tv_nsec / 1000000) / TICK_MS;
+}
+
+static void expire(struct timer *timer) {
+	struct deadline *deadline = (struct deadline *)timer;
+
+	deadline->expired = 1;
+	expired_counts[deadline->kind]++;
+	metrics_add(COUNTER_DEADLINES_EXPIRED, deadline->kind, 1);
+	shutdown(deadline->fd, SHUT_RDWR);
+	log_warn("%s deadline of %u ms expired", DEADLINE_NAMES[deadline->kind], timeouts[deadline->kind]);
+}
+
+static void *run_ticker(void *arg) {
+	for (;;) {
+		usleep(TICK_MS * 1000);
+		pthread_mutex_lock(&lock);
+		timer_wheel_advance(&wheel, current_tick());
+		pthread_mutex_unlock(&lock);
+	}
+	return NULL;
+}
+
+/****
+ * Forget the parent's deadlines and ticker thread in a forked child
+ * return: Nothing
+ ****/
+static void reset_child() {
+	pthread_mutex_init(&lock, NULL);
+	ticker_pid = 0;
+}
+
+/****
+ * Start the ticker thread of this process. Called with the lock held
+ * return: Nothing
+ ****/
+static void start_ticker() {
+	static int registered;
+	pthread_t thread;
+
+	if (!registered && pthread_atfork(NULL, NULL, reset_child) != 0)
+		errx(1, "pthread_atfork failed");
+	registered = 1;
+
+	timer_wheel_init(&wheel, current_tick());
+	if (pthread_create(&thread, NULL, run_ticker, NULL) != 0)
+		errx(1, "pthread_create failed");
+	pthread_detach(thread);
+	ticker_pid = getpid();
+}
+
+/****
+ * Set how long deadlines of a kind last
+ * ms: Milliseconds. 0 disables deadlines of the kind
+ * return: Nothing
+ ****/
+void deadline_set_timeout(enum deadline_kind kind, unsigned int ms) {
+	timeouts[kind] = ms;
+}
+
+unsigned int deadline_timeout(enum deadline_kind kind) {
+	return timeouts[kind];
+}
+
+void deadline_init(struct deadline *deadline) {
+	timer_init(&deadline->timer, expire);
+	deadline->fd = -1;
+	deadline->expired = 0;
+}
+
+/****
+ * Arm a deadline for a socket, replacing the deadline's previous expiry time and kind.
+ * Does nothing if deadlines of the kind are disabled
+ * fd: Socket to shut down when the deadline expires. Must stay open until the deadline is cancelled
+ * return: Nothing
+ ****/
+void deadline_arm(struct deadline *deadline, enum deadline_kind kind, int fd) {
+	if (timeouts[kind] == 0) {
+		deadline_cancel(deadline);
+		return;
+	}
+
+	pthread_mutex_lock(&lock);
+	if (ticker_pid != getpid())
+		start_ticker();
+	deadline->fd = fd;
+	deadline->kind = kind;
+	timer_arm(&wheel, &deadline->timer, current_tick() + (timeouts[kind] + TICK_MS - 1) / TICK_MS);
+	pthread_mutex_unlock(&lock);
+}
+
+/****
+ * Disarm a deadline. Once this returns, the deadline will not shut down its socket
+ * return: Nothing
+ ****/
+void deadline_cancel(struct deadline *deadline) {
+	if (ticker_pid != getpid())			// Nothing was armed in this process
+		return;
+	pthread_mutex_lock(&lock);
+	timer_cancel(&wheel, &deadline->timer);
+	pthread_mutex_unlock(&lock);
+}
+
+const char *deadline_name(enum deadline_kind kind) {
+	return DEADLINE_NAMES[kind];
+}
+
+unsigned long long deadline_expired_count(enum deadline_kind kind) {
+	return expired_counts[kind];
+}
@@ -0,0 +1,37 @@
+/*
+ * deadline.h - Read, write, idle, keep-alive and origin deadlines for blocking connections
+ */
+
+#ifndef _DEADLINE_H_
+#define _DEADLINE_H_
+
+#include <signal.h>
+#include "timer_wheel.h"
+
+enum deadline_kind {
+	DEADLINE_IDLE,				/* Client connection waiting for its TLS handshake or first request */
+	DEADLINE_KEEPALIVE,			/* Persistent client connection waiting for its next request */
+	DEADLINE_READ,				/* Client sending the rest of a request */
+	DEADLINE_WRITE,				/* Client taking a block of the response */
+	DEADLINE_ORIGIN,			/* Whole fetch from the server */
+	NUM_DEADLINE_KINDS
+};
+
+extern const char *DEADLINE_NAMES[];
+
+struct deadline {
+	struct timer timer;			/* Must be first */
+	int fd;					/* Socket shut down when the deadline expires */
+	enum deadline_kind kind;
+	volatile sig_atomic_t expired;		/* Set once the deadline has expired */
+};
+
+void deadline_set_timeout(enum deadline_kind kind, unsigned int ms);
+unsigned int deadline_timeout(enum deadline_kind kind);
+void deadline_init(struct deadline *deadline);
+void deadline_arm(struct deadline *deadline, enum deadline_kind kind, int fd);
+void deadline_cancel(struct deadline *deadline);
+const char *deadline_name(enum deadline_kind kind);
+unsigned long long deadline_expired_count(enum deadline_kind kind);
+
+#endif // _DEADLINE_H_
@@ -0,0 +1,134 @@
+/*
+ * hot.c - Detecting the objects that take a large share of a node's requests
+ *
+ * A Space-Saving sketch of HOT_COUNTERS counters, in memory shared by all of the
+ * proxy server's processes, counts the requests for the most requested names. A
+ * name without a counter takes over the smallest one and inherits its count as its
+ * error, so a counter's count minus its error never overstates a name's requests.
+ * The counts are halved every HOT_WINDOW requests so popularity that has passed
+ * fades. A name is hot when its guaranteed count is at least the configured share
+ * of the requests counted.
+ */
+
+#include <sys/types.h>
+#include <sys/mman.h>
+
+#include <err.h>
+#include <errno.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <string.h>
+#include "hot.h"
+
+#define HOT_COUNTERS 64
+
+const unsigned long long HOT_WINDOW = 20000;
+const unsigned long long HOT_MIN_REQUESTS = 200;	/* Nothing is hot before this many requests were counted */
+
+struct hot_counter {
+	char name[MAX_OBJECT_NAME + 1];
+	unsigned long long count;
+	unsigned long long error;		/* Count inherited from the name the counter was taken from */
+};
+
+static struct hot_sketch {
+	pthread_mutex_t lock;
+	unsigned long long total;		/* Requests counted since the last halving, halved with the counts */
+	unsigned int used;
+	struct hot_counter counters[HOT_COUNTERS];
+} *sketch;
+static unsigned int hot_share;			/* Percent of the requests that makes a name hot */
+
+static void lock_sketch() {
+	if (pthread_mutex_lock(&sketch->lock) == EOWNERDEAD)
+		pthread_mutex_consistent(&sketch->lock);	// A counter may miss the dead process's request
+}
+
+static int is_hot(const struct hot_counter *counter) {
+	return sketch->total >= HOT_MIN_REQUESTS && (counter->count - counter->error) * 100 >= hot_share * sketch->total;
+}
+
+/****
+ * Start detecting hot objects. Must be called before the processes that serve
+ * requests are forked
+ * share_percent: Share of the requests, in percent, that makes an object hot
+ * return: Nothing
+ ****/
+void hot_init(unsigned int share_percent) {
+	pthread_mutexattr_t attr;
+
+	if ((sketch = mmap(NULL, sizeof(*sketch), PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0)) == MAP_FAILED)
+		err(1, "mmap");
+	pthread_mutexattr_init(&attr);
+	pthread_mutexattr_setpshared(&attr, PTHREAD_PROCESS_SHARED);
+	pthread_mutexattr_setrobust(&attr, PTHREAD_MUTEX_ROBUST);
+	pthread_mutex_init(&sketch->lock, &attr);
+	pthread_mutexattr_destroy(&attr);
+	hot_share = share_percent;
+}
+
+/****
+ * Count a request for an object
+ * return: 1 if the object is hot. 0 if it is not or hot objects are not detected
+ ****/
+int hot_record(const char *object_name) {
+	struct hot_counter *counter = NULL;
+	unsigned int i;
+	int hot;
+
+	if (sketch == NULL)
+		return 0;
+	lock_sketch();
+	for (i = 0; i < sketch->used && counter == NULL; i++) {
+		if (strcmp(sketch->counters[i].name, object_name) == 0)
+			counter = &sketch->counters[i];
+	}
+	if (counter == NULL) {
+		if (sketch->used < HOT_COUNTERS) {
+			counter = &sketch->counters[sketch->used++];
+			counter->count = 0;
+		} else {
+			counter = &sketch->counters[0];
+			for (i = 1; i < HOT_COUNTERS; i++) {
+				if (sketch->counters[i].count < counter->count)
+					counter = &sketch->counters[i];
+			}
+		}
+		counter->error = counter->count;
+		snprintf(counter->name, sizeof(counter->name), "%s", object_name);
+	}
+	counter->count++;
+	sketch->total++;
+	hot = is_hot(counter);
+
+	if (sketch->total >= HOT_WINDOW) {
+		for (i = 0; i < sketch->used; i++) {
+			sketch->counters[i].count /= 2;
+			sketch->counters[i].error /= 2;
+		}
+		sketch->total /= 2;
+	}
+	pthread_mutex_unlock(&sketch->lock);
+	return hot;
+}
+
+/****
+ * List the objects that are hot now
+ * objects: Filled with up to max hot objects
+ * return: Number of objects listed
+ ****/
+unsigned int hot_list(struct hot_object *objects, unsigned int max) {
+	unsigned int i, count = 0;
+
+	if (sketch == NULL)
+		return 0;
+	lock_sketch();
+	for (i = 0; i < sketch->used && count < max; i++) {
+		if (!is_hot(&sketch->counters[i]))
+			continue;
+		strcpy(objects[count].name, sketch->counters[i].name);
+		objects[count++].share = (double)(sketch->counters[i].count - sketch->counters[i].error) / sketch->total;
+	}
+	pthread_mutex_unlock(&sketch->lock);
+	return count;
+}
@@ -0,0 +1,19 @@
+/*
+ * hot.h - Detecting the objects that take a large share of a node's requests
+ */
+
+#ifndef _HOT_H_
+#define _HOT_H_
+
+#include "protocol.h"
+
+struct hot_object {
+	char name[MAX_OBJECT_NAME + 1];
+	double share;				/* Estimated share of the recent requests, at least this */
+};
+
+void hot_init(unsigned int share_percent);
+int hot_record(const char *object_name);
+unsigned int hot_list(struct hot_object *objects, unsigned int max);
+
+#endif // _HOT_H_
@@ -0,0 +1,218 @@
+/*
+ * peer.c - Digests of the objects cached by the other nodes of the proxy server
+ *
+ * The nodes serving the six proxy servers are listed in a node table, one
+ * "proxyname host:port" line per proxy server, read as the client reads it. Every
+ * node other than this one is a peer. Each node summarizes the names in its cache
+ * in a Bloom filter, its digest, and keeps the latest digest of every peer. A miss
+ * whose name a peer's digest may contain is fetched from that peer before the
+ * server. Only the hosts of the peers may ask a node for its digest or its cached
+ * objects.
+ *
+ * The digests live in memory shared by all of the node's processes. One thread
+ * writes them and any process reads them. Each digest has a sequence number that is
+ * odd while the digest is being written, so a reader that overlapped a write sees
+ * the number change and ignores what it read.
+ */
+
+#include <sys/types.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+
+#include <err.h>
+#include <netdb.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "bloom.h"
+#include "cache.h"
+#include "log.h"
+#include "peer.h"
+#include "rendezvous.h"
+
+const unsigned int PEER_DIGEST_BITS = 1 << 20;		/* About 1% false positives at 100000 cached objects */
+const unsigned int PEER_DIGEST_INTS = (1 << 20) / 32;
+const unsigned int PEER_DIGEST_HASHES = 7;
+
+static struct peer *peers;			/* At most one per proxy server */
+static unsigned int num_peers;
+static struct in_addr *addresses;		/* Every address of every peer's host */
+static unsigned int num_addresses;
+static unsigned int *digests;		/* This node's digest, then every peer's, each after its sequence number */
+
+static unsigned int *digest(unsigned int slot) {
+	return &digests[slot * (PEER_DIGEST_INTS + 1)];
+}
+
+static void write_digest(unsigned int slot, const unsigned int *bits) {
+	unsigned int *sequence = digest(slot);
+
+	__atomic_add_fetch(sequence, 1, __ATOMIC_ACQ_REL);
+	if (bits != NULL)
+		memcpy(sequence + 1, bits, PEER_DIGEST_INTS * sizeof(unsigned int));
+	else
+		memset(sequence + 1, 0, PEER_DIGEST_INTS * sizeof(unsigned int));
+	__atomic_add_fetch(sequence, 1, __ATOMIC_RELEASE);
+}
+
+static struct peer *add_peer(const char *host, const char *port) {
+	unsigned int i;
+
+	for (i = 0; i < num_peers; i++) {
+		if (strcmp(peers[i].host, host) == 0 && strcmp(peers[i].port, port) == 0)
+			return &peers[i];
+	}
+	memset(&peers[num_peers], 0, sizeof(peers[num_peers]));
+	strcpy(peers[num_peers].host, host);
+	strcpy(peers[num_peers].port, port);
+	return &peers[num_peers++];
+}
+
+static void resolve_peer(const struct peer *peer) {
+	struct addrinfo hints, *res, *ai;
+	int error;
+
+	memset(&hints, 0, sizeof(hints));
+	hints.ai_family = AF_INET;			// The listening socket only accepts IPv4
+	hints.ai_socktype = SOCK_STREAM;
+	if ((error = getaddrinfo(peer->host, peer->port, &hints, &res)) != 0)
+		errx(1, "getaddrinfo %s: %s", peer->host, gai_strerror(error));
+	for (ai = res; ai != NULL; ai = ai->ai_next) {
+		if ((addresses = realloc(addresses, (num_addresses + 1) * sizeof(*addresses))) == NULL)
+			err(1, "realloc");
+		addresses[num_addresses++] = ((struct sockaddr_in *)ai->ai_addr)->sin_addr;
+	}
+	freeaddrinfo(res);
+}
+
+/****
+ * Read the node table, resolve the peers' hosts and map the digests. Must be called before the processes that
+ * serve requests are forked
+ * node_mask: Bit i set if this node serves PROXY_NAMES[i]. Nodes serving any other
+ *            proxy server are peers
+ * return: Nothing. Exits if the table is malformed or does not list every proxy server exactly once, or
+ * if a peer's host cannot be resolved
+ ****/
+void peer_init(const char *path, unsigned int node_mask) {
+	unsigned int i;
+	struct peer *peer;
+
+	if ((peers = calloc(NUM_PROXIES, sizeof(*peers))) == NULL)
+		err(1, "calloc");
+	nodes_load(path);
+	for (i = 0; i < NUM_PROXIES; i++) {
+		if (node_mask & (1u << i))
+			continue;
+		peer = add_peer(node_of(i)->host, node_of(i)->port);
+		snprintf(peer->names + strlen(peer->names), sizeof(peer->names) - strlen(peer->names), "%s%s",
+		    peer->names[0] ? "," : "", PROXY_NAMES[i]);
+	}
+
+	size_t size = (num_peers + 1) * (PEER_DIGEST_INTS + 1) * sizeof(unsigned int);
+	if ((digests = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0)) == MAP_FAILED)
+		err(1, "mmap");
+	for (i = 0; i < num_peers; i++) {
+		resolve_peer(&peers[i]);
+		log_info("Peer %s:%s serves proxy servers %s", peers[i].host, peers[i].port, peers[i].names);
+	}
+}
+
+/****
+ * Check whether a connection comes from the host of a peer
+ * sd: Accepted connection
+ * return: 1 if it does. 0 otherwise, and always if no node table was read
+ ****/
+int peer_connected(int sd) {
+	struct sockaddr_in addr;
+	socklen_t len = sizeof(addr);
+	unsigned int i;
+
+	if (num_addresses == 0 || getpeername(sd, (struct sockaddr *)&addr, &len) == -1 || addr.sin_family != AF_INET)
+		return 0;
+	for (i = 0; i < num_addresses; i++) {
+		if (addresses[i].s_addr == addr.sin_addr.s_addr)
+			return 1;
+	}
+	return 0;
+}
+
+/****
+ * return: Number of peers. 0 if no node table was read
+ ****/
+unsigned int peer_count(void) {
+	return num_peers;
+}
+
+/****
+ * return: A peer's address and proxy servers
+ ****/
+const struct peer *peer_get(unsigned int peer) {
+	return &peers[peer];
+}
+
+static void insert_name(const char *object_name, void *arg) {
+	insert_bloom_filter(arg, PEER_DIGEST_HASHES, PEER_DIGEST_BITS, object_name);
+}
+
+/****
+ * Rebuild this node's digest from the names in its cache
+ * return: Number of names in the digest
+ ****/
+unsigned int peer_build_digest(void) {
+	unsigned int *bits;
+	int count;
+
+	if ((bits = calloc(PEER_DIGEST_INTS, sizeof(*bits))) == NULL)
+		err(1, "calloc");
+	if ((count = cache_scan(insert_name, bits)) == -1)
+		count = 0;
+	write_digest(0, bits);
+	free(bits);
+	return count;
+}
+
+/****
+ * Copy this node's digest, for a peer that asked for it
+ * bits: PEER_DIGEST_INTS ints
+ * return: Nothing
+ ****/
+void peer_copy_digest(unsigned int *bits) {
+	unsigned int *sequence = digest(0);
+	unsigned int before;
+
+	do {
+		before = __atomic_load_n(sequence, __ATOMIC_ACQUIRE);
+		memcpy(bits, sequence + 1, PEER_DIGEST_INTS * sizeof(unsigned int));
+		__atomic_thread_fence(__ATOMIC_ACQUIRE);
+	} while ((before & 1) || __atomic_load_n(sequence, __ATOMIC_RELAXED) != before);
+}
+
+/****
+ * Replace a peer's digest
+ * bits: PEER_DIGEST_INTS ints. NULL to clear the digest of a peer that cannot be reached
+ * return: Nothing
+ ****/
+void peer_set_digest(unsigned int peer, const unsigned int *bits) {
+	write_digest(peer + 1, bits);
+}
+
+/****
+ * Find a peer that may have an object cached
+ * return: Index of the first peer whose digest may contain the object. -1 if none does
+ ****/
+int peer_find(const char *object_name) {
+	unsigned int i;
+
+	for (i = 0; i < num_peers; i++) {
+		unsigned int *sequence = digest(i + 1);
+		unsigned int before = __atomic_load_n(sequence, __ATOMIC_ACQUIRE);
+
+		if ((before & 1) || !search_bloom_filter(sequence + 1, PEER_DIGEST_HASHES, PEER_DIGEST_BITS, object_name))
+			continue;
+		__atomic_thread_fence(__ATOMIC_ACQUIRE);
+		if (__atomic_load_n(sequence, __ATOMIC_RELAXED) == before)
+			return i;
+	}
+	return -1;
+}
@@ -0,0 +1,28 @@
+/*
+ * peer.h - Digests of the objects cached by the other nodes of the proxy server
+ */
+
+#ifndef _PEER_H_
+#define _PEER_H_
+
+/* Another node, serving proxy servers this node does not */
+struct peer {
+	char host[256];
+	char port[16];
+	char names[64];				/* Proxy servers the peer serves, comma separated */
+};
+
+extern const unsigned int PEER_DIGEST_BITS;
+extern const unsigned int PEER_DIGEST_INTS;
+extern const unsigned int PEER_DIGEST_HASHES;
+
+void peer_init(const char *path, unsigned int node_mask);
+unsigned int peer_count(void);
+const struct peer *peer_get(unsigned int peer);
+unsigned int peer_build_digest(void);
+void peer_copy_digest(unsigned int *bits);
+void peer_set_digest(unsigned int peer, const unsigned int *bits);
+int peer_find(const char *object_name);
+int peer_connected(int sd);
+
+#endif // _PEER_H_
@@ -0,0 +1,460 @@
+/*
+ * policy.c - Cache eviction policies over a byte capacity: LRU, SLRU and W-TinyLFU
+ *
+ * Objects are identified by a 64-bit hash of their name and have a size in bytes.
+ * Each cached object occupies one of max_objects slots; the caller may keep its own
+ * data per slot, such as the object's name, and is told through a callback which
+ * slots are evicted. The policies only differ in the lists slots are kept on:
+ *
+ *   LRU       One list. A hit moves the object to the front, misses evict from the back.
+ *   SLRU      A probation list that misses enter and a protected list (80% of the
+ *             capacity) that a second hit promotes to. Objects pushed out of the
+ *             protected list go back to the front of probation. Misses evict from
+ *             the back of probation first.
+ *   TinyLFU   W-TinyLFU: misses enter an LRU window of 1% of the capacity. An object
+ *             pushed out of the window is admitted to an SLRU over the rest only if
+ *             it was requested more often than the objects it would evict, as
+ *             estimated by a count-min sketch of 4-bit counters that is halved every
+ *             10 * max_objects requests, so popularity ages.
+ *
+ * All of the state is in one block of memory sized by policy_size: a header, the
+ * slots, an open addressing hash table from key to slot and the sketch. Lists link
+ * slots by index, so the block can be shared by processes mapping it at different
+ * addresses.
+ */
+
+#include <limits.h>
+#include <string.h>
+#include "policy.h"
+
+#define NONE UINT_MAX
+#define SKETCH_ROWS 4
+#define SKETCH_MAX 15
+
+const unsigned int WINDOW_PERCENT = 1;
+const unsigned int PROTECTED_PERCENT = 80;
+const unsigned int SAMPLE_FACTOR = 10;
+const unsigned int MIN_OBJECTS = 1024;
+const unsigned int MAX_OBJECTS = 1 << 18;
+const unsigned int AVERAGE_OBJECT_SIZE = 4096;
+const char *const POLICY_NAMES[] = {"lru", "slru", "tinylfu"};
+
+enum segment {
+	SEGMENT_WINDOW,
+	SEGMENT_PROBATION,			/* The only list of LRU */
+	SEGMENT_PROTECTED,
+	NUM_SEGMENTS,
+	SEGMENT_NONE = NUM_SEGMENTS		/* Free, or between lists */
+};
+
+struct policy_entry {
+	uint64_t key;
+	unsigned long long size;
+	unsigned int prev;			/* Toward the most recently used end */
+	unsigned int next;			/* Toward the least recently used end. Also links free slots */
+	unsigned int segment;
+};
+
+struct segment_list {
+	unsigned int head;			/* Most recently used */
+	unsigned int tail;
+	unsigned long long bytes;
+	unsigned long long limit;
+};
+
+struct policy {
+	enum policy_kind kind;
+	unsigned int max_objects;
+	unsigned int count;
+	unsigned int free_head;
+	unsigned int inserting;			/* Slot of the object policy_access is caching. NONE outside it */
+	unsigned int table_mask;
+	unsigned int sketch_mask;		/* Counters per sketch row minus one */
+	unsigned long long capacity;
+	unsigned long long main_limit;		/* Bytes of the lists behind the window */
+	unsigned long long additions;		/* Sketch increments since it was last halved */
+	unsigned long long sample_size;
+	struct segment_list segments[NUM_SEGMENTS];
+};
+
+static unsigned int power_of_two(unsigned int n) {
+	unsigned int p = 16;
+
+	while (p < n)
+		p *= 2;
+	return p;
+}
+
+static struct policy_entry *entries(const struct policy *policy) {
+	return (struct policy_entry *)(policy + 1);
+}
+
+static unsigned int *table(const struct policy *policy) {
+	return (unsigned int *)(entries(policy) + policy->max_objects);
+}
+
+static uint64_t *sketch(const struct policy *policy) {
+	return (uint64_t *)(table(policy) + policy->table_mask + 1);
+}
+
+static uint64_t mix(uint64_t x) {
+	x ^= x >> 33;
+	x *= 0xff51afd7ed558ccdULL;
+	x ^= x >> 33;
+	x *= 0xc4ceb9fe1a85ec53ULL;
+	return x ^ (x >> 33);
+}
+
+/****
+ * Look up a name of a policy
+ * kind: Set to the policy named
+ * return: 0 on success. -1 if there is no policy of that name
+ ****/
+int policy_parse(const char *name, enum policy_kind *kind) {
+	unsigned int i;
+
+	for (i = 0; i < NUM_POLICIES; i++) {
+		if (strcmp(name, POLICY_NAMES[i]) == 0) {
+			*kind = i;
+			return 0;
+		}
+	}
+	return -1;
+}
+
+/****
+ * Choose how many objects a policy tracks for a capacity, assuming objects of
+ * AVERAGE_OBJECT_SIZE bytes within MIN_OBJECTS and MAX_OBJECTS
+ * return: The number of objects
+ ****/
+unsigned int policy_objects(unsigned long long capacity) {
+	unsigned long long max_objects = capacity / AVERAGE_OBJECT_SIZE;
+
+	if (max_objects < MIN_OBJECTS)
+		return MIN_OBJECTS;
+	if (max_objects > MAX_OBJECTS)
+		return MAX_OBJECTS;
+	return max_objects;
+}
+
+/****
+ * return: Bytes of memory a policy tracking up to max_objects objects needs
+ ****/
+size_t policy_size(unsigned int max_objects) {
+	return sizeof(struct policy) + max_objects * sizeof(struct policy_entry) +
+	    power_of_two(2 * max_objects) * sizeof(unsigned int) + SKETCH_ROWS * power_of_two(max_objects) / 16 * sizeof(uint64_t);
+}
+
+/****
+ * Start a policy with nothing cached
+ * policy: Memory of policy_size(max_objects) bytes
+ * capacity: Bytes the cached objects may take up
+ * max_objects: Number of objects that may be cached, whatever their size
+ * return: Nothing
+ ****/
+void policy_init(struct policy *policy, enum policy_kind kind, unsigned long long capacity, unsigned int max_objects) {
+	unsigned int i;
+
+	memset(policy, 0, policy_size(max_objects));
+	policy->kind = kind;
+	policy->max_objects = max_objects;
+	policy->table_mask = power_of_two(2 * max_objects) - 1;
+	policy->sketch_mask = power_of_two(max_objects) - 1;
+	policy->capacity = capacity;
+	policy->sample_size = (unsigned long long)SAMPLE_FACTOR * max_objects;
+	for (i = 0; i < NUM_SEGMENTS; i++)
+		policy->segments[i].head = policy->segments[i].tail = NONE;
+
+	policy->main_limit = capacity;
+	if (kind == POLICY_TINYLFU) {
+		policy->segments[SEGMENT_WINDOW].limit = capacity * WINDOW_PERCENT / 100;
+		policy->main_limit -= policy->segments[SEGMENT_WINDOW].limit;
+	}
+	policy->segments[SEGMENT_PROTECTED].limit = policy->main_limit * PROTECTED_PERCENT / 100;
+
+	for (i = 0; i < max_objects; i++) {
+		entries(policy)[i].segment = SEGMENT_NONE;
+		entries(policy)[i].next = i + 1 < max_objects ? i + 1 : NONE;
+	}
+	policy->free_head = max_objects > 0 ? 0 : NONE;
+	policy->inserting = NONE;
+}
+
+/**** Hash table from key to slot. Linear probing with backward shift deletion ****/
+
+static unsigned int find(const struct policy *policy, uint64_t key) {
+	const unsigned int *slots = table(policy);
+	unsigned int i;
+
+	for (i = mix(key) & policy->table_mask; slots[i] != 0; i = (i + 1) & policy->table_mask) {
+		if (entries(policy)[slots[i] - 1].key == key)
+			return slots[i] - 1;
+	}
+	return NONE;
+}
+
+static void table_insert(struct policy *policy, uint64_t key, unsigned int slot) {
+	unsigned int *slots = table(policy);
+	unsigned int i;
+
+	for (i = mix(key) & policy->table_mask; slots[i] != 0; i = (i + 1) & policy->table_mask)
+		;
+	slots[i] = slot + 1;
+}
+
+static void table_delete(struct policy *policy, uint64_t key) {
+	unsigned int *slots = table(policy);
+	unsigned int mask = policy->table_mask;
+	unsigned int i, j, home;
+
+	for (i = mix(key) & mask; entries(policy)[slots[i] - 1].key != key; i = (i + 1) & mask)
+		;
+	for (j = (i + 1) & mask; slots[j] != 0; j = (j + 1) & mask) {
+		home = mix(entries(policy)[slots[j] - 1].key) & mask;
+		if (((j - home) & mask) >= ((j - i) & mask)) {	// The hole is between the entry's home and its position
+			slots[i] = slots[j];
+			i = j;
+		}
+	}
+	slots[i] = 0;
+}
+
+/**** Lists ****/
+
+static void unlink_slot(struct policy *policy, unsigned int slot) {
+	struct policy_entry *entry = &entries(policy)[slot];
+	struct segment_list *list = &policy->segments[entry->segment];
+
+	if (entry->prev != NONE)
+		entries(policy)[entry->prev].next = entry->next;
+	else
+		list->head = entry->next;
+	if (entry->next != NONE)
+		entries(policy)[entry->next].prev = entry->prev;
+	else
+		list->tail = entry->prev;
+	list->bytes -= entry->size;
+	entry->segment = SEGMENT_NONE;
+}
+
+static void push_front(struct policy *policy, enum segment segment, unsigned int slot) {
+	struct policy_entry *entry = &entries(policy)[slot];
+	struct segment_list *list = &policy->segments[segment];
+
+	entry->segment = segment;
+	entry->prev = NONE;
+	entry->next = list->head;
+	if (list->head != NONE)
+		entries(policy)[list->head].prev = slot;
+	else
+		list->tail = slot;
+	list->head = slot;
+	list->bytes += entry->size;
+}
+
+static void evict(struct policy *policy, unsigned int slot, policy_evict_fn evict_fn, void *arg) {
+	struct policy_entry *entry = &entries(policy)[slot];
+
+	if (entry->segment != SEGMENT_NONE)
+		unlink_slot(policy, slot);
+	table_delete(policy, entry->key);
+	entry->next = policy->free_head;
+	policy->free_head = slot;
+	policy->count--;
+	if (evict_fn != NULL && slot != policy->inserting)	// The caller has not named the object being cached yet
+		evict_fn(slot, arg);
+}
+
+/**** Frequency sketch ****/
+
+static unsigned int counter_position(const struct policy *policy, uint64_t key, unsigned int row) {
+	return row * (policy->sketch_mask + 1) + (mix(key + row * 0x9e3779b97f4a7c15ULL) & policy->sketch_mask);
+}
+
+static unsigned int frequency(const struct policy *policy, uint64_t key) {
+	unsigned int row, min = SKETCH_MAX;
+
+	for (row = 0; row < SKETCH_ROWS; row++) {
+		unsigned int pos = counter_position(policy, key, row);
+		unsigned int count = (sketch(policy)[pos / 16] >> (pos % 16 * 4)) & 0xf;
+		if (count < min)
+			min = count;
+	}
+	return min;
+}
+
+static void increment(struct policy *policy, uint64_t key) {
+	uint64_t *counters = sketch(policy);
+	unsigned int row, i;
+
+	for (row = 0; row < SKETCH_ROWS; row++) {
+		unsigned int pos = counter_position(policy, key, row);
+		if (((counters[pos / 16] >> (pos % 16 * 4)) & 0xf) < SKETCH_MAX)
+			counters[pos / 16] += 1ULL << (pos % 16 * 4);
+	}
+	if (++policy->additions < policy->sample_size)
+		return;
+	for (i = 0; i < SKETCH_ROWS * (policy->sketch_mask + 1) / 16; i++)	// Age every counter by halving it
+		counters[i] = (counters[i] >> 1) & 0x7777777777777777ULL;
+	policy->additions /= 2;
+}
+
+/**** Policies ****/
+
+/****
+ * Evict the least valuable object to free a slot
+ * return: Nothing
+ ****/
+static void evict_any(struct policy *policy, policy_evict_fn evict_fn, void *arg) {
+	const enum segment order[] = {SEGMENT_PROBATION, SEGMENT_PROTECTED, SEGMENT_WINDOW};
+	unsigned int i;
+
+	for (i = 0; i < NUM_SEGMENTS; i++) {
+		if (policy->segments[order[i]].tail != NONE) {
+			evict(policy, policy->segments[order[i]].tail, evict_fn, arg);
+			return;
+		}
+	}
+}
+
+/****
+ * Keep the protected list within its limit by moving its least recently used
+ * objects back to probation
+ * return: Nothing
+ ****/
+static void demote_protected(struct policy *policy) {
+	struct segment_list *protected = &policy->segments[SEGMENT_PROTECTED];
+
+	while (protected->bytes > protected->limit) {
+		unsigned int slot = protected->tail;
+		unlink_slot(policy, slot);
+		push_front(policy, SEGMENT_PROBATION, slot);
+	}
+}
+
+static void hit(struct policy *policy, unsigned int slot) {
+	enum segment segment = entries(policy)[slot].segment;
+
+	unlink_slot(policy, slot);
+	if (policy->kind != POLICY_LRU && segment == SEGMENT_PROBATION) {
+		push_front(policy, SEGMENT_PROTECTED, slot);
+		demote_protected(policy);
+	} else {
+		push_front(policy, segment, slot);
+	}
+}
+
+/****
+ * Evict from the back of probation, then of the protected list, until the lists
+ * behind the window fit their limit. The object just added is kept
+ * return: Nothing
+ ****/
+static void evict_main(struct policy *policy, unsigned int keep, policy_evict_fn evict_fn, void *arg) {
+	struct segment_list *probation = &policy->segments[SEGMENT_PROBATION];
+	struct segment_list *protected = &policy->segments[SEGMENT_PROTECTED];
+
+	while (probation->bytes + protected->bytes > policy->main_limit) {
+		unsigned int victim = probation->tail != keep ? probation->tail : protected->tail;
+		if (victim == NONE)
+			victim = probation->tail;
+		evict(policy, victim, evict_fn, arg);
+	}
+}
+
+/****
+ * Offer an object pushed out of the TinyLFU window to the lists behind it. It
+ * takes the place of the objects it would push out only if it is more popular
+ * than each of them
+ * return: Nothing
+ ****/
+static void admit(struct policy *policy, unsigned int candidate, policy_evict_fn evict_fn, void *arg) {
+	struct segment_list *probation = &policy->segments[SEGMENT_PROBATION];
+	struct segment_list *protected = &policy->segments[SEGMENT_PROTECTED];
+	unsigned long long size = entries(policy)[candidate].size;
+	unsigned int popularity = frequency(policy, entries(policy)[candidate].key);
+
+	if (size > policy->main_limit) {
+		evict(policy, candidate, evict_fn, arg);
+		return;
+	}
+	while (probation->bytes + protected->bytes + size > policy->main_limit) {
+		unsigned int victim = probation->tail != NONE ? probation->tail : protected->tail;
+		if (popularity <= frequency(policy, entries(policy)[victim].key)) {
+			evict(policy, candidate, evict_fn, arg);
+			return;
+		}
+		evict(policy, victim, evict_fn, arg);
+	}
+	push_front(policy, SEGMENT_PROBATION, candidate);
+}
+
+/****
+ * Record a request for an object, caching it if it is not cached
+ * key: Hash of the object's name
+ * size: Size of the object. Only used if it is not cached
+ * slot: Set to the object's slot if it is cached once the request is recorded
+ * evict: Called with the slot of every other object evicted, before the slot is reused. May be NULL
+ * return: Whether the object was cached, is now cached, or could not be cached. An object
+ * evicted again while it is being cached was not admitted
+ ****/
+enum policy_result policy_access(struct policy *policy, uint64_t key, unsigned long long size, unsigned int *slot,
+    policy_evict_fn evict_fn, void *arg)
+{
+	struct policy_entry *entry;
+	unsigned int s;
+
+	if (policy->kind == POLICY_TINYLFU)
+		increment(policy, key);
+	if ((s = find(policy, key)) != NONE) {
+		hit(policy, s);
+		*slot = s;
+		return POLICY_HIT;
+	}
+	if (size > policy->capacity || policy->max_objects == 0)
+		return POLICY_REJECTED;
+
+	if (policy->free_head == NONE)
+		evict_any(policy, evict_fn, arg);
+	s = policy->free_head;
+	entry = &entries(policy)[s];
+	policy->free_head = entry->next;
+	entry->key = key;
+	entry->size = size;
+	table_insert(policy, key, s);
+	policy->count++;
+	policy->inserting = s;
+
+	if (policy->kind != POLICY_TINYLFU) {
+		push_front(policy, SEGMENT_PROBATION, s);
+		evict_main(policy, s, evict_fn, arg);
+	} else {
+		struct segment_list *window = &policy->segments[SEGMENT_WINDOW];
+
+		push_front(policy, SEGMENT_WINDOW, s);
+		while (window->bytes > window->limit) {
+			unsigned int candidate = window->tail;
+			unlink_slot(policy, candidate);
+			admit(policy, candidate, evict_fn, arg);
+		}
+	}
+	policy->inserting = NONE;
+	if (find(policy, key) == NONE)
+		return POLICY_REJECTED;
+	*slot = s;
+	return POLICY_ADMITTED;
+}
+
+/****
+ * return: Bytes taken up by the cached objects
+ ****/
+unsigned long long policy_used(const struct policy *policy) {
+	return policy->segments[SEGMENT_WINDOW].bytes + policy->segments[SEGMENT_PROBATION].bytes +
+	    policy->segments[SEGMENT_PROTECTED].bytes;
+}
+
+/****
+ * return: Number of cached objects
+ ****/
+unsigned int policy_count(const struct policy *policy) {
+	return policy->count;
+}
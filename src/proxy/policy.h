@@ -0,0 +1,45 @@
+/*
+ * policy.h - Cache eviction policies over a byte capacity: LRU, SLRU and W-TinyLFU
+ */
+
+#ifndef _POLICY_H_
+#define _POLICY_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define POLICY_SEED 0x2b1			/* Seed of the hash of an object's name its policy key is taken from */
+
+enum policy_kind {
+	POLICY_LRU,				/* Least recently used */
+	POLICY_SLRU,				/* Segmented LRU: a probation and a protected segment */
+	POLICY_TINYLFU,				/* W-TinyLFU: an LRU window in front of an SLRU admitted to by frequency */
+	NUM_POLICIES
+};
+
+enum policy_result {
+	POLICY_HIT,				/* The object was cached */
+	POLICY_ADMITTED,			/* The object was not cached and now is */
+	POLICY_REJECTED				/* The object was not cached and was not admitted */
+};
+
+/*
+ * A policy's state holds no pointers, so it can be placed in memory shared by
+ * several processes. It is not locked: callers serialize access to it
+ */
+struct policy;
+
+typedef void (*policy_evict_fn)(unsigned int slot, void *arg);
+
+extern const char *const POLICY_NAMES[];
+
+int policy_parse(const char *name, enum policy_kind *kind);
+unsigned int policy_objects(unsigned long long capacity);
+size_t policy_size(unsigned int max_objects);
+void policy_init(struct policy *policy, enum policy_kind kind, unsigned long long capacity, unsigned int max_objects);
+enum policy_result policy_access(struct policy *policy, uint64_t key, unsigned long long size, unsigned int *slot,
+    policy_evict_fn evict, void *arg);
+unsigned long long policy_used(const struct policy *policy);
+unsigned int policy_count(const struct policy *policy);
+
+#endif // _POLICY_H_
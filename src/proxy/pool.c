@@ -0,0 +1,272 @@
+/*
+ * pool.c - Thread pools separating TLS handshakes from request processing
+ *
+ * The calling thread accepts connections and queues them for a small pool of
+ * handshake threads. A handshake thread completes the TLS handshake and queues the
+ * established session for the transfer threads, which run the request. A burst of
+ * new connections therefore only competes with other handshakes, and sessions that
+ * are already transferring data keep their threads.
+ *
+ * Every STATS_INTERVAL seconds with activity, the depth of both queues and the
+ * latency of handshakes (from accept until the session is established) and of
+ * requests (from the session being picked up until it is closed) are reported
+ * separately.
+ */
+
+#include <sys/types.h>
+#include <sys/socket.h>
+
+#include <err.h>
+#include <errno.h>
+#include <pthread.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include "deadline.h"
+#include "latency.h"
+#include "log.h"
+#include "pool.h"
+#include "stages.h"
+
+const unsigned int HANDSHAKE_QUEUE_LEN = 1024;
+const unsigned int SESSIONS_PER_TRANSFER_THREAD = 4;
+const unsigned int STATS_INTERVAL = 10;
+
+struct pending {
+	int fd;
+	struct tls *cctx;			/* Established session. NULL until the handshake is done */
+	struct timespec accepted;		/* Time the connection was accepted */
+	struct timespec established;		/* Time the handshake completed */
+};
+
+/* Bounded FIFO of connections handed from one stage to the next */
+struct queue {
+	struct pending *items;
+	unsigned int capacity;
+	unsigned int head;
+	unsigned int count;
+	unsigned int max_count;			/* Deepest the queue got since the last report */
+	pthread_mutex_t lock;
+	pthread_cond_t not_empty;
+	pthread_cond_t not_full;
+};
+
+struct stage_stats {
+	pthread_mutex_t lock;
+	unsigned long long count;
+	unsigned long long failures;
+	double total_ms;
+	double max_ms;
+};
+
+static struct queue handshake_queue;
+static struct queue session_queue;
+static struct stage_stats handshake_stats = { PTHREAD_MUTEX_INITIALIZER, 0, 0, 0, 0 };
+static struct stage_stats request_stats = { PTHREAD_MUTEX_INITIALIZER, 0, 0, 0, 0 };
+static struct tls *server_ctx;
+static session_handler handle_session;
+static void *handler_arg;
+
+static void queue_init(struct queue *queue, unsigned int capacity) {
+	memset(queue, 0, sizeof(*queue));
+	if ((queue->items = calloc(capacity, sizeof(*queue->items))) == NULL)
+		err(1, "calloc");
+	queue->capacity = capacity;
+	pthread_mutex_init(&queue->lock, NULL);
+	pthread_cond_init(&queue->not_empty, NULL);
+	pthread_cond_init(&queue->not_full, NULL);
+}
+
+/****
+ * Add a connection to a queue, waiting while the queue is full
+ * return: Nothing
+ ****/
+static void queue_push(struct queue *queue, const struct pending *item) {
+	pthread_mutex_lock(&queue->lock);
+	while (queue->count == queue->capacity)
+		pthread_cond_wait(&queue->not_full, &queue->lock);
+	queue->items[(queue->head + queue->count) % queue->capacity] = *item;
+	if (++queue->count > queue->max_count)
+		queue->max_count = queue->count;
+	pthread_cond_signal(&queue->not_empty);
+	pthread_mutex_unlock(&queue->lock);
+}
+
+/****
+ * Take the oldest connection from a queue, waiting while the queue is empty
+ * return: Nothing
+ ****/
+static void queue_pop(struct queue *queue, struct pending *item) {
+	pthread_mutex_lock(&queue->lock);
+	while (queue->count == 0)
+		pthread_cond_wait(&queue->not_empty, &queue->lock);
+	*item = queue->items[queue->head];
+	queue->head = (queue->head + 1) % queue->capacity;
+	queue->count--;
+	pthread_cond_signal(&queue->not_full);
+	pthread_mutex_unlock(&queue->lock);
+}
+
+/****
+ * Get a queue's current and maximum depth, starting a new maximum
+ * return: Nothing
+ ****/
+static void queue_depth(struct queue *queue, unsigned int *count, unsigned int *max_count) {
+	pthread_mutex_lock(&queue->lock);
+	*count = queue->count;
+	*max_count = queue->max_count;
+	queue->max_count = queue->count;
+	pthread_mutex_unlock(&queue->lock);
+}
+
+static double elapsed_ms(const struct timespec *start, const struct timespec *end) {
+	return (end->tv_sec - start->tv_sec) * 1000.0 + (end->tv_nsec - start->tv_nsec) / 1000000.0;
+}
+
+static void record(struct stage_stats *stats, double ms, int failed) {
+	pthread_mutex_lock(&stats->lock);
+	if (failed) {
+		stats->failures++;
+	} else {
+		stats->count++;
+		stats->total_ms += ms;
+		if (ms > stats->max_ms)
+			stats->max_ms = ms;
+	}
+	pthread_mutex_unlock(&stats->lock);
+}
+
+/****
+ * Print a stage's statistics and start a new interval
+ * return: 1 if the stage had any activity. 0 otherwise
+ ****/
+static int report_stage(struct stage_stats *stats, const char *name) {
+	pthread_mutex_lock(&stats->lock);
+	int active = stats->count > 0 || stats->failures > 0;
+	if (active)
+		log_info("%s: %llu done, %llu failed, mean %.2f ms, max %.2f ms", name, stats->count, stats->failures,
+		    stats->count ? stats->total_ms / stats->count : 0.0, stats->max_ms);
+	stats->count = stats->failures = 0;
+	stats->total_ms = stats->max_ms = 0;
+	pthread_mutex_unlock(&stats->lock);
+	return active;
+}
+
+static void *run_reporter(void *arg) {
+	for (;;) {
+		unsigned int handshakes, max_handshakes, sessions, max_sessions;
+
+		sleep(STATS_INTERVAL);
+		int active = report_stage(&handshake_stats, "Handshakes");
+		active |= report_stage(&request_stats, "Requests");
+		if (!active)
+			continue;
+		queue_depth(&handshake_queue, &handshakes, &max_handshakes);
+		queue_depth(&session_queue, &sessions, &max_sessions);
+		log_info("Handshake queue depth %u (max %u), established session queue depth %u (max %u)", handshakes,
+		    max_handshakes, sessions, max_sessions);
+	}
+	return NULL;
+}
+
+static void *run_handshakes(void *arg) {
+	for (;;) {
+		struct pending item;
+		struct deadline idle;
+		int ret;
+
+		queue_pop(&handshake_queue, &item);
+		unsigned long long started = latency_record(STAGE_ACCEPT,
+		    item.accepted.tv_sec * 1000000000ULL + item.accepted.tv_nsec);
+		if (tls_accept_socket(server_ctx, &item.cctx, item.fd) != 0) {
+			warnx("tls_accept_socket: %s", tls_error(server_ctx));
+			close(item.fd);
+			record(&handshake_stats, 0, 1);
+			continue;
+		}
+		deadline_init(&idle);
+		deadline_arm(&idle, DEADLINE_IDLE, item.fd);	// A client that stalls its handshake must not hold the thread
+		do {
+			ret = tls_handshake(item.cctx);
+		} while (ret == TLS_WANT_POLLIN || ret == TLS_WANT_POLLOUT);
+		deadline_cancel(&idle);
+		if (ret != 0) {
+			tls_free(item.cctx);
+			close(item.fd);
+			record(&handshake_stats, 0, 1);
+			continue;
+		}
+
+		clock_gettime(CLOCK_MONOTONIC, &item.established);
+		record(&handshake_stats, elapsed_ms(&item.accepted, &item.established), 0);
+		latency_record(STAGE_HANDSHAKE, started);
+		latency_flush();
+		queue_push(&session_queue, &item);
+	}
+	return NULL;
+}
+
+static void *run_transfers(void *arg) {
+	for (;;) {
+		struct pending item;
+		struct timespec start, end;
+
+		queue_pop(&session_queue, &item);
+		clock_gettime(CLOCK_MONOTONIC, &start);
+		handle_session(item.cctx, item.fd, handler_arg);
+		clock_gettime(CLOCK_MONOTONIC, &end);
+		record(&request_stats, elapsed_ms(&start, &end), 0);
+	}
+	return NULL;
+}
+
+static void start_threads(unsigned int count, void *(*run)(void *)) {
+	unsigned int i;
+
+	for (i = 0; i < count; i++) {
+		pthread_t thread;
+		if (pthread_create(&thread, NULL, run, NULL) != 0)
+			errx(1, "pthread_create failed");
+		pthread_detach(thread);
+	}
+}
+
+/****
+ * Serve connections with a handshake pool feeding a transfer pool
+ * sd: Listening socket
+ * ctx: Configured TLS server context
+ * handler: Called on a transfer thread for every established session
+ * arg: Passed to handler
+ * return: Never returns
+ ****/
+void pool_run(int sd, struct tls *ctx, unsigned int num_handshake_threads, unsigned int num_transfer_threads,
+    session_handler handler, void *arg) {
+	signal(SIGPIPE, SIG_IGN);		// A client hanging up must not take down every session's process
+	server_ctx = ctx;
+	handle_session = handler;
+	handler_arg = arg;
+	queue_init(&handshake_queue, HANDSHAKE_QUEUE_LEN);
+	queue_init(&session_queue, num_transfer_threads * SESSIONS_PER_TRANSFER_THREAD);
+
+	start_threads(num_handshake_threads, run_handshakes);
+	start_threads(num_transfer_threads, run_transfers);
+	start_threads(1, run_reporter);
+	log_info("Serving connections with %u handshake threads and %u transfer threads", num_handshake_threads,
+	    num_transfer_threads);
+
+	for (;;) {
+		struct pending item;
+
+		memset(&item, 0, sizeof(item));
+		if ((item.fd = accept(sd, NULL, NULL)) == -1) {
+			if (errno == EINTR || errno == ECONNABORTED)
+				continue;
+			err(1, "accept failed");
+		}
+		clock_gettime(CLOCK_MONOTONIC, &item.accepted);
+		queue_push(&handshake_queue, &item);
+	}
+}
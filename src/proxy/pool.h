@@ -0,0 +1,16 @@
+/*
+ * pool.h - Thread pools separating TLS handshakes from request processing
+ */
+
+#ifndef _POOL_H_
+#define _POOL_H_
+
+#include <tls.h>
+
+/* Serves one established TLS session. Must close the socket and free the session */
+typedef void (*session_handler)(struct tls *cctx, int clientsd, void *arg);
+
+void pool_run(int sd, struct tls *ctx, unsigned int num_handshake_threads, unsigned int num_transfer_threads,
+    session_handler handler, void *arg);
+
+#endif // _POOL_H_
@@ -25,71 +25,146 @@
  *
  */
 
+#define _GNU_SOURCE
+
 #include <sys/types.h>
+#include <sys/mman.h>
 #include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/time.h>
+#include <sys/un.h>
 #include <sys/wait.h>
 #include <netinet/in.h>
+#include <netinet/tcp.h>
 
 #include <err.h>
 #include <errno.h>
 #include <limits.h>
+#include <netdb.h>
+#include <poll.h>
+#include <pthread.h>
 #include <signal.h>
+#include <stddef.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <time.h>
 #include <unistd.h>
 #include <tls.h>
-#include "murmur3.h"
+#include "admission.h"
+#include "aio.h"
+#include "bloom.h"
+#include "cache.h"
+#include "capture.h"
+#include "counters.h"
+#include "deadline.h"
+#include "hot.h"
+#include "latency.h"
+#include "log.h"
+#include "metrics.h"
+#include "options.h"
+#include "peer.h"
+#include "pool.h"
+#include "protocol.h"
+#include "rendezvous.h"
+#include "shard.h"
+#include "stages.h"
+#include "trace.h"
 
 
 const unsigned int NUM_PROXIES = 6;
 const char *PROXY_NAMES[] = {"one", "two", "three", "four", "five", "six"};
+const char *const STAGE_NAMES[] = {"accept", "handshake", "request_read", "bloom_check", "cache_lookup", "origin_connect",
+    "origin_transfer", "batch_wait", "client_write", "close"};
+const char *const ORIGIN_FETCH_KINDS[] = {"single", "batch"};
+const char *const PEER_RESULTS[] = {"hit", "miss", "error"};
+const char *const ADMISSION_OUTCOMES[] = {"admitted", "queued", "dequeued", "shed_queue_full", "shed_deadline",
+    "shed_client_rate"};
+const char *const ADMISSION_OPTIONS[] = {"-max-in-flight", "-queue", "-queue-timeout", "-client-rate", "-client-burst"};
+const struct metric COUNTERS[] = {
+	{"tlscache_proxy_requests_total", "Requests received per logical proxy server", METRIC_COUNTER, "proxy", PROXY_NAMES,
+	    sizeof(PROXY_NAMES) / sizeof(PROXY_NAMES[0])},
+	{"tlscache_proxy_invalid_requests_total", "Malformed requests and requests for unknown proxy servers or invalid names",
+	    METRIC_COUNTER, NULL, NULL, 0},
+	{"tlscache_proxy_blacklisted_total", "Requests denied by the blacklist", METRIC_COUNTER, "proxy", PROXY_NAMES,
+	    sizeof(PROXY_NAMES) / sizeof(PROXY_NAMES[0])},
+	{"tlscache_proxy_cache_hits_total", "Requests answered from the cache without contacting the server first",
+	    METRIC_COUNTER, "proxy", PROXY_NAMES, sizeof(PROXY_NAMES) / sizeof(PROXY_NAMES[0])},
+	{"tlscache_proxy_cache_misses_total", "Requests that fetched or revalidated the object from the server first",
+	    METRIC_COUNTER, "proxy", PROXY_NAMES, sizeof(PROXY_NAMES) / sizeof(PROXY_NAMES[0])},
+	{"tlscache_proxy_cache_evictions_total", "Objects removed from the cache by the eviction policy", METRIC_COUNTER,
+	    NULL, NULL, 0},
+	{"tlscache_proxy_origin_fetches_total", "Requests sent to the server", METRIC_COUNTER, "kind", ORIGIN_FETCH_KINDS, 2},
+	{"tlscache_proxy_peer_fetches_total", "Misses fetched from a peer whose digest may contain the object, by result",
+	    METRIC_COUNTER, "result", PEER_RESULTS, 3},
+	{"tlscache_proxy_peer_requests_total", "Requests from peers, by whether the object was cached", METRIC_COUNTER,
+	    "result", PEER_RESULTS, 2},
+	{"tlscache_proxy_hot_responses_total", "Responses that advertised a hot object to the client", METRIC_COUNTER, NULL,
+	    NULL, 0},
+	{"tlscache_proxy_bytes_served_total", "Object bytes sent to clients", METRIC_COUNTER, NULL, NULL, 0},
+	{"tlscache_proxy_open_connections", "Established client sessions", METRIC_GAUGE, NULL, NULL, 0},
+	{"tlscache_proxy_deadlines_expired_total", "Deadlines that expired and shut down their connection", METRIC_COUNTER,
+	    "kind", DEADLINE_NAMES, NUM_DEADLINE_KINDS},
+	{"tlscache_proxy_admission_total", "Connections by admission outcome when forking per connection", METRIC_COUNTER,
+	    "outcome", ADMISSION_OUTCOMES, 6},
+};
 const char PROXY_DIR[] = "./proxy_files/";
 const char BLACKLIST_FILENAME[] = "Blacklisted_Objects";
-const unsigned int NUM_BLOOM_BITS = 303658;
-const unsigned int NUM_BLOOM_INTS = 10000;
-const unsigned int NUM_BLOOM_HASHES = 5;
+const unsigned int DEFAULT_TTL = 300;
+const unsigned int MAX_FETCH_ATTEMPTS = 8;
+const long long MARK_INTERVAL = 16 * 1024 * 1024;
+const unsigned int NUM_IO_BUFFERS = 4;
+const unsigned int DEFAULT_BATCH_WINDOW = 2;
+const unsigned int MAX_SHARDS = 256;
+const unsigned int MAX_WORKERS = 1024;
+const unsigned int DEFAULT_HANDSHAKE_THREADS = 2;
+const size_t HUGE_PAGE_SIZE = 2 * 1024 * 1024;
+const int BATCH_RECV_TIMEOUT_MS = 100;
+const unsigned int DEFAULT_PEER_INTERVAL = 5;
+const unsigned int DEFAULT_HOT_SHARE = 5;
+const unsigned int MAX_HOT_OBJECTS = 64;
+const unsigned int DEFAULT_MAX_IN_FLIGHT = 256;
+const unsigned int DEFAULT_ADMISSION_QUEUE = 1024;
+const unsigned int DEFAULT_QUEUE_TIMEOUT = 1000;
+const unsigned int DEFAULT_CLIENT_BURST = 10;
+const int ACCEPT_POLL_MS = 1000;
+const unsigned int DEFAULT_IDLE_TIMEOUT = 30000;
+const unsigned int DEFAULT_KEEPALIVE_TIMEOUT = 5000;
+const unsigned int DEFAULT_READ_TIMEOUT = 10000;
+const unsigned int DEFAULT_WRITE_TIMEOUT = 10000;
+const unsigned int DEFAULT_ORIGIN_TIMEOUT = 30000;
 
-/****
- * Insert a string into a bloom filter
- * bloom_filter: An array of ints. Each bit in each int is a slot in the bloom filter
- * num_hashes: Number of hash functions
- * num_bits: Number of slots in the bloom filter
- * return: Nothing
- ****/
-static void insert_bloom_filter(unsigned int bloom_filter[], unsigned int num_hashes, unsigned int num_bits, char str[]) {
-	unsigned int int_bit_size = sizeof(unsigned int) * 8;
-	
-	unsigned int i;
-	for (i = 0; i < num_hashes; i++) {
-		uint32_t hash[4];
-		MurmurHash3_x86_32(str, strlen(str), i + 46, hash);
-		unsigned int index = (*hash % num_bits) / int_bit_size;
-		bloom_filter[index] |= (1 << (*hash % int_bit_size));	
-	}
-}
+enum fetch_status {
+	FETCH_ERROR = -1,
+	FETCH_OK,
+	FETCH_NOT_MODIFIED,
+	FETCH_NOT_FOUND,
+	FETCH_BAD_RANGE
+};
 
-/****
- * Check if a string has been inserted into a bloom filter
- * bloom_filter: An array of ints. Each bit in each int is a slot in the bloom filter
- * num_hashes: Number of hash functions
- * num_bits: Number of slots in the bloom filter
- * return: 1 if string has been inserted. 0 if string has not been inserted
- ****/
-static unsigned int search_bloom_filter(unsigned int bloom_filter[], unsigned int num_hashes, unsigned int num_bits, char str[]) {
-	unsigned int int_bit_size = sizeof(unsigned int) * 8;
-	
-	unsigned int i;
-	for (i = 0; i < num_hashes; i++) {
-		uint32_t hash[4];
-		MurmurHash3_x86_32(str, strlen(str), i + 46, hash);
-		unsigned int index = (*hash % num_bits) / int_bit_size;
-		if ((bloom_filter[index] & (1 << (*hash % int_bit_size))) == 0)
-			return 0;
-	}
+static char *server_name;
+static char *server_port;
+static unsigned int stale_while_revalidate = 0;
+static enum aio_backend disk_io_backend = AIO_URING;
+static __thread struct aio_ctx *disk_io = NULL;
+static unsigned int batch_window = DEFAULT_BATCH_WINDOW;	/* Milliseconds misses are collected for a batch. 0 disables batching */
+static struct sockaddr_un batch_addr;
+static socklen_t batch_addr_len;
+static int revalidate_fd = -1;				/* Stale objects are sent to the revalidation process on it. -1 without -swr */
+static const unsigned int *blacklist_filters;		/* For the Bloom filter statistics on the admin port */
+static unsigned long trace_sample = 0;			/* One in this many requests without a trace field is sampled */
+static unsigned long long cache_size = 0;		/* Bytes the cache is limited to. 0 if unlimited */
+static unsigned int node_mask = ~0u;			/* Bit i set if this node serves PROXY_NAMES[i] */
+static unsigned int peer_interval = DEFAULT_PEER_INTERVAL;	/* Seconds between digest exchanges with the peers */
+static unsigned int hot_replicas = 0;			/* Proxy servers clients spread a hot object over. 0 if not detected */
+static unsigned int open_sessions = 0;			/* Sessions this process is serving, counted in COUNTER_OPEN_CONNECTIONS */
 
-	return 1;
-}
+struct batch_waiter {
+	int fd;					/* Connection of the process waiting for the object */
+	char object_name[MAX_OBJECT_NAME + 1];
+	char validator[VALIDATOR_LEN];		/* Validator of the waiting process's cached copy. Empty if none */
+	struct trace_context trace;		/* Trace of the client request the object is fetched for */
+};
 
 /****
  * Configure TLS client for connection with a server, but does not connect to server yet
@@ -101,50 +176,1646 @@ static struct tls* setupTLSClient() {
 
         if (tls_init() != 0)
                 err(1, "tls_init:");
-        printf("Initialized TLS\n");
+        log_debug("Initialized TLS");
 
         if ((cfg = tls_config_new()) == NULL)
                 err(1, "tls_config_new:");
-        printf("Got TLS config\n");
+        log_debug("Got TLS config");
 
         if (tls_config_set_ca_file(cfg, "../../certificates/root.pem") != 0)
                 err(1, "tls_config_set_ca_file:");
-        printf("Set root certificate\n");
+        log_debug("Set root certificate");
 
         if ((ctx = tls_client()) == NULL)
                 err(1, "tls_client:");
-        printf("Got TLS client\n");
+        log_debug("Got TLS client");
 
         if (tls_configure(ctx, cfg) != 0)
                 err(1, "tls_configure: %s", tls_error(ctx));
-        printf("Configured TLS client with TLS config\n");
+        log_debug("Configured TLS client with TLS config");
 
 	return ctx;
 }
 
-static void usage()
+/****
+ * Connect to the server or a peer and start a TLS session on the connection. The
+ * origin deadline is armed before connecting and bounds the whole fetch
+ * host, port: Address of the server or peer
+ * server_ctx: TLS client context from setupTLSClient
+ * origin: Initialized deadline. Must be cancelled before the returned socket is closed
+ * return: The connected socket. -1 on error
+ ****/
+static int connect_server(const char *host, const char *port, struct tls *server_ctx, struct deadline *origin)
+{
+	struct addrinfo hints, *res, *ai;
+	unsigned int timeout = deadline_timeout(DEADLINE_ORIGIN);
+	struct timeval tv = { timeout / 1000, (timeout % 1000) * 1000 };
+	int sd = -1, one = 1;
+	int error;
+
+	memset(&hints, 0, sizeof(hints));
+	hints.ai_family = AF_UNSPEC;
+	hints.ai_socktype = SOCK_STREAM;
+	if ((error = getaddrinfo(host, port, &hints, &res)) != 0) {
+		warnx("getaddrinfo %s: %s", host, gai_strerror(error));
+		return -1;
+	}
+	for (ai = res; ai != NULL && sd == -1; ai = ai->ai_next) {
+		if ((sd = socket(ai->ai_family, ai->ai_socktype, ai->ai_protocol)) == -1)
+			continue;
+		setsockopt(sd, SOL_SOCKET, SO_SNDTIMEO, &tv, sizeof(tv));	// Bounds connect, which shutdown does not interrupt
+		setsockopt(sd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));	// Requests are small writes awaiting a reply
+		deadline_arm(origin, DEADLINE_ORIGIN, sd);
+		if (connect(sd, ai->ai_addr, ai->ai_addrlen) == -1) {
+			deadline_cancel(origin);
+			close(sd);
+			sd = -1;
+		}
+	}
+	freeaddrinfo(res);
+	if (sd == -1) {
+		warn("connect to %s:%s", host, port);
+		return -1;
+	}
+
+	if (tls_connect_socket(server_ctx, sd, host) != 0) {
+		warnx("tls_connect_socket: %s", tls_error(server_ctx));
+		deadline_cancel(origin);
+		close(sd);
+		return -1;
+	}
+	return sd;
+}
+
+void usage(void)
 {
 	extern char * __progname;
-	fprintf(stderr, "usage: %s -port portnumber -servername:serverportnumber\n", __progname);
+	fprintf(stderr, "usage: %s -port portnumber -servername:serverportnumber [-ttl seconds] [-swr seconds]\n"
+	    "       [-disk-io uring|threads] [-batch-window milliseconds] [-shards count] [-backlog length]\n"
+	    "       [-prefork workers | -threads count [-handshake-threads count] |\n"
+	    "        [-max-in-flight count] [-queue length] [-queue-timeout milliseconds]\n"
+	    "        [-client-rate connections-per-second [-client-burst count]]]\n"
+	    "       [-idle-timeout milliseconds] [-keepalive-timeout milliseconds] [-read-timeout milliseconds]\n"
+	    "       [-write-timeout milliseconds] [-origin-timeout milliseconds]\n"
+	    "       [-log-level error|warn|info|debug] [-log-content on|off]\n"
+	    "       [-admin-port portnumber] [-trace filename [-trace-sample n]] [-capture filename]\n"
+	    "       [-cache-size bytes] [-cache-policy lru|slru|tinylfu]\n"
+	    "       [-node proxyname[,proxyname...] [-peers nodetable [-peer-interval seconds]]]\n"
+	    "       [-hot-replicas count [-hot-share percent]]\n", __progname);
 	exit(1);
 }
 
+/****
+ * Check whether an option configures admission control, which only applies when a
+ * process is forked per connection
+ * return: 1 if it does. 0 otherwise
+ ****/
+static int admission_option(const char *option)
+{
+	unsigned int i;
+
+	for (i = 0; i < sizeof(ADMISSION_OPTIONS) / sizeof(ADMISSION_OPTIONS[0]); i++) {
+		if (strcmp(option, ADMISSION_OPTIONS[i]) == 0)
+			return 1;
+	}
+	return 0;
+}
+
+/****
+ * Parse the comma separated proxy server names a node serves
+ * dir: Set to the names joined with '-', which names the node's cache partition
+ * return: Mask with bit i set if the node serves PROXY_NAMES[i]. Exits with the usage
+ *         message if a name is unknown
+ ****/
+static unsigned int parse_node(const char *arg, char *dir, size_t size)
+{
+	char names[MAX_LINE], *name, *saveptr;
+	unsigned int mask = 0, i;
+
+	snprintf(names, sizeof(names), "%s", arg);
+	dir[0] = '\0';
+	for (name = strtok_r(names, ",", &saveptr); name != NULL; name = strtok_r(NULL, ",", &saveptr)) {
+		for (i = 0; i < NUM_PROXIES && strcmp(name, PROXY_NAMES[i]) != 0; i++)
+			;
+		if (i == NUM_PROXIES) {
+			fprintf(stderr, "%s - not a proxy server name\n", name);
+			usage();
+		}
+		if (!(mask & (1u << i)))
+			snprintf(dir + strlen(dir), size - strlen(dir), "%s%s", dir[0] ? "-" : "", name);
+		mask |= 1u << i;
+	}
+	if (mask == 0)
+		usage();
+	return mask;
+}
+
+/****
+ * Map zero-filled memory shared by all of the proxy server's processes. Huge pages
+ * are used if the system has them reserved, otherwise normal pages
+ * return: The mapping. Exits on error
+ ****/
+static void *map_shared(size_t size)
+{
+	size_t huge_size = (size + HUGE_PAGE_SIZE - 1) / HUGE_PAGE_SIZE * HUGE_PAGE_SIZE;
+	void *mem;
+
+	mem = mmap(NULL, huge_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+	if (mem != MAP_FAILED) {
+		log_info("Mapped %zu bytes of shared memory on huge pages", huge_size);
+		return mem;
+	}
+
+	if ((mem = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0)) == MAP_FAILED)
+		err(1, "mmap");
+	return mem;
+}
+
+/****
+ * Get the calling thread's context for asynchronous cache reads and writes, creating it on first use
+ * return: The I/O context
+ ****/
+static struct aio_ctx *get_disk_io()
+{
+	if (disk_io == NULL) {
+		disk_io = aio_create(disk_io_backend, NUM_IO_BUFFERS, CHUNK_SIZE);
+		log_debug("Using %s for cache disk I/O", aio_get_backend(disk_io) == AIO_URING ? "io_uring" : "thread pool");
+	}
+	return disk_io;
+}
+
+/****
+ * Wait until an I/O buffer's operation has completed
+ * results: Result of the last completed operation of each buffer
+ * busy: Whether each buffer has an operation in flight
+ * return: Result of the buffer's operation. Negative errno value on error
+ ****/
+static ssize_t wait_buffer(struct aio_ctx *aio, unsigned int buf, ssize_t results[], int busy[])
+{
+	while (busy[buf]) {
+		unsigned int done;
+		ssize_t result;
+		if (aio_wait(aio, &done, &result) == -1)
+			return -EIO;
+		results[done] = result;
+		busy[done] = 0;
+	}
+	return results[buf];
+}
+
+/****
+ * Write the body of a server response into the proxy server's cache
+ * stream: Stream positioned at the start of the body
+ * entry: Cache entry of the version the body belongs to
+ * first, last: First and last byte of the object contained in the body
+ * return: The offset up to which the range was written to the cache
+ ****/
+static long long fill_range(struct tls_stream *stream, const char *object_name, struct cache_entry *entry, long long first, long long last)
+{
+	/*
+	 * Each I/O buffer is filled from the server and handed to the disk while the next
+	 * buffer is being filled. A buffer is reused once its write has completed. A write
+	 * that stored fewer bytes than were submitted fails like one that returned an error
+	 */
+	struct aio_ctx *aio = get_disk_io();
+	unsigned int num_buffers = aio_num_buffers(aio);
+	ssize_t results[num_buffers];
+	size_t lengths[num_buffers];		/* Bytes submitted with each buffer's write */
+	int busy[num_buffers];
+	unsigned int buf = 0;
+	long long offset = first;
+	long long written;
+	long long marked = first;
+	int write_failed = 0;
+	memset(busy, 0, sizeof(busy));
+
+	while (offset <= last && !write_failed) {
+		char *data = aio_buffer(aio, buf);
+		size_t want = last - offset + 1 < (long long)aio_buffer_size(aio) ? last - offset + 1 : aio_buffer_size(aio);
+		size_t len = 0;
+
+		while (len < want) {
+			ssize_t n = stream_read(stream, data + len, want - len);
+			if (n <= 0)
+				break;
+			len += n;
+		}
+		if (len == 0)
+			break;
+		log_content(data, len);
+
+		if (aio_write(aio, buf, entry->fd, len, offset) == -1 || aio_submit(aio) == -1) {
+			warn("aio_write");
+			break;
+		}
+		busy[buf] = 1;
+		lengths[buf] = len;
+		offset += len;
+		if (len < want)
+			break;
+
+		buf = (buf + 1) % num_buffers;
+		if (busy[buf] && wait_buffer(aio, buf, results, busy) != (ssize_t)lengths[buf]) {
+			warnx("Write to proxy server cache failed");
+			write_failed = 1;
+		}
+
+		if (offset - marked >= MARK_INTERVAL && !write_failed) {	// Record progress so an interrupted transfer can be resumed
+			for (buf = 0; buf < num_buffers; buf++) {
+				if (busy[buf] && wait_buffer(aio, buf, results, busy) != (ssize_t)lengths[buf])
+					write_failed = 1;
+			}
+			buf = 0;
+			if (!write_failed) {
+				cache_mark_range(object_name, entry, first, offset);
+				marked = offset;
+			}
+		}
+	}
+
+	for (buf = 0; buf < num_buffers; buf++) {
+		if (busy[buf] && wait_buffer(aio, buf, results, busy) != (ssize_t)lengths[buf])
+			write_failed = 1;
+	}
+	written = write_failed ? marked : offset;
+	cache_mark_range(object_name, entry, first, written);
+	return written;
+}
+
+/****
+ * Read the server's response to a request for an object and write the range it
+ * contains into the proxy server's cache. A changed object replaces the cached version
+ * stream: Stream positioned at the start of the response
+ * entry: Cache entry of the object. Updated to the server's version of the object
+ * range: Requested range as sent to the server, for logging
+ * from_peer: 1 if the response is from a peer. A peer's NOT_FOUND only means it does
+ *            not have the object cached, so the cached copy is kept
+ * return: FETCH_OK if the range was cached. FETCH_NOT_MODIFIED if the cached copy was revalidated.
+ *         FETCH_NOT_FOUND if the server does not have the object. FETCH_BAD_RANGE if the range
+ *         starts past the end of the object. FETCH_ERROR on error or an incomplete transfer
+ ****/
+static int read_response(struct tls_stream *stream, const char *object_name, struct cache_entry *entry, const char *range,
+    int from_peer)
+{
+	char line[MAX_LINE];
+	char status[32];
+	char validator[VALIDATOR_LEN];
+	long long length, first, last, size;
+
+	if (stream_read_line(stream, line, sizeof(line)) != 1 || sscanf(line, "%31s", status) != 1) {
+		warnx("No response from server for %s", object_name);
+		return FETCH_ERROR;
+	}
+
+	if (strcmp(status, RESP_NOT_MODIFIED) == 0 && entry->chunks != NULL) {
+		cache_renew(object_name, entry);
+		log_debug("Server reports %s is not modified. Renewed proxy cache copy", object_name);
+		return FETCH_NOT_MODIFIED;
+	} else if (strcmp(status, RESP_NOT_FOUND) == 0 && from_peer) {
+		log_debug("Peer does not have %s cached", object_name);
+		return FETCH_NOT_FOUND;
+	} else if (strcmp(status, RESP_NOT_FOUND) == 0) {
+		cache_remove(object_name);
+		cache_entry_free(entry);
+		log_debug("Server does not have %s", object_name);
+		return FETCH_NOT_FOUND;
+	} else if (strcmp(status, RESP_BAD_RANGE) == 0) {
+		log_debug("Server reports range%s of %s is not satisfiable", range, object_name);
+		return FETCH_BAD_RANGE;
+	} else if (strcmp(status, RESP_OK) == 0 && sscanf(line, "%*s %lld %63s", &length, validator) == 2 && length >= 0) {
+		first = 0;
+		last = length - 1;
+		size = length;
+	} else if (strcmp(status, RESP_PARTIAL) != 0 || sscanf(line, "%*s %lld %63s %lld-%lld/%lld", &length, validator,
+	    &first, &last, &size) != 5 || first < 0 || last - first + 1 != length || last >= size) {
+		warnx("Malformed response from server: %s", line);
+		return FETCH_ERROR;
+	}
+
+	/**** Put requested range into proxy server's cache  ****/
+	if ((entry->chunks == NULL || entry->size != size || strcmp(entry->validator, validator) != 0) &&
+	    cache_begin_version(object_name, entry, size, validator) == -1) {
+		warn("cache_begin_version");
+		return FETCH_ERROR;
+	}
+	if (cache_unshare(object_name, entry) == -1) {		// The data file may be shared with other names
+		warnx("Cannot write %s to the proxy server cache", object_name);
+		return FETCH_ERROR;
+	}
+
+	long long written = fill_range(stream, object_name, entry, first, last);
+	if (written <= last) {
+		warnx("Incomplete transfer of %s from server. Cached %lld of %lld bytes", object_name, written - first, length);
+		return FETCH_ERROR;
+	}
+	/**** End put requested range into proxy server's cache  ****/
+
+	return FETCH_OK;
+}
+
+/****
+ * Get a range of an object from the server and write it into the proxy server's cache.
+ * If revalidate is set and the cached copy has a validator, the server only sends the
+ * range if the object changed
+ * entry: Cache entry of the object. Updated to the server's version of the object
+ * start, end: First and last byte to get. end is -1 to get the rest of the object
+ * return: The fetch status as returned by read_response
+ ****/
+static int fetch_range(const char *object_name, struct cache_entry *entry, long long start, long long end, int revalidate)
+{
+	struct tls *server_ctx = setupTLSClient();
+	struct tls_stream stream;
+	struct deadline origin;
+	char range[64];
+	char trace[64];
+	int ret = FETCH_ERROR;
+	int sd;
+	unsigned long long started = latency_clock();
+
+	deadline_init(&origin);
+	if ((sd = connect_server(server_name, server_port, server_ctx, &origin)) == -1) {
+		tls_free(server_ctx);
+		return FETCH_ERROR;
+	}
+	log_debug("Connected to server");
+
+	range[0] = '\0';
+	if (end != -1)
+		snprintf(range, sizeof(range), " %lld-%lld", start, end);
+	else if (start != 0)
+		snprintf(range, sizeof(range), " %lld-", start);
+	trace_format(trace_current(), trace, sizeof(trace));
+
+	if (revalidate && entry->validator[0] != '\0') {
+		if (tls_printf(server_ctx, "%s %s %s%s%s\n", REQ_REVALIDATE, object_name, entry->validator, range, trace) == -1) {
+			warnx("tls_write: %s", tls_error(server_ctx));
+			goto done;
+		}
+		log_debug("Sent revalidation request to server %s for %s%s", server_name, object_name, range);
+	} else {
+		if (tls_printf(server_ctx, "%s %s%s%s\n", REQ_GET, object_name, range, trace) == -1) {
+			warnx("tls_write: %s", tls_error(server_ctx));
+			goto done;
+		}
+		log_debug("Sent request to server %s for %s%s", server_name, object_name, range);
+	}
+
+	started = latency_record(STAGE_ORIGIN_CONNECT, started);	// The handshake completes with the request
+	metrics_add(COUNTER_ORIGIN_FETCHES, ORIGIN_FETCH_SINGLE, 1);
+	stream_init(&stream, server_ctx);
+	ret = read_response(&stream, object_name, entry, range, 0);
+	latency_record(STAGE_ORIGIN_TRANSFER, started);
+	if (origin.expired)
+		log_info("Fetch of %s from server timed out", object_name);
+
+done:
+	deadline_cancel(&origin);
+	tls_close(server_ctx);
+	tls_free(server_ctx);
+	close(sd);
+	return ret;
+}
+
+/****
+ * Get a whole object from a peer whose digest may contain it and write it into the
+ * proxy server's cache. The peer answers from its cache only
+ * peer: Index of the peer
+ * entry: Cache entry of the object. Updated to the peer's version of the object
+ * return: The fetch status as returned by read_response. FETCH_NOT_FOUND if the peer
+ *         does not have the object cached
+ ****/
+static int peer_fetch(unsigned int peer, const char *object_name, struct cache_entry *entry)
+{
+	const struct peer *address = peer_get(peer);
+	struct tls *peer_ctx = setupTLSClient();
+	struct tls_stream stream;
+	struct deadline origin;
+	char trace[64];
+	int ret = FETCH_ERROR;
+	int sd;
+
+	deadline_init(&origin);
+	if ((sd = connect_server(address->host, address->port, peer_ctx, &origin)) == -1) {
+		tls_free(peer_ctx);
+		return FETCH_ERROR;
+	}
+	trace_format(trace_current(), trace, sizeof(trace));
+	if (tls_printf(peer_ctx, "%s %s%s\n", REQ_PEER, object_name, trace) == -1) {
+		warnx("tls_write: %s", tls_error(peer_ctx));
+	} else {
+		log_debug("Sent request to peer %s:%s for %s", address->host, address->port, object_name);
+		stream_init(&stream, peer_ctx);
+		ret = read_response(&stream, object_name, entry, "", 1);
+	}
+
+	deadline_cancel(&origin);
+	tls_close(peer_ctx);
+	tls_free(peer_ctx);
+	close(sd);
+	return ret;
+}
+
+/****
+ * Get a peer's digest of the names it caches
+ * bits: Set to the digest, PEER_DIGEST_INTS ints
+ * return: 0 on success. -1 if the peer could not be reached or sent no digest
+ ****/
+static int fetch_digest(unsigned int peer, unsigned int *bits)
+{
+	const struct peer *address = peer_get(peer);
+	struct tls *peer_ctx = setupTLSClient();
+	struct tls_stream stream;
+	struct deadline origin;
+	char line[MAX_LINE], expected[64];
+	size_t size = PEER_DIGEST_INTS * sizeof(*bits), received = 0;
+	unsigned int i;
+	int sd;
+
+	deadline_init(&origin);
+	if ((sd = connect_server(address->host, address->port, peer_ctx, &origin)) == -1) {
+		tls_free(peer_ctx);
+		return -1;
+	}
+	snprintf(expected, sizeof(expected), "%s %zu bloom-%u-%u", RESP_OK, size, PEER_DIGEST_BITS, PEER_DIGEST_HASHES);
+	stream_init(&stream, peer_ctx);
+	if (tls_printf(peer_ctx, "%s\n", REQ_DIGEST) != -1 && stream_read_line(&stream, line, sizeof(line)) == 1 &&
+	    strcmp(line, expected) == 0) {
+		while (received < size) {
+			ssize_t n = stream_read(&stream, (char *)bits + received, size - received);
+			if (n <= 0)
+				break;
+			received += n;
+		}
+	}
+
+	deadline_cancel(&origin);
+	tls_close(peer_ctx);
+	tls_free(peer_ctx);
+	close(sd);
+	if (received < size)
+		return -1;
+	for (i = 0; i < PEER_DIGEST_INTS; i++)
+		bits[i] = ntohl(bits[i]);
+	return 0;
+}
+
+/****
+ * Rebuild this node's digest and get every peer's, every peer_interval seconds. A
+ * peer that cannot be reached gets an empty digest until it can be again. Reports
+ * how many misses the peers answered, and so kept from the server, when that changes
+ * return: Never returns
+ ****/
+static void *refresh_peers(void *arg)
+{
+	unsigned int *bits;
+	unsigned int i;
+	long long reported = 0;
+
+	if ((bits = malloc(PEER_DIGEST_INTS * sizeof(*bits))) == NULL)
+		err(1, "malloc");
+	for (;;) {
+		unsigned int names = peer_build_digest();
+		unsigned int reachable = 0;
+
+		for (i = 0; i < peer_count(); i++) {
+			if (fetch_digest(i, bits) == 0) {
+				peer_set_digest(i, bits);
+				reachable++;
+			} else {
+				peer_set_digest(i, NULL);
+			}
+		}
+		log_debug("Published a digest of %u cached objects. Got digests of %u of %u peers", names, reachable, peer_count());
+
+		long long hits = metrics_value(COUNTER_PEER_FETCHES, PEER_HIT), misses = 0;
+		for (i = 0; i < NUM_PROXIES; i++)
+			misses += metrics_value(COUNTER_CACHE_MISSES, i);
+		if (hits != reported && misses > 0)
+			log_info("Peers answered %lld of %lld misses. Origin offload %.1f%%", hits, misses, 100.0 * hits / misses);
+		reported = hits;
+		sleep(peer_interval);
+	}
+	return NULL;
+}
+
+/****
+ * Read one '\n' terminated line from a local socket. The newline is stripped
+ * return: 1 if a line was read. 0 on end of stream, error or timeout
+ ****/
+static int read_local_line(int fd, char *line, size_t size)
+{
+	size_t n = 0;
+
+	while (n + 1 < size) {
+		ssize_t ret = read(fd, line + n, size - n - 1);
+		if (ret <= 0)
+			return 0;
+		n += ret;
+		if (line[n - 1] == '\n') {
+			line[n - 1] = '\0';
+			return 1;
+		}
+	}
+	return 0;
+}
+
+/****
+ * Get an object from the server through the batch coordinator, which groups the
+ * misses of concurrent connections into batch requests
+ * entry: Cache entry of the object. Reloaded from the cache once the object is fetched
+ * return: The fetch status. FETCH_ERROR if the coordinator could not fetch the object
+ ****/
+static int batch_fetch(const char *object_name, struct cache_entry *entry)
+{
+	char line[MAX_LINE];
+	char trace[64];
+	unsigned long long started = latency_clock();
+	int fd;
+
+	trace_format(trace_current(), trace, sizeof(trace));
+	if ((fd = socket(AF_UNIX, SOCK_STREAM, 0)) == -1)
+		return FETCH_ERROR;
+	if (connect(fd, (struct sockaddr *)&batch_addr, batch_addr_len) == -1 ||
+	    dprintf(fd, "%s %s%s\n", object_name, entry->validator[0] != '\0' ? entry->validator : "-", trace) < 0 ||
+	    !read_local_line(fd, line, sizeof(line))) {
+		close(fd);
+		return FETCH_ERROR;
+	}
+	close(fd);
+	latency_record(STAGE_BATCH_WAIT, started);
+	log_debug("Batch coordinator answered %s for %s", line, object_name);
+
+	if (strcmp(line, RESP_NOT_FOUND) == 0) {
+		cache_entry_free(entry);
+		return FETCH_NOT_FOUND;
+	}
+	if ((strcmp(line, RESP_OK) != 0 && strcmp(line, RESP_NOT_MODIFIED) != 0) || cache_lookup(object_name, entry) == -1)
+		return FETCH_ERROR;
+	return strcmp(line, RESP_OK) == 0 ? FETCH_OK : FETCH_NOT_MODIFIED;
+}
+
+/****
+ * Fetch a batch of objects from the server with one request and answer every
+ * process waiting for one of them. Runs in a process forked by the coordinator
+ * return: Nothing
+ ****/
+static void run_batch(struct batch_waiter waiters[], unsigned int count)
+{
+	unsigned int objects[MAX_BATCH];		// Index of the first waiter for each distinct object
+	int statuses[MAX_BATCH];
+	unsigned int num_objects = 0;
+	unsigned int traced = 0;			// Waiter whose trace the batch's spans are shown in
+	unsigned int i, j;
+
+	for (i = 0; i < count; i++) {
+		for (j = 0; j < num_objects && strcmp(waiters[objects[j]].object_name, waiters[i].object_name) != 0; j++)
+			;
+		if (j == num_objects) {
+			objects[num_objects] = i;
+			statuses[num_objects++] = FETCH_ERROR;
+		}
+		if (!(waiters[traced].trace.flags & TRACE_SAMPLED))
+			traced = i;
+	}
+	trace_begin(&waiters[traced].trace);
+
+	struct tls *server_ctx = setupTLSClient();
+	struct tls_stream stream;
+	struct deadline origin;
+	unsigned long long started = latency_clock();
+	int sd;
+
+	deadline_init(&origin);
+	if ((sd = connect_server(server_name, server_port, server_ctx, &origin)) == -1)
+		goto reply;
+
+	if (tls_printf(server_ctx, "%s %u\n", REQ_BATCH, num_objects) == -1)
+		goto done;
+	for (j = 0; j < num_objects; j++) {
+		const struct batch_waiter *waiter = &waiters[objects[j]];
+		char trace[64];
+
+		trace_format(&waiter->trace, trace, sizeof(trace));
+		if (tls_printf(server_ctx, "%s%s%s%s\n", waiter->object_name, waiter->validator[0] != '\0' ? " " : "",
+		    waiter->validator, trace) == -1)
+			goto done;
+	}
+	log_debug("Sent batch request to server %s for %u objects", server_name, num_objects);
+	metrics_add(COUNTER_ORIGIN_FETCHES, ORIGIN_FETCH_BATCH, 1);
+	started = latency_record(STAGE_ORIGIN_CONNECT, started);
+
+	stream_init(&stream, server_ctx);
+	for (j = 0; j < num_objects; j++) {
+		const char *object_name = waiters[objects[j]].object_name;
+		struct cache_entry entry;
+
+		cache_entry_init(&entry);
+		if (waiters[objects[j]].validator[0] != '\0')
+			cache_lookup(object_name, &entry);
+		statuses[j] = read_response(&stream, object_name, &entry, "", 0);
+		cache_entry_free(&entry);
+		if (statuses[j] == FETCH_ERROR)
+			break;				// The rest of the response can no longer be framed
+	}
+	latency_record(STAGE_ORIGIN_TRANSFER, started);
+
+done:
+	if (origin.expired)
+		log_info("Batch fetch from server timed out");
+	deadline_cancel(&origin);
+	tls_close(server_ctx);
+	close(sd);
+
+reply:
+	tls_free(server_ctx);
+	trace_clear();
+
+	for (i = 0; i < count; i++) {
+		for (j = 0; strcmp(waiters[objects[j]].object_name, waiters[i].object_name) != 0; j++)
+			;
+		const char *status = statuses[j] == FETCH_OK ? RESP_OK : statuses[j] == FETCH_NOT_MODIFIED ? RESP_NOT_MODIFIED :
+		    statuses[j] == FETCH_NOT_FOUND ? RESP_NOT_FOUND : RESP_UNAVAILABLE;
+		dprintf(waiters[i].fd, "%s\n", status);
+		close(waiters[i].fd);
+	}
+}
+
+/****
+ * Hand the collected misses to a new process that fetches them as one batch
+ * return: Nothing
+ ****/
+static void dispatch_batch(int listen_fd, struct batch_waiter waiters[], unsigned int count)
+{
+	unsigned int i;
+	pid_t pid;
+
+	if ((pid = fork()) == 0) {
+		close(listen_fd);
+		run_batch(waiters, count);
+		latency_flush();
+		exit(0);
+	}
+	if (pid == -1)
+		warn("fork");
+
+	for (i = 0; i < count; i++) {
+		if (pid == -1)
+			dprintf(waiters[i].fd, "%s\n", RESP_UNAVAILABLE);
+		close(waiters[i].fd);
+	}
+}
+
+/****
+ * Collect the misses of concurrent connections and fetch them from the server in
+ * batches. A batch is sent batch_window milliseconds after its first miss arrived,
+ * or as soon as it is full
+ * listen_fd: Socket the connection processes send their misses to
+ * return: Never returns
+ ****/
+static void batch_coordinator(int listen_fd)
+{
+	struct batch_waiter waiters[MAX_BATCH];
+	unsigned int count = 0;
+	struct timespec deadline = {0, 0};
+
+	for (;;) {
+		struct pollfd pfd = { .fd = listen_fd, .events = POLLIN };
+		struct timespec now;
+		int timeout = -1;
+
+		if (count > 0) {
+			clock_gettime(CLOCK_MONOTONIC, &now);
+			long long remaining = (deadline.tv_sec - now.tv_sec) * 1000LL + (deadline.tv_nsec - now.tv_nsec) / 1000000;
+			timeout = remaining > 0 ? remaining : 0;
+		}
+
+		int ready = poll(&pfd, 1, timeout);
+		if (ready == -1 && errno != EINTR)
+			err(1, "poll");
+
+		if (ready > 0) {
+			struct timeval tv = { 0, BATCH_RECV_TIMEOUT_MS * 1000 };
+			struct batch_waiter *waiter = &waiters[count];
+			char line[MAX_LINE];
+			char *object_name, *validator, *saveptr;
+
+			if ((waiter->fd = accept(listen_fd, NULL, NULL)) == -1)
+				continue;
+			setsockopt(waiter->fd, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+			if (!read_local_line(waiter->fd, line, sizeof(line))) {
+				close(waiter->fd);
+				continue;
+			}
+			trace_extract(line, &waiter->trace);
+			if ((object_name = strtok_r(line, " ", &saveptr)) == NULL || !valid_object_name(object_name) ||
+			    (validator = strtok_r(NULL, " ", &saveptr)) == NULL || strlen(validator) >= VALIDATOR_LEN) {
+				close(waiter->fd);
+				continue;
+			}
+			strcpy(waiter->object_name, object_name);
+			strcpy(waiter->validator, strcmp(validator, "-") == 0 ? "" : validator);
+
+			if (count++ == 0) {
+				clock_gettime(CLOCK_MONOTONIC, &deadline);
+				deadline.tv_nsec += (long)batch_window * 1000000;
+				deadline.tv_sec += deadline.tv_nsec / 1000000000;
+				deadline.tv_nsec %= 1000000000;
+			}
+		}
+
+		clock_gettime(CLOCK_MONOTONIC, &now);
+		if (count == MAX_BATCH || (count > 0 && (now.tv_sec > deadline.tv_sec ||
+		    (now.tv_sec == deadline.tv_sec && now.tv_nsec >= deadline.tv_nsec)))) {
+			dispatch_batch(listen_fd, waiters, count);
+			count = 0;
+		}
+	}
+}
+
+/****
+ * Start the process that batches misses. Connection processes reach it through an
+ * abstract local socket named after the proxy server's process
+ * return: Nothing
+ ****/
+static void start_batch_coordinator()
+{
+	int fd;
+
+	memset(&batch_addr, 0, sizeof(batch_addr));
+	batch_addr.sun_family = AF_UNIX;
+	snprintf(batch_addr.sun_path + 1, sizeof(batch_addr.sun_path) - 1, "proxy-batch.%ld", (long)getpid());
+	batch_addr_len = offsetof(struct sockaddr_un, sun_path) + 1 + strlen(batch_addr.sun_path + 1);
+
+	if ((fd = socket(AF_UNIX, SOCK_STREAM, 0)) == -1)
+		err(1, "socket failed");
+	if (bind(fd, (struct sockaddr *)&batch_addr, batch_addr_len) == -1)
+		err(1, "bind failed");
+	if (listen(fd, SOMAXCONN) == -1)
+		err(1, "listen failed");
+
+	pid_t pid = fork();
+	if (pid == -1)
+		err(1, "fork failed");
+	if (pid == 0) {
+		signal(SIGCHLD, SIG_IGN);		// Batch workers are reaped automatically
+		batch_coordinator(fd);
+	}
+	close(fd);
+	log_info("Batching misses for up to %u ms", batch_window);
+}
+
+/****
+ * Revalidate the stale objects connection processes send, one after another. Objects
+ * revalidated since they were sent are skipped
+ * fd: Socket the object names arrive on, one per message
+ * return: Never returns. Exits once every connection process has closed the socket
+ ****/
+static void run_revalidator(int fd)
+{
+	char object_name[MAX_OBJECT_NAME + 1];
+	ssize_t n;
+
+	signal(SIGPIPE, SIG_IGN);
+	while ((n = recv(fd, object_name, MAX_OBJECT_NAME, 0)) != 0) {
+		struct cache_entry entry;
+
+		if (n == -1) {
+			if (errno == EINTR)
+				continue;
+			err(1, "recv");
+		}
+		object_name[n] = '\0';
+		cache_entry_init(&entry);
+		if (valid_object_name(object_name) && cache_lookup(object_name, &entry) == 0 && !cache_fresh(&entry, time(NULL))) {
+			log_debug("Revalidating %s with server in the background", object_name);
+			fetch_range(object_name, &entry, 0, CHUNK_SIZE - 1, 1);
+		}
+		cache_entry_free(&entry);
+		trace_clear();
+		latency_flush();
+	}
+	exit(0);
+}
+
+/****
+ * Start the process that revalidates stale objects served to clients, so no connection
+ * process, worker or thread waits for the server after answering a client
+ * return: Nothing
+ ****/
+static void start_revalidator()
+{
+	int fds[2];
+
+	if (socketpair(AF_UNIX, SOCK_SEQPACKET, 0, fds) == -1)
+		err(1, "socketpair");
+	pid_t pid = fork();
+	if (pid == -1)
+		err(1, "fork failed");
+	if (pid == 0) {
+		close(fds[0]);
+		run_revalidator(fds[1]);
+	}
+	close(fds[1]);
+	revalidate_fd = fds[0];
+	log_info("Serving stale objects for up to %u seconds while they are revalidated", stale_while_revalidate);
+}
+
+/****
+ * Hand a stale object served to a client to the revalidation process. If the process
+ * is too far behind, the object is left stale for a later request to hand over again
+ * return: Nothing
+ ****/
+static void revalidate_later(const char *object_name)
+{
+	if (send(revalidate_fd, object_name, strlen(object_name), MSG_DONTWAIT) == -1)
+		log_debug("Not revalidating %s: %s", object_name, strerror(errno));
+}
+
+/****
+ * Send a status line without a body to the client
+ * return: Nothing
+ ****/
+static void send_status(struct tls *cctx, const char *status)
+{
+	unsigned long long started = latency_clock();
+
+	if (tls_printf(cctx, "%s\n", status) == -1)
+		warnx("tls_write: %s", tls_error(cctx));
+	latency_record(STAGE_CLIENT_WRITE, started);
+}
+
+/****
+ * Send a cached range of an object to the client
+ * deadline: Client deadline, armed as a write deadline for every block sent
+ * partial: 1 if the client asked for a range. 0 if it asked for the whole object
+ * first, last: First and last byte to send
+ * hot: Replicas advertised in the status line. 0 if the object is not hot
+ * return: 0 on success. -1 if the range could not be read or sent
+ ****/
+static int send_range(struct tls *cctx, struct deadline *deadline, const struct cache_entry *entry, int partial, long long first,
+    long long last, unsigned int hot)
+{
+	const char *validator = entry->validator[0] != '\0' ? entry->validator : "-";
+	unsigned long long started = latency_clock();
+	char advert[32] = "";
+	long long offset;
+	int ret;
+
+	if (hot > 0) {
+		snprintf(advert, sizeof(advert), " %s%u", HOT_FIELD, hot);
+		metrics_add(COUNTER_HOT_RESPONSES, 0, 1);
+	}
+	deadline_arm(deadline, DEADLINE_WRITE, deadline->fd);
+	if (partial)
+		ret = tls_printf(cctx, "%s %lld %s %lld-%lld/%lld%s\n", RESP_PARTIAL, last - first + 1, validator, first, last,
+		    entry->size, advert);
+	else
+		ret = tls_printf(cctx, "%s %lld %s%s\n", RESP_OK, entry->size, validator, advert);
+	if (ret == -1) {
+		warnx("tls_write: %s", tls_error(cctx));
+		deadline_cancel(deadline);
+		return -1;
+	}
+
+	/*
+	 * Keep a read in flight on every I/O buffer and send the buffers to the client in
+	 * order as their reads complete
+	 */
+	struct aio_ctx *aio = get_disk_io();
+	unsigned int num_buffers = aio_num_buffers(aio);
+	long long block_size = aio_buffer_size(aio);
+	long long num_blocks = (last - first + block_size) / block_size;
+	long long next_read, next_send;
+	ssize_t results[num_buffers];
+	int busy[num_buffers];
+	memset(busy, 0, sizeof(busy));
+
+	for (next_read = 0; next_read < num_blocks && next_read < num_buffers; next_read++) {
+		offset = first + next_read * block_size;
+		if (aio_read(aio, next_read, entry->fd, last - offset + 1 < block_size ? last - offset + 1 : block_size, offset) == -1)
+			goto fail;
+		busy[next_read] = 1;
+	}
+	if (aio_submit(aio) == -1)
+		goto fail;
+
+	for (next_send = 0; next_send < num_blocks; next_send++) {
+		unsigned int buf = next_send % num_buffers;
+		long long expected;
+		ssize_t n = wait_buffer(aio, buf, results, busy);
+
+		offset = first + next_send * block_size;
+		expected = last - offset + 1 < block_size ? last - offset + 1 : block_size;
+		if (n != expected) {
+			warnx("Read from proxy server cache failed");
+			goto fail;
+		}
+		deadline_arm(deadline, DEADLINE_WRITE, deadline->fd);	// Each block gets the full write timeout
+		if (tls_write_all(cctx, aio_buffer(aio, buf), n) == -1) {
+			warnx("tls_write: %s", tls_error(cctx));
+			goto fail;
+		}
+		log_content(aio_buffer(aio, buf), n);
+		metrics_add(COUNTER_BYTES_SERVED, 0, n);
+
+		if (next_read < num_blocks) {
+			offset = first + next_read * block_size;
+			if (aio_read(aio, buf, entry->fd, last - offset + 1 < block_size ? last - offset + 1 : block_size, offset) == -1 ||
+			    aio_submit(aio) == -1)
+				goto fail;
+			busy[buf] = 1;
+			next_read++;
+		}
+	}
+	deadline_cancel(deadline);
+	latency_record(STAGE_CLIENT_WRITE, started);
+
+	return 0;
+
+fail:
+	deadline_cancel(deadline);
+	aio_drain(aio);
+	return -1;
+}
+
+/****
+ * Answer a peer's request for a whole object from the cache only. An object that is
+ * not fresh and complete in the cache is answered NOT_FOUND, so the peer gets it
+ * from the server instead
+ * deadline: Client deadline, armed by send_range while the object is sent
+ * entry: Initialized cache entry
+ * outcome: Set to CAPTURE_HIT if the object was sent, so it is counted with the eviction policy
+ * return: 0 on success. -1 if the object was cut short and the session must be closed
+ ****/
+static int serve_peer(struct tls *cctx, struct deadline *deadline, const char *object_name, struct cache_entry *entry,
+    enum capture_outcome *outcome)
+{
+	if (cache_lookup(object_name, entry) == 0 && cache_fresh(entry, time(NULL)) &&
+	    (entry->size == 0 || cache_has_range(entry, 0, entry->size - 1))) {
+		metrics_add(COUNTER_PEER_REQUESTS, PEER_HIT, 1);
+		*outcome = CAPTURE_HIT;
+		log_info("Sending cached %s to peer", object_name);
+		return send_range(cctx, deadline, entry, 0, 0, entry->size - 1, 0);
+	}
+	metrics_add(COUNTER_PEER_REQUESTS, PEER_MISS, 1);
+	log_debug("Peer asked for %s, which is not fresh and complete in the cache", object_name);
+	send_status(cctx, RESP_NOT_FOUND);
+	return 0;
+}
+
+/****
+ * Send this node's digest to a peer. A node without peers has no digest
+ * deadline: Client deadline, armed as a write deadline while the digest is sent
+ * return: Nothing
+ ****/
+static void send_digest(struct tls *cctx, struct deadline *deadline)
+{
+	size_t size = PEER_DIGEST_INTS * sizeof(unsigned int);
+	unsigned int *bits;
+	unsigned int i;
+
+	if (peer_count() == 0) {
+		send_status(cctx, RESP_NOT_FOUND);
+		return;
+	}
+	if ((bits = malloc(size)) == NULL) {
+		send_status(cctx, RESP_UNAVAILABLE);
+		return;
+	}
+	peer_copy_digest(bits);
+	for (i = 0; i < PEER_DIGEST_INTS; i++)
+		bits[i] = htonl(bits[i]);
+	deadline_arm(deadline, DEADLINE_WRITE, deadline->fd);
+	if (tls_printf(cctx, "%s %zu bloom-%u-%u\n", RESP_OK, size, PEER_DIGEST_BITS, PEER_DIGEST_HASHES) == -1 ||
+	    tls_write_all(cctx, bits, size) == -1)
+		warnx("tls_write: %s", tls_error(cctx));
+	deadline_cancel(deadline);
+	free(bits);
+}
+
+/****
+ * Answer a client's request for an object. Stale objects are revalidated and missing
+ * extents of the requested range are fetched from the server before the range is sent.
+ * An object that is not cached at all is first fetched from a peer whose digest may
+ * contain it
+ * deadline: Client deadline, armed by send_range while the range is sent
+ * range: Requested byte range, or NULL for the whole object
+ * hot: Replicas advertised to the client. 0 if the object is not hot
+ * entry: Initialized cache entry. Left describing the cached object
+ * outcome: Set to how the request was answered, for the capture
+ * return: 1 if a stale copy was served and should be revalidated afterwards. -1 if the
+ *         response was cut short and the session must be closed. 0 otherwise
+ ****/
+static int serve_request(struct tls *cctx, struct deadline *deadline, unsigned int proxy, const char *object_name, const char *range,
+    unsigned int hot, struct cache_entry *entry, enum capture_outcome *outcome)
+{
+	long long start = 0, end = -1, first = 0, last = -1, run_start, run_end;
+	int status = FETCH_OK;
+	unsigned int attempts = 0;
+
+	*outcome = CAPTURE_FAILED;
+	if (range != NULL && parse_range(range, &start, &end) == -1) {
+		send_status(cctx, RESP_INVALID);
+		log_info("Request had malformed range %s. Denied request", range);
+		return 0;
+	}
+
+	/**** Get requested range from server if it is not fresh in proxy server's cache ****/
+	unsigned long long started = latency_clock();
+	int cached = cache_lookup(object_name, entry) == 0;
+	latency_record(STAGE_CACHE_LOOKUP, started);
+	int have_range = cached && resolve_range(start, end, entry->size, &first, &last) == 0;
+	time_t now = time(NULL);
+
+	if (cached && cache_fresh(entry, now)) {
+		log_debug("Requested object is fresh in proxy server cache");
+		metrics_add(COUNTER_CACHE_HITS, proxy, 1);
+		*outcome = CAPTURE_HIT;
+	} else if (have_range && cache_has_range(entry, first, last) &&
+	    now - entry->fetched < (time_t)entry->ttl + stale_while_revalidate) {
+		log_debug("Requested object is stale in proxy server cache. Revalidating after response");
+		metrics_add(COUNTER_CACHE_HITS, proxy, 1);
+		*outcome = CAPTURE_HIT;
+		return send_range(cctx, deadline, entry, range != NULL, first, last, hot) == 0 ? 1 : -1;
+	} else {
+		long long fetch_start = start / CHUNK_SIZE * CHUNK_SIZE;
+		long long fetch_end = end == -1 ? -1 : (end / CHUNK_SIZE + 1) * CHUNK_SIZE - 1;
+
+		if (have_range && !cache_missing_range(entry, first, last, &fetch_start, &fetch_end)) {
+			fetch_start = first / CHUNK_SIZE * CHUNK_SIZE;		// Nothing missing. Revalidate with the first chunk
+			fetch_end = fetch_start + CHUNK_SIZE - 1;
+		}
+
+		if (cached)
+			log_debug("Requested object is stale in proxy server cache. Revalidating with server");
+		else
+			log_debug("Requested object is not in proxy server cache. Requesting object from server");
+		metrics_add(COUNTER_CACHE_MISSES, proxy, 1);
+		*outcome = CAPTURE_MISS;
+
+		status = FETCH_ERROR;
+		int peer = cached ? -1 : peer_find(object_name);
+		if (peer != -1) {
+			status = peer_fetch(peer, object_name, entry);
+			metrics_add(COUNTER_PEER_FETCHES, status == FETCH_OK ? PEER_HIT : status == FETCH_NOT_FOUND ? PEER_MISS : PEER_ERROR, 1);
+			if (status == FETCH_OK)
+				log_debug("Got %s from peer %s:%s", object_name, peer_get(peer)->host, peer_get(peer)->port);
+			else
+				status = FETCH_ERROR;			// Fall back to the server
+		}
+		if (status == FETCH_ERROR && batch_window > 0 && range == NULL &&
+		    (!cached || (have_range && cache_has_range(entry, first, last))))
+			status = batch_fetch(object_name, entry);
+		if (status == FETCH_ERROR)
+			status = fetch_range(object_name, entry, fetch_start, fetch_end, cached);
+		if (status == FETCH_ERROR && cached)
+			log_info("Could not revalidate %s. Serving stale copy", object_name);
+	}
+
+	while ((status == FETCH_OK || status == FETCH_NOT_MODIFIED) && entry->chunks != NULL &&
+	    resolve_range(start, end, entry->size, &first, &last) == 0 &&
+	    cache_missing_range(entry, first, last, &run_start, &run_end) && attempts++ < MAX_FETCH_ATTEMPTS) {
+		log_debug("Requesting missing range %lld-%lld of %s from server", run_start, run_end, object_name);
+		status = fetch_range(object_name, entry, run_start, run_end, 0);
+	}
+	if (status == FETCH_OK)
+		log_debug("Put %s in proxy %s's cache", object_name, PROXY_NAMES[proxy]);
+	/**** End get requested range from server if it is not fresh in proxy server's cache ****/
+
+	/**** Send requested range to client ****/
+	if (status == FETCH_NOT_FOUND) {
+		*outcome = CAPTURE_NOT_FOUND;
+		send_status(cctx, RESP_NOT_FOUND);
+		log_info("Requested object %s does not exist", object_name);
+	} else if (status == FETCH_BAD_RANGE || (entry->chunks != NULL && resolve_range(start, end, entry->size, &first, &last) == -1)) {
+		*outcome = CAPTURE_FAILED;
+		if (tls_printf(cctx, "%s %lld\n", RESP_BAD_RANGE, entry->size) == -1)
+			warnx("tls_write: %s", tls_error(cctx));
+		log_info("Requested range %s of %s is not satisfiable", range, object_name);
+	} else if (entry->chunks == NULL || !cache_has_range(entry, first, last)) {
+		*outcome = CAPTURE_FAILED;
+		send_status(cctx, RESP_UNAVAILABLE);
+		log_info("Requested object %s is not available", object_name);
+	} else if (send_range(cctx, deadline, entry, range != NULL, first, last, hot) == -1) {
+		return -1;
+	}
+	/**** End send requested range to client ****/
+
+	return 0;
+}
+
+/****
+ * Check a proxy server's blacklist filter for an object
+ * return: 1 if the object is blacklisted. 0 otherwise
+ ****/
+static int check_blacklist(const unsigned int *bloom_filter, const char *object_name)
+{
+	unsigned long long started = latency_clock();
+	int blacklisted = search_bloom_filter(bloom_filter, NUM_BLOOM_HASHES, NUM_BLOOM_BITS, object_name) == 1;
+
+	latency_record(STAGE_BLOOM_CHECK, started);
+	return blacklisted;
+}
+
+/****
+ * Answer the requests on an established client session until the client closes it.
+ * A client may send requests ahead without waiting for their responses. They are
+ * answered in order. Stale objects served to the client are handed to the
+ * revalidation process
+ * cctx: Session accepted from the client. Freed on return
+ * clientsd: Connection of the session. Closed on return
+ * arg: NUM_PROXIES blacklist bloom filters of NUM_BLOOM_INTS ints each
+ * return: Nothing
+ ****/
+static void serve_session(struct tls *cctx, int clientsd, void *arg)
+{
+	const unsigned int *bloom_filters = arg;
+	unsigned int num_requests = 0;
+	int from_peer = peer_connected(clientsd);
+	struct tls_stream stream;
+	struct deadline deadline;
+
+	deadline_init(&deadline);
+	stream_init(&stream, cctx);
+	__atomic_add_fetch(&open_sessions, 1, __ATOMIC_RELAXED);
+	metrics_add(COUNTER_OPEN_CONNECTIONS, 0, 1);
+	for (;;) {
+		/**** Receive request for object from client ****/
+		char request[MAX_LINE];
+		char *proxy_name = NULL;
+		char *object_name = NULL;
+		char *range = NULL;
+		char *saveptr;
+		struct trace_context trace;
+
+		/*
+		 * The idle deadline covers the wait for the first request to start and the
+		 * shorter keep-alive deadline the wait for each later one, so an idle session
+		 * does not hold its worker and admission slot for long. Once a request starts,
+		 * the rest of the request line has to arrive before the read deadline.
+		 * Requests the client sent ahead are already buffered and do not wait
+		 */
+		deadline_arm(&deadline, num_requests == 0 ? DEADLINE_IDLE : DEADLINE_KEEPALIVE, clientsd);
+		int started = stream_wait(&stream);
+		if (started != 1) {
+			if (started == -1 || num_requests == 0)
+				warnx("tls_read: %s", tls_error(cctx));
+			break;
+		}
+		unsigned long long reading = latency_clock();
+		unsigned long long arrived = capture_clock();
+		deadline_arm(&deadline, DEADLINE_READ, clientsd);
+		if (stream_read_line(&stream, request, sizeof(request)) != 1) {
+			warnx("tls_read: %s", tls_error(cctx));
+			break;
+		}
+		deadline_cancel(&deadline);
+		latency_record(STAGE_REQUEST_READ, reading);
+		num_requests++;
+
+		if (trace_extract(request, &trace) == -1)	// Requests from clients that do not send an ID get one here
+			trace_new(&trace, trace_sample);
+		trace_begin(&trace);
+		proxy_name = strtok_r(request, " ", &saveptr);
+		object_name = strtok_r(NULL, " ", &saveptr);
+		range = strtok_r(NULL, " ", &saveptr);
+		if (proxy_name == NULL || (object_name == NULL && strcmp(proxy_name, REQ_DIGEST) != 0))
+			warnx("Malformed request");
+		else if (object_name == NULL)
+			log_debug("Received digest request %016llx", trace.id);
+		else
+			log_info("Received request %016llx for proxy server %s for %s%s%s", trace.id, proxy_name, object_name,
+			    range != NULL ? " " : "", range != NULL ? range : "");
+		/**** End receive request for object from client ****/
+
+		/**** Check respective proxy's blacklist for object ****/
+		unsigned int filter_index;
+		for (filter_index = 0; filter_index < NUM_PROXIES && proxy_name != NULL; filter_index++) {	// Check if requested proxy server is in list
+			if (strcmp(PROXY_NAMES[filter_index], proxy_name) == 0)
+				break;
+		}
+		if (filter_index < NUM_PROXIES)
+			metrics_add(COUNTER_REQUESTS, filter_index, 1);
+
+		struct cache_entry entry;
+		enum capture_outcome outcome = CAPTURE_DENIED;
+		int served = 0;
+		cache_entry_init(&entry);
+
+		if (filter_index == NUM_PROXIES && proxy_name != NULL && !from_peer &&
+		    (strcmp(proxy_name, REQ_DIGEST) == 0 || strcmp(proxy_name, REQ_PEER) == 0)) {
+			send_status(cctx, RESP_INVALID);		// Only peers may read the digest or bypass node_mask
+			metrics_add(COUNTER_INVALID_REQUESTS, 0, 1);
+			log_info("%s request from a host that is not a peer. Denied request", proxy_name);
+		} else if (filter_index == NUM_PROXIES && proxy_name != NULL && strcmp(proxy_name, REQ_DIGEST) == 0) {
+			send_digest(cctx, &deadline);
+		} else if (filter_index == NUM_PROXIES && proxy_name != NULL && strcmp(proxy_name, REQ_PEER) == 0 &&
+		    object_name != NULL && valid_object_name(object_name)) {
+			served = serve_peer(cctx, &deadline, object_name, &entry, &outcome);	// Peers are answered from the cache only, never the server
+		} else if (filter_index < NUM_PROXIES && !(node_mask & (1u << filter_index))) {
+			send_status(cctx, RESP_INVALID);
+			metrics_add(COUNTER_INVALID_REQUESTS, 0, 1);
+			log_info("Request was for proxy server %s, which another node serves. Denied request", proxy_name);
+		} else if (object_name == NULL || filter_index == NUM_PROXIES || !valid_object_name(object_name)) {
+			send_status(cctx, RESP_INVALID);		// Answered so requests sent ahead stay matched with their responses
+			metrics_add(COUNTER_INVALID_REQUESTS, 0, 1);
+			log_info("Request was malformed, for unknown proxy server or for invalid object name. Denied request");
+		} else if (check_blacklist(&bloom_filters[filter_index * NUM_BLOOM_INTS], object_name)) {
+			send_status(cctx, RESP_BLACKLISTED);					// Requested object was blacklisted
+			metrics_add(COUNTER_BLACKLISTED, filter_index, 1);
+			log_info("Request was for black-listed object %s. Denied request", object_name);
+		/**** End check respective proxy's blacklist for object ****/
+		} else if ((served = serve_request(cctx, &deadline, filter_index, object_name, range,
+		    hot_record(object_name) ? hot_replicas : 0, &entry, &outcome)) == 1) {
+			revalidate_later(object_name);
+		}
+		if (capture_enabled() && object_name != NULL && filter_index < NUM_PROXIES && valid_object_name(object_name))
+			capture_write(arrived, object_name, entry.chunks != NULL ? entry.size : 0, outcome);
+		if (cache_size > 0 && (outcome == CAPTURE_HIT || outcome == CAPTURE_MISS) && entry.chunks != NULL)
+			metrics_add(COUNTER_CACHE_EVICTIONS, 0, cache_account(object_name, entry.size));
+		cache_entry_free(&entry);
+		trace_end("request", reading, object_name);
+		if (served == -1) {			// Later responses would be read as the rest of the cut short body
+			log_info("Closing session after a response that could not be sent in full");
+			break;
+		}
+	}
+	deadline_cancel(&deadline);
+
+	/**** Close TLS connection to client ****/
+	unsigned long long closing = latency_clock();
+	if (tls_close(cctx) != 0)
+		warnx("tls_close: %s", tls_error(cctx));
+	log_debug("Closed TLS client after %u requests", num_requests);
+
+	tls_free(cctx);
+	log_debug("Freed TLS client");
+
+	close(clientsd);
+	metrics_add(COUNTER_OPEN_CONNECTIONS, 0, -1);
+	__atomic_sub_fetch(&open_sessions, 1, __ATOMIC_RELAXED);
+	latency_record(STAGE_CLOSE, closing);
+	/**** End close TLS connection to client ****/
+
+	trace_clear();
+	latency_flush();
+}
+
+/****
+ * Serve one client connection: accept the TLS session and answer the client's request
+ * ctx: Configured TLS server context
+ * clientsd: Accepted connection. Closed on return
+ * bloom_filters: NUM_PROXIES blacklist bloom filters of NUM_BLOOM_INTS ints each
+ * accepted: Time the connection was accepted, from latency_clock
+ * return: Nothing
+ ****/
+static void handle_connection(struct tls *ctx, int clientsd, const unsigned int *bloom_filters, unsigned long long accepted)
+{
+	struct tls *cctx = NULL;
+	struct deadline idle;
+	int ret;
+
+	/**** TLS connection with client ****/
+	trace_clear();					// A worker's previous connection may have left spans behind
+	unsigned long long started = latency_record(STAGE_ACCEPT, accepted);
+	if (tls_accept_socket(ctx, &cctx, clientsd) != 0) {
+		warnx("tls_accept_socket: %s", tls_error(ctx));
+		close(clientsd);
+		return;
+	}
+	deadline_init(&idle);
+	deadline_arm(&idle, DEADLINE_IDLE, clientsd);
+	do {
+		ret = tls_handshake(cctx);
+	} while (ret == TLS_WANT_POLLIN || ret == TLS_WANT_POLLOUT);
+	deadline_cancel(&idle);
+	if (ret != 0) {
+		warnx("tls_handshake: %s", tls_error(cctx));
+		tls_free(cctx);
+		close(clientsd);
+		return;
+	}
+	latency_record(STAGE_HANDSHAKE, started);
+	log_debug("Accepted TLS socket");
+	/**** End TLS connection with client ****/
+
+	serve_session(cctx, clientsd, (void *)bloom_filters);
+}
+
+/****
+ * Run a fixed pool of worker processes that each accept and serve connections one
+ * after another on the shared listening socket. A worker that exits is replaced
+ * sd: Listening socket
+ * return: Never returns
+ ****/
+static void run_prefork(unsigned int num_workers, int sd, struct tls *ctx, const unsigned int *bloom_filters)
+{
+	pid_t workers[num_workers];
+	unsigned int i;
+
+	memset(workers, 0, sizeof(workers));
+	signal(SIGCHLD, SIG_DFL);			// Workers are reaped below so they can be replaced
+
+	for (;;) {
+		for (i = 0; i < num_workers; i++) {
+			if (workers[i] != 0)
+				continue;
+
+			if ((workers[i] = fork()) == -1)
+				err(1, "fork failed");
+			if (workers[i] == 0) {
+				log_info("Worker %u accepting connections with pid %ld", i, (long)getpid());
+				for (;;) {
+					struct sockaddr_in client;
+					socklen_t clientlen = sizeof(client);
+					int clientsd = accept(sd, (struct sockaddr *)&client, &clientlen);
+					if (clientsd == -1) {
+						if (errno == EINTR || errno == ECONNABORTED)
+							continue;
+						err(1, "accept failed");
+					}
+					handle_connection(ctx, clientsd, bloom_filters, latency_clock());
+				}
+			}
+		}
+
+		pid_t pid = waitpid(WAIT_ANY, NULL, 0);
+		if (pid == -1 && errno != EINTR)
+			err(1, "waitpid failed");
+		for (i = 0; i < num_workers; i++) {
+			if (workers[i] == pid) {
+				log_info("Worker %u exited. Starting a replacement", i);
+				workers[i] = 0;
+			}
+		}
+	}
+}
+
 static void kidhandler(int signum) {
-	/* signal handler for SIGCHLD */
-	waitpid(WAIT_ANY, NULL, WNOHANG);
+	/* signal handler for SIGCHLD. Signals of children exiting together are merged */
+	while (waitpid(WAIT_ANY, NULL, WNOHANG) > 0)
+		;
 }
 
+static void wakehandler(int signum) {
+	/* SIGCHLD only interrupts ppoll in the accept loop, which reaps the children itself */
+}
+
+/****
+ * Fork a child to serve a connection
+ * return: The child's pid
+ ****/
+static pid_t start_connection(struct tls *ctx, struct tls_config *cfg, int clientsd, const unsigned int *bloom_filters,
+    const sigset_t *child_mask)
+{
+	unsigned long long accepted = latency_clock();
+	pid_t pid;
+
+	/*
+	 * We fork child to deal with each connection, this way more
+	 * than one client can connect to us and get served at any one
+	 * time.
+	 */
+	pid = fork();
+	if (pid == -1)
+	     err(1, "fork failed");
+
+	if(pid == 0) {
+		sigprocmask(SIG_SETMASK, child_mask, NULL);
+		handle_connection(ctx, clientsd, bloom_filters, accepted);
+		latency_flush();
+
+		tls_free(ctx);
+		log_debug("Freed TLS proxy server");
+
+		tls_config_free(cfg);
+		log_debug("Freed TLS config");
+
+		exit(0);
+	}
+
+	close(clientsd);
+	return pid;
+}
+
+/****
+ * Take the sessions still open when the process exits, e.g. through err(), off the
+ * open connections gauge
+ * return: Nothing
+ ****/
+static void sessions_closed()
+{
+	metrics_add(COUNTER_OPEN_CONNECTIONS, 0, -(long long)__atomic_load_n(&open_sessions, __ATOMIC_RELAXED));
+}
+
+/****
+ * Write the statistics that are not counters to the admin port: the fill ratio and
+ * estimated false positive rate of every blacklist filter, stage latencies and the
+ * bytes and objects counted against the cache's limit
+ * return: Nothing
+ ****/
+static void write_metrics(FILE *fp)
+{
+	double fill[NUM_PROXIES];
+	unsigned int i, j;
+
+	for (i = 0; i < NUM_PROXIES; i++) {
+		unsigned long long set = 0;
+		for (j = 0; j < NUM_BLOOM_INTS; j++)
+			set += __builtin_popcount(blacklist_filters[i * NUM_BLOOM_INTS + j]);
+		fill[i] = (double)set / NUM_BLOOM_BITS;
+	}
+	fprintf(fp, "# HELP tlscache_proxy_bloom_fill_ratio Share of blacklist filter bits that are set\n"
+	    "# TYPE tlscache_proxy_bloom_fill_ratio gauge\n");
+	for (i = 0; i < NUM_PROXIES; i++) {
+		if (node_mask & (1u << i))			// Filters of proxy servers other nodes serve stay empty
+			fprintf(fp, "tlscache_proxy_bloom_fill_ratio{proxy=\"%s\"} %g\n", PROXY_NAMES[i], fill[i]);
+	}
+	fprintf(fp, "# HELP tlscache_proxy_bloom_false_positive_rate Estimated blacklist false positive rate, fill ratio to the "
+	    "power of the number of hashes\n# TYPE tlscache_proxy_bloom_false_positive_rate gauge\n");
+	for (i = 0; i < NUM_PROXIES; i++) {
+		double rate = 1;
+		if (!(node_mask & (1u << i)))
+			continue;
+		for (j = 0; j < NUM_BLOOM_HASHES; j++)
+			rate *= fill[i];
+		fprintf(fp, "tlscache_proxy_bloom_false_positive_rate{proxy=\"%s\"} %g\n", PROXY_NAMES[i], rate);
+	}
+
+	latency_write_metrics(fp, "tlscache_proxy_stage_seconds");
+
+	struct hot_object hot[MAX_HOT_OBJECTS];
+	unsigned int num_hot = hot_list(hot, MAX_HOT_OBJECTS);
+	fprintf(fp, "# HELP tlscache_proxy_hot_object_share Share of recent requests taken by each hot object, at least\n"
+	    "# TYPE tlscache_proxy_hot_object_share gauge\n");
+	for (i = 0; i < num_hot; i++) {
+		const char *c;
+		fprintf(fp, "tlscache_proxy_hot_object_share{object=\"");
+		for (c = hot[i].name; *c != '\0'; c++)
+			fprintf(fp, *c == '"' || *c == '\\' ? "\\%c" : "%c", *c);
+		fprintf(fp, "\"} %g\n", hot[i].share);
+	}
+
+	long long misses = 0;
+	for (i = 0; i < NUM_PROXIES; i++)
+		misses += metrics_value(COUNTER_CACHE_MISSES, i);
+	fprintf(fp, "# HELP tlscache_proxy_origin_offload_ratio Share of cache misses fetched from a peer instead of the server\n"
+	    "# TYPE tlscache_proxy_origin_offload_ratio gauge\ntlscache_proxy_origin_offload_ratio %g\n",
+	    misses > 0 ? (double)metrics_value(COUNTER_PEER_FETCHES, PEER_HIT) / misses : 0);
+
+	unsigned long long cached_bytes;
+	unsigned int cached_objects;
+	if (cache_usage(&cached_bytes, &cached_objects) == 0)
+		fprintf(fp, "# HELP tlscache_proxy_cache_bytes Bytes of the objects counted against the cache's limit\n"
+		    "# TYPE tlscache_proxy_cache_bytes gauge\ntlscache_proxy_cache_bytes %llu\n"
+		    "# HELP tlscache_proxy_cache_objects Objects counted against the cache's limit\n"
+		    "# TYPE tlscache_proxy_cache_objects gauge\ntlscache_proxy_cache_objects %u\n", cached_bytes, cached_objects);
+}
 
 int main(int argc, char *argv[])
 {
-	if (argc != 4 || strcmp(argv[1], "-port") != 0)			// Check if executable is used properly
+	if (argc < 4 || argc % 2 != 0 || strcmp(argv[1], "-port") != 0)	// Check if executable is used properly
                 usage();
 
+	unsigned int default_ttl = DEFAULT_TTL;
+	unsigned int num_shards = 1;
+	unsigned int num_workers = 0;
+	unsigned int num_transfer_threads = 0;
+	unsigned int num_handshake_threads = DEFAULT_HANDSHAKE_THREADS;
+	int backlog = DEFAULT_BACKLOG;
+	struct admission_config admission = { DEFAULT_MAX_IN_FLIGHT, DEFAULT_ADMISSION_QUEUE, DEFAULT_QUEUE_TIMEOUT, 0,
+	    DEFAULT_CLIENT_BURST };
+	enum log_level log_level = LOG_LEVEL_INFO;
+	int log_content = 0;
+	u_short admin_port = 0;
+	const char *trace_path = NULL;
+	const char *capture_path = NULL;
+	enum policy_kind cache_policy = POLICY_LRU;
+	char cache_dir[255];
+	char node_dir[128] = "";
+	const char *peers_path = NULL;
+	unsigned int hot_share = DEFAULT_HOT_SHARE;
+	int admission_options = 0;
+	int arg;
+	deadline_set_timeout(DEADLINE_IDLE, DEFAULT_IDLE_TIMEOUT);
+	deadline_set_timeout(DEADLINE_KEEPALIVE, DEFAULT_KEEPALIVE_TIMEOUT);
+	deadline_set_timeout(DEADLINE_READ, DEFAULT_READ_TIMEOUT);
+	deadline_set_timeout(DEADLINE_WRITE, DEFAULT_WRITE_TIMEOUT);
+	deadline_set_timeout(DEADLINE_ORIGIN, DEFAULT_ORIGIN_TIMEOUT);
+	for (arg = 4; arg < argc; arg += 2) {				// Optional settings come in pairs after the server
+		admission_options += admission_option(argv[arg]);
+		if (strcmp(argv[arg], "-ttl") == 0)
+			default_ttl = parse_number(argv[arg + 1], UINT_MAX);
+		else if (strcmp(argv[arg], "-swr") == 0)
+			stale_while_revalidate = parse_number(argv[arg + 1], UINT_MAX);
+		else if (strcmp(argv[arg], "-disk-io") == 0 && strcmp(argv[arg + 1], "uring") == 0)
+			disk_io_backend = AIO_URING;
+		else if (strcmp(argv[arg], "-disk-io") == 0 && strcmp(argv[arg + 1], "threads") == 0)
+			disk_io_backend = AIO_THREADS;
+		else if (strcmp(argv[arg], "-batch-window") == 0)
+			batch_window = parse_number(argv[arg + 1], 1000);
+		else if (strcmp(argv[arg], "-shards") == 0)
+			num_shards = parse_number(argv[arg + 1], MAX_SHARDS);
+		else if (strcmp(argv[arg], "-backlog") == 0)
+			backlog = parse_number(argv[arg + 1], INT_MAX);
+		else if (strcmp(argv[arg], "-prefork") == 0)
+			num_workers = parse_number(argv[arg + 1], MAX_WORKERS);
+		else if (strcmp(argv[arg], "-threads") == 0)
+			num_transfer_threads = parse_number(argv[arg + 1], MAX_WORKERS);
+		else if (strcmp(argv[arg], "-handshake-threads") == 0)
+			num_handshake_threads = parse_number(argv[arg + 1], MAX_WORKERS);
+		else if (strcmp(argv[arg], "-max-in-flight") == 0)
+			admission.max_in_flight = parse_number(argv[arg + 1], UINT_MAX);
+		else if (strcmp(argv[arg], "-queue") == 0)
+			admission.max_queue = parse_number(argv[arg + 1], UINT_MAX - 1);
+		else if (strcmp(argv[arg], "-queue-timeout") == 0)
+			admission.queue_timeout = parse_number(argv[arg + 1], INT_MAX);
+		else if (strcmp(argv[arg], "-client-rate") == 0)
+			admission.client_rate = parse_number(argv[arg + 1], UINT_MAX);
+		else if (strcmp(argv[arg], "-client-burst") == 0)
+			admission.client_burst = parse_number(argv[arg + 1], UINT_MAX);
+		else if (strcmp(argv[arg], "-idle-timeout") == 0)
+			deadline_set_timeout(DEADLINE_IDLE, parse_number(argv[arg + 1], INT_MAX));
+		else if (strcmp(argv[arg], "-keepalive-timeout") == 0)
+			deadline_set_timeout(DEADLINE_KEEPALIVE, parse_number(argv[arg + 1], INT_MAX));
+		else if (strcmp(argv[arg], "-read-timeout") == 0)
+			deadline_set_timeout(DEADLINE_READ, parse_number(argv[arg + 1], INT_MAX));
+		else if (strcmp(argv[arg], "-write-timeout") == 0)
+			deadline_set_timeout(DEADLINE_WRITE, parse_number(argv[arg + 1], INT_MAX));
+		else if (strcmp(argv[arg], "-origin-timeout") == 0)
+			deadline_set_timeout(DEADLINE_ORIGIN, parse_number(argv[arg + 1], INT_MAX));
+		else if (strcmp(argv[arg], "-log-level") == 0 && log_parse_level(argv[arg + 1], &log_level) == 0)
+			continue;
+		else if (strcmp(argv[arg], "-log-content") == 0 && strcmp(argv[arg + 1], "on") == 0)
+			log_content = 1;
+		else if (strcmp(argv[arg], "-log-content") == 0 && strcmp(argv[arg + 1], "off") == 0)
+			log_content = 0;
+		else if (strcmp(argv[arg], "-admin-port") == 0)
+			admin_port = parse_number(argv[arg + 1], USHRT_MAX);
+		else if (strcmp(argv[arg], "-trace") == 0)
+			trace_path = argv[arg + 1];
+		else if (strcmp(argv[arg], "-trace-sample") == 0)
+			trace_sample = parse_number(argv[arg + 1], ULONG_MAX);
+		else if (strcmp(argv[arg], "-capture") == 0)
+			capture_path = argv[arg + 1];
+		else if (strcmp(argv[arg], "-cache-size") == 0)
+			cache_size = parse_number(argv[arg + 1], ULONG_MAX);
+		else if (strcmp(argv[arg], "-cache-policy") == 0 && policy_parse(argv[arg + 1], &cache_policy) == 0)
+			continue;
+		else if (strcmp(argv[arg], "-node") == 0)
+			node_mask = parse_node(argv[arg + 1], node_dir, sizeof(node_dir));
+		else if (strcmp(argv[arg], "-peers") == 0)
+			peers_path = argv[arg + 1];
+		else if (strcmp(argv[arg], "-hot-replicas") == 0 && parse_number(argv[arg + 1], NUM_PROXIES) != 1)
+			hot_replicas = parse_number(argv[arg + 1], NUM_PROXIES);
+		else if (strcmp(argv[arg], "-hot-share") == 0 && parse_number(argv[arg + 1], 100) > 0)
+			hot_share = parse_number(argv[arg + 1], 100);
+		else if (strcmp(argv[arg], "-peer-interval") == 0 && parse_number(argv[arg + 1], UINT_MAX) > 0)
+			peer_interval = parse_number(argv[arg + 1], UINT_MAX);
+		else
+			usage();
+	}
+	if (num_shards == 0 || num_handshake_threads == 0 || (admission.client_rate > 0 && admission.client_burst == 0) ||
+	    (peers_path != NULL && node_dir[0] == '\0') || (admission_options > 0 && (num_workers > 0 || num_transfer_threads > 0)))
+		usage();
+
+	/*
+	 * first, figure out what port we will listen on - it should
+	 * be our first parameter. Every argument is checked before any
+	 * shard is forked
+	 */
+	u_short port = parse_number(argv[2], USHRT_MAX);
+	server_name = strtok(argv[3], ":");
+	server_name++;
+	server_port = strtok(NULL, ":");
+	if (*server_name == '\0' || server_port == NULL)
+		usage();
+
+	log_init(STDOUT_FILENO, log_level, log_content);
+	if (trace_path != NULL)
+		trace_init(trace_path, "proxy");
+	if (capture_path != NULL)
+		capture_open(capture_path);
+	snprintf(cache_dir, sizeof(cache_dir), "%s%s%s", PROXY_DIR, node_dir, node_dir[0] ? "/" : "");
+	if (mkdir(cache_dir, 0755) == -1 && errno != EEXIST)		// A node caches in its own partition
+		err(1, "mkdir %s", cache_dir);
+	cache_init(cache_dir, PROXY_DIR, default_ttl);
+	if (peers_path != NULL)
+		peer_init(peers_path, node_mask);
+	if (hot_replicas > 0)
+		hot_init(hot_share);
+	if (cache_size > 0)
+		cache_limit(cache_size, cache_policy);
+	latency_init(STAGE_NAMES, NUM_STAGES);
+	latency_dump_on_signal(SIGUSR1);
+	metrics_init(COUNTERS, NUM_COUNTERS);
+	atexit(sessions_closed);			// Inherited by every forked worker and shard
+
 	/**** Create bloom filters for each proxy  ****/
-	unsigned int bloom_filters[NUM_PROXIES][NUM_BLOOM_INTS];
-	memset(bloom_filters, 0, sizeof(bloom_filters));
-	printf("Created bloom filters for blacklisted objects for each proxy server\n");
-	printf("\n");
+	size_t bloom_filters_size = NUM_PROXIES * NUM_BLOOM_INTS * sizeof(unsigned int);
+	unsigned int *bloom_filters = map_shared(bloom_filters_size);
+	blacklist_filters = bloom_filters;
+	log_debug("Created bloom filters for blacklisted objects for each proxy server");
 	/**** End create bloom filters for each proxy ****/
 
 	/**** Insert blacklisted objects into bloom filters for their respective proxy servers ****/
@@ -155,123 +1826,83 @@ int main(int argc, char *argv[])
 	FILE *blacklist;
 	blacklist = fopen(blacklist_filename, "r");
 
-	printf("Entering blacklisted objects into bloom filter:\n");
+	log_debug("Entering blacklisted objects into bloom filter");
 	char blacklisted_object[255];
 	memset(blacklisted_object, 0, sizeof(blacklisted_object));
 	
 	while (fscanf(blacklist, "%s", blacklisted_object) > 0) {
 		/**** Rendezvous hashing to select which proxy's bloom filter the object will be entered into ****/
-	        uint32_t hashes[NUM_PROXIES];
-		unsigned int i;
-		for (i = 0; i < NUM_PROXIES; i++) {                     // Calculate hashes for object_name.PROXY_NAMES[i]
-                        char str[255];
-                        memset(str, 0, sizeof(str));
-                        strcpy(str, blacklisted_object);
-                        strcat(str, PROXY_NAMES[i]);
-                        MurmurHash3_x86_32(str, strlen(str), 42, &hashes[i]);
-                        printf("%s|%s: %x\n", blacklisted_object, PROXY_NAMES[i], hashes[i]);
-                }
-
-                unsigned int max_index = 0;
-                for (i = 0; i < NUM_PROXIES; i++) {                     // Get index of proxy that produced the highest hash value
-                        if (hashes[i] > hashes[max_index])
-                                max_index = i;
-                }
+		unsigned int max_index = rendezvous_proxy(blacklisted_object);	// The proxy server clients send the object's requests to
 		/**** End rendezvous hashing to select which proxy's bloom filter the object will be entered into ****/
 
-		insert_bloom_filter(&bloom_filters[max_index][0], NUM_BLOOM_HASHES, NUM_BLOOM_BITS, blacklisted_object);		
-		printf("Entered %s into proxy %s's bloom filter\n", blacklisted_object, PROXY_NAMES[max_index]);
-	        printf("\n");
+		if (!(node_mask & (1u << max_index))) {			// Another node serves that proxy server
+			memset(blacklisted_object, 0, sizeof(blacklisted_object));
+			continue;
+		}
+		insert_bloom_filter(&bloom_filters[max_index * NUM_BLOOM_INTS], NUM_BLOOM_HASHES, NUM_BLOOM_BITS, blacklisted_object);		
+		log_debug("Entered %s into proxy %s's bloom filter", blacklisted_object, PROXY_NAMES[max_index]);
 		memset(blacklisted_object, 0, sizeof(blacklisted_object));
 	}
 	fclose(blacklist);
+	if (mprotect(bloom_filters, bloom_filters_size, PROT_READ) == -1)	// Processes only read the filters from here on
+		err(1, "mprotect");
 	/**** End insert blacklisted objects into bloom filters for their respective proxy servers ****/
 
+	if (batch_window > 0)
+		start_batch_coordinator();
+	if (stale_while_revalidate > 0)
+		start_revalidator();
+	unsigned int shard = start_shards(num_shards);
+
 	/**** Configure TLS connection to client ****/
 	struct tls_config *cfg = NULL;
-	struct tls *ctx = NULL, *cctx = NULL;
+	struct tls *ctx = NULL;
 	uint8_t *mem;
 	size_t mem_len;
 
 	if (tls_init() != 0)
 		err(1, "tls_init:");
-	printf("Initialized TLS\n");
+	log_debug("Initialized TLS");
 
 	if ((cfg = tls_config_new()) == NULL)
 		err(1, "tls_config_new:");
-	printf("Got TLS config\n");
+	log_debug("Got TLS config");
 
 	if ((mem = tls_load_file("../../certificates/root.pem", &mem_len, NULL)) == NULL)
 		err(1, "tls_load_file(ca):");
 	if (tls_config_set_ca_mem(cfg, mem, mem_len) != 0)
 		err(1, "tls_config_set_ca_mem:");
-	printf("Set root certificate\n");
+	log_debug("Set root certificate");
 
 	if ((mem = tls_load_file("../../certificates/server.crt", &mem_len, NULL)) == NULL)
 		err(1, "tls_load_file(server):");
 	if (tls_config_set_cert_mem(cfg, mem, mem_len) != 0)
 		err(1, "tls_config_set_cert_mem:");
-	printf("Set proxy server certificate\n");	
+	log_debug("Set proxy server certificate");
 
 	if ((mem = tls_load_file("../../certificates/server.key", &mem_len, NULL)) == NULL)
 		err(1, "tls_load_file(serverkey):");
 	if (tls_config_set_key_mem(cfg, mem, mem_len) != 0)
 		err(1, "tls_config_set_key_mem:");
-	printf("Set proxy server private key\n");	
+	log_debug("Set proxy server private key");
 
 	if ((ctx = tls_server()) == NULL)
 		err(1, "tls_server:");
-	printf("Got TLS proxy server\n");
+	log_debug("Got TLS proxy server");
 
 	if (tls_configure(ctx, cfg) != 0)
 		err(1, "tls_configure: %s", tls_error(ctx));
-	printf("Configured TLS proxy server with TLS config\n");
+	log_debug("Configured TLS proxy server with TLS config");
 	/**** End configure TLS connection to client ****/
 
 	/**** Configure TCP connection with client ****/
-	struct sockaddr_in sockname, client;
-	char *ep;
+	struct sockaddr_in client;
 	struct sigaction sa;
 	int sd;
 	socklen_t clientlen;
-	u_short port;
 	pid_t pid;
-	u_long p;
-
-	/*
-	 * first, figure out what port we will listen on - it should
-	 * be our first parameter.
-	 */
-	errno = 0;
-        p = strtoul(argv[2], &ep, 10);
-        if (*argv[2] == '\0' || *ep != '\0') {
-		/* parameter wasn't a number, or was empty */
-		fprintf(stderr, "%s - not a number\n", argv[2]);
-		usage();
-	}
-        if ((errno == ERANGE && p == ULONG_MAX) || (p > USHRT_MAX)) {
-		/* It's a number, but it either can't fit in an unsigned
-		 * long, or is too big for an unsigned short
-		 */
-		fprintf(stderr, "%s - value out of range\n", argv[2]);
-		usage();
-	}
-	/* now safe to do this */
-	port = p;
-
-	memset(&sockname, 0, sizeof(sockname));
-	sockname.sin_family = AF_INET;
-	sockname.sin_port = htons(port);
-	sockname.sin_addr.s_addr = htonl(INADDR_ANY);
-	sd = socket(AF_INET,SOCK_STREAM,0);
-	if (sd == -1)
-		err(1, "socket failed");
-
-	if (bind(sd, (struct sockaddr *) &sockname, sizeof(sockname)) == -1)
-		err(1, "bind failed");
 
-	if (listen(sd, 3) == -1)
-		err(1, "listen failed");
+	sd = listen_socket(port, backlog, num_shards > 1);
 
 	/*
 	 * we're now bound, and listening for connections on "sd" -
@@ -295,148 +1926,64 @@ int main(int argc, char *argv[])
         if (sigaction(SIGCHLD, &sa, NULL) == -1)
                 err(1, "sigaction failed");
 
-	printf("Proxy server up and listening for connections on port %u\n", port);
+	signal(SIGPIPE, SIG_IGN);		// Writes to a connection shut down by a deadline fail instead of killing the process
+	log_info("Proxy server up and listening for connections on port %u", port);
+	if (shard == 0 && admin_port != 0) {
+		metrics_serve(admin_port, write_metrics);
+		log_info("Serving metrics on http://127.0.0.1:%u/metrics", admin_port);
+	}
+	if (shard == 0 && peer_count() > 0) {
+		pthread_t refresher;
+		if (pthread_create(&refresher, NULL, refresh_peers, NULL) != 0)
+			errx(1, "pthread_create failed");
+		log_info("Exchanging cache digests with %u peers every %u seconds", peer_count(), peer_interval);
+	}
 	/**** End configure TCP connection with client ****/
 
-	for(;;) {
-		/**** TCP connection with client ****/
-		int clientsd;
-		clientlen = sizeof(&client);
-		clientsd = accept(sd, (struct sockaddr *)&client, &clientlen);
-		if (clientsd == -1)
-			err(1, "accept failed");
-		/**** TCP connection with client ****/
-	
-		/*
-		 * We fork child to deal with each connection, this way more
-		 * than one client can connect to us and get served at any one
-		 * time.
-		 */
+	if (num_transfer_threads > 0)
+		pool_run(sd, ctx, num_handshake_threads, num_transfer_threads, serve_session, bloom_filters);
+	if (num_workers > 0)
+		run_prefork(num_workers, sd, ctx, bloom_filters);
 
-		pid = fork();
-		if (pid == -1)
-		     err(1, "fork failed");
-
-		if(pid == 0) {
-			/**** TLS connection with client ****/
-			if (tls_accept_socket(ctx, &cctx, clientsd) != 0)
-				err(1, "tls_accept_socket: %s", tls_error(ctx));
-			printf("Accepted TLS socket\n");
-			printf("\n");	
-			/**** End TLS connection with client ****/
-
-			/**** Receive request for object from client ****/
-			char request[255];
-			char *proxy_name;
-			char *object_name;
-			memset(request, 0, sizeof(request));
-			
-			if (tls_read(cctx, request, sizeof(request)) < 0)
-				err(1, "tls_read: %s", tls_error(cctx));
-			
-			proxy_name = strtok(request, " ");
-			object_name = strtok(NULL, " ");
-			printf("Received request for proxy server %s for %s\n", proxy_name, object_name); 
-			/**** End receive request for object from client ****/
-
-			/**** Check respective proxy's blacklist for object ****/
-			unsigned int filter_index;
-			for (filter_index = 0; filter_index < NUM_PROXIES; filter_index++) {		// Check if requested proxy server is in list
-				if (strcmp(PROXY_NAMES[filter_index], proxy_name) == 0)
-					break;
-			}
-			
-			if (search_bloom_filter(&bloom_filters[filter_index][0], NUM_BLOOM_HASHES, NUM_BLOOM_BITS, object_name) == 1) {
-				char deny[] = "****black-listed****\n";					// Requested object was blacklisted
-				if (tls_write(cctx, deny, strlen(deny)) < 0)
-					err(1, "tls_write: %s", tls_error(cctx));
-				printf("Request was for black-listed object %s. Denied request\n", object_name);
-				printf("\n");
-			/**** End check respective proxy's blacklist for object ****/
-			} else {
-				/**** Send requested object to client ****/
-				FILE *fp;
-				char filename[255];
-				char content[255];
-				memset(filename, 0, sizeof(filename));
-				memset(content, 0, sizeof(content));
-				strcpy(filename, PROXY_DIR);
-				strcat(filename, object_name);
-
-				/**** Get requested object from server if object is not in proxy server's cache ****/
-				if ((fp = fopen(filename, "r")) == NULL) {
-					printf("Requested object is not in proxy server cache. Requesting object from server\n");
-					printf("\n");
-
-					char *server_name;
-					char *server_port;
-
-					server_name = strtok(argv[3], ":");
-					server_name++;
-					server_port = strtok(NULL, ":");
-
-					struct tls *server_ctx = setupTLSClient();
-					if (tls_connect(server_ctx, server_name, server_port) != 0)
-			                        err(1, "tls_connect: %s", tls_error(ctx));
-                			printf("Connected to server\n");
-                			printf("\n"); 
-
-					if (tls_write(server_ctx, object_name, strlen(object_name)) < 0)
-			                        err(1, "tls_write: %s", tls_error(ctx));
-			                printf("Sent request to server %s for %s\n", server_name, object_name);
-			
-					/**** Put requested object into proxy server's cache  ****/
-					fp = fopen(filename, "a+");
-					char response[255];
-					memset(response, 0, sizeof(response));
-			                printf("Server response:\n");
-			                while (tls_read(server_ctx, response, sizeof(response)) > 0){
-						fwrite(response, sizeof(char), sizeof(response), fp);
-			                        printf("%s", response);
-			                        memset(response, 0, sizeof(response));
-			                }
-					printf("\n");
-					printf("Put %s in proxy %s's cache\n", object_name, proxy_name);
-					/**** End put requested object into proxy server's cache  ****/
-
-			                fseek(fp, 0, SEEK_SET);
-					printf("\n");
-				}
-				/**** End get requested object from server if object is not in proxy server's cache ****/
-	
-				printf("Sent file content:\n");
-				while (fread(content, sizeof(char), sizeof(content), fp) > 0) {
-					if (tls_write(cctx, content, strlen(content)) < 0)
-						err(1, "tls_write: %s", tls_error(cctx));
-					printf("%s", content);
-					memset(content, 0, sizeof(content));
-				}
-				fclose(fp);
-				printf("\n");
-				/**** End send requested object to client ****/
-			}
-
-			/**** Close TLS connection to client ****/
-			if (tls_close(cctx) != 0)
-				err(1, "tls_close: %s", tls_error(cctx));
-			printf("Closed TLS client\n");
-			
-			tls_free(cctx);
-			printf("Freed TLS client\n"); 
-
-			tls_free(ctx);
-			printf("Freed TLS proxy server\n");
+	/*
+	 * Connections beyond the admission limit wait for a child to exit. SIGCHLD
+	 * stays blocked except inside ppoll, so a child exiting always wakes the loop
+	 */
+	sigset_t block_mask, wait_mask;
+	struct pollfd listen_pfd = { sd, POLLIN, 0 };
 
-			tls_config_free(cfg);
-			printf("Freed TLS config\n");
-			printf("\n");
+	admission_init(&admission, ctx, sd);
+	sa.sa_handler = wakehandler;
+	if (sigaction(SIGCHLD, &sa, NULL) == -1)
+		err(1, "sigaction failed");
+	sigemptyset(&block_mask);
+	sigaddset(&block_mask, SIGCHLD);
+	sigprocmask(SIG_BLOCK, &block_mask, &wait_mask);
 
-			close(clientsd);
-			/**** End close TLS connection to client ****/
+	for(;;) {
+		int clientsd;
+		int timeout = admission_timeout();
+		struct timespec ts;
 
-			exit(0);
+		if (timeout == -1 || timeout > ACCEPT_POLL_MS)
+			timeout = ACCEPT_POLL_MS;
+		ts.tv_sec = timeout / 1000;
+		ts.tv_nsec = (timeout % 1000) * 1000000L;
+		if (ppoll(&listen_pfd, 1, &ts, &wait_mask) > 0) {
+			/**** TCP connection with client ****/
+			clientlen = sizeof(client);
+			clientsd = accept(sd, (struct sockaddr *)&client, &clientlen);
+			if (clientsd == -1 && errno != EINTR && errno != ECONNABORTED)
+				err(1, "accept failed");
+			/**** TCP connection with client ****/
+			if (clientsd != -1 && admission_offer(clientsd, client.sin_addr))
+				admission_started(start_connection(ctx, cfg, clientsd, bloom_filters, &wait_mask));
 		}
 
-		close(clientsd);
+		while ((pid = waitpid(WAIT_ANY, NULL, WNOHANG)) > 0)
+			admission_finished(pid);
+		while ((clientsd = admission_next()) != -1)
+			admission_started(start_connection(ctx, cfg, clientsd, bloom_filters, &wait_mask));
+		admission_report();
 	}
 }
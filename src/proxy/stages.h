@@ -0,0 +1,24 @@
+/*
+ * stages.h - Stages of serving a proxy request whose latencies are recorded
+ */
+
+#ifndef _STAGES_H_
+#define _STAGES_H_
+
+enum stage {
+	STAGE_ACCEPT,				/* From accept, or leaving the admission queue, until the handshake starts */
+	STAGE_HANDSHAKE,			/* TLS handshake with the client */
+	STAGE_REQUEST_READ,			/* From the first byte of a request until the whole line is read */
+	STAGE_BLOOM_CHECK,			/* Blacklist check */
+	STAGE_CACHE_LOOKUP,			/* Reading the object's cache metadata */
+	STAGE_ORIGIN_CONNECT,			/* Connecting to the server, the TLS handshake and sending the request */
+	STAGE_ORIGIN_TRANSFER,			/* Receiving the response from the server into the cache */
+	STAGE_BATCH_WAIT,			/* Waiting for the batch coordinator to fetch a miss */
+	STAGE_CLIENT_WRITE,			/* Sending a response to the client */
+	STAGE_CLOSE,				/* Closing the client's session */
+	NUM_STAGES
+};
+
+extern const char *const STAGE_NAMES[];
+
+#endif // _STAGES_H_
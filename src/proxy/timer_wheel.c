@@ -0,0 +1,159 @@
+/*
+ * timer_wheel.c - Hierarchical timer wheel
+ *
+ * Timers are kept in WHEEL_LEVELS wheels of WHEEL_SLOTS slots. A slot of level 0
+ * holds the timers expiring at one tick, a slot of level n the timers expiring in
+ * a span of WHEEL_SLOTS^n ticks. Arming and cancelling a timer is a list insert or
+ * unlink. Whenever a lower level wraps around, the next slot of the level above is
+ * cascaded down, so every timer is moved at most WHEEL_LEVELS - 1 times before it
+ * expires. Timers further out than the wheel spans expire at the end of its span.
+ *
+ * The wheel does no locking. Callers sharing a wheel between threads serialize
+ * access themselves.
+ */
+
+#include <stddef.h>
+#include "timer_wheel.h"
+
+#define LEVEL_SPAN(level) ((uint64_t)1 << (WHEEL_BITS * (level)))
+
+static void list_init(struct timer *head) {
+	head->next = head->prev = head;
+}
+
+static void list_add(struct timer *head, struct timer *timer) {
+	timer->prev = head->prev;
+	timer->next = head;
+	head->prev->next = timer;
+	head->prev = timer;
+}
+
+static void list_del(struct timer *timer) {
+	timer->prev->next = timer->next;
+	timer->next->prev = timer->prev;
+	timer->next = timer->prev = NULL;
+}
+
+/****
+ * Put an armed timer into the slot covering its expiry time
+ * return: Nothing
+ ****/
+static void place(struct timer_wheel *wheel, struct timer *timer) {
+	uint64_t delta = timer->expires - wheel->now;
+	unsigned int level;
+
+	for (level = 0; level < WHEEL_LEVELS - 1 && delta >= LEVEL_SPAN(level + 1); level++)
+		;
+	list_add(&wheel->slots[level][(timer->expires >> (WHEEL_BITS * level)) & (WHEEL_SLOTS - 1)], timer);
+}
+
+/****
+ * Move the timers of a higher level slot down to the levels below
+ * return: Nothing
+ ****/
+static void cascade(struct timer_wheel *wheel, unsigned int level, unsigned int slot) {
+	struct timer *head = &wheel->slots[level][slot];
+	struct timer pending;
+
+	if (head->next == head)
+		return;
+	pending.next = head->next;		// Detach the whole list before placing its timers again
+	pending.prev = head->prev;
+	pending.next->prev = pending.prev->next = &pending;
+	list_init(head);
+
+	while (pending.next != &pending) {
+		struct timer *timer = pending.next;
+		list_del(timer);
+		place(wheel, timer);
+	}
+}
+
+/****
+ * Start an empty wheel
+ * now: Current tick
+ * return: Nothing
+ ****/
+void timer_wheel_init(struct timer_wheel *wheel, uint64_t now) {
+	unsigned int level, slot;
+
+	for (level = 0; level < WHEEL_LEVELS; level++) {
+		for (slot = 0; slot < WHEEL_SLOTS; slot++)
+			list_init(&wheel->slots[level][slot]);
+	}
+	wheel->now = now;
+	wheel->count = 0;
+}
+
+void timer_init(struct timer *timer, timer_callback expire) {
+	timer->next = timer->prev = NULL;
+	timer->expires = 0;
+	timer->expire = expire;
+}
+
+int timer_armed(const struct timer *timer) {
+	return timer->next != NULL;
+}
+
+/****
+ * Arm a timer, moving it if it is already armed. A timer due at or before the
+ * current tick expires at the next one
+ * expires: Tick to expire at
+ * return: Nothing
+ ****/
+void timer_arm(struct timer_wheel *wheel, struct timer *timer, uint64_t expires) {
+	if (timer_armed(timer))
+		list_del(timer);
+	else
+		wheel->count++;
+
+	if (expires <= wheel->now)
+		expires = wheel->now + 1;
+	if (expires - wheel->now >= LEVEL_SPAN(WHEEL_LEVELS))
+		expires = wheel->now + LEVEL_SPAN(WHEEL_LEVELS) - 1;
+	timer->expires = expires;
+	place(wheel, timer);
+}
+
+/****
+ * Disarm a timer. Does nothing if it is not armed
+ * return: Nothing
+ ****/
+void timer_cancel(struct timer_wheel *wheel, struct timer *timer) {
+	if (!timer_armed(timer))
+		return;
+	list_del(timer);
+	wheel->count--;
+}
+
+/****
+ * Process every tick up to now, calling the callbacks of the timers that expire.
+ * Callbacks may arm and cancel timers
+ * now: Current tick
+ * return: Number of timers that expired
+ ****/
+unsigned int timer_wheel_advance(struct timer_wheel *wheel, uint64_t now) {
+	unsigned int expired = 0;
+
+	while (wheel->now < now) {
+		if (wheel->count == 0) {		// Nothing to cascade or expire on the way
+			wheel->now = now;
+			break;
+		}
+
+		uint64_t tick = ++wheel->now;
+		unsigned int level;
+		for (level = 1; level < WHEEL_LEVELS && (tick & (LEVEL_SPAN(level) - 1)) == 0; level++)
+			cascade(wheel, level, (tick >> (WHEEL_BITS * level)) & (WHEEL_SLOTS - 1));
+
+		struct timer *head = &wheel->slots[0][tick & (WHEEL_SLOTS - 1)];
+		while (head->next != head) {
+			struct timer *timer = head->next;
+			list_del(timer);
+			wheel->count--;
+			expired++;
+			timer->expire(timer);
+		}
+	}
+	return expired;
+}
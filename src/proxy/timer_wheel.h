@@ -0,0 +1,38 @@
+/*
+ * timer_wheel.h - Hierarchical timer wheel
+ */
+
+#ifndef _TIMER_WHEEL_H_
+#define _TIMER_WHEEL_H_
+
+#include <stdint.h>
+
+#define WHEEL_BITS 6
+#define WHEEL_SLOTS (1 << WHEEL_BITS)
+#define WHEEL_LEVELS 4
+
+struct timer;
+typedef void (*timer_callback)(struct timer *timer);
+
+/* Embedded in the object a timer belongs to */
+struct timer {
+	struct timer *next;
+	struct timer *prev;
+	uint64_t expires;			/* Tick the timer expires at */
+	timer_callback expire;			/* Called once the timer expires */
+};
+
+struct timer_wheel {
+	uint64_t now;				/* Last tick that was processed */
+	unsigned int count;			/* Armed timers */
+	struct timer slots[WHEEL_LEVELS][WHEEL_SLOTS];	/* List heads. Level n slots span WHEEL_SLOTS^n ticks */
+};
+
+void timer_wheel_init(struct timer_wheel *wheel, uint64_t now);
+void timer_init(struct timer *timer, timer_callback expire);
+void timer_arm(struct timer_wheel *wheel, struct timer *timer, uint64_t expires);
+void timer_cancel(struct timer_wheel *wheel, struct timer *timer);
+int timer_armed(const struct timer *timer);
+unsigned int timer_wheel_advance(struct timer_wheel *wheel, uint64_t now);
+
+#endif // _TIMER_WHEEL_H_
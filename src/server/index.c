@@ -0,0 +1,316 @@
+/*
+ * index.c - In-memory index of the server's objects and cache of their open files
+ *
+ * The listening process scans the object directory once at startup into a hash
+ * table holding each object's size, modification time and validator, and keeps it
+ * current with inotify. Children forked for a connection inherit a snapshot of the
+ * table, so looking up an object, answering NOT_FOUND or checking a validator never
+ * touches the filesystem.
+ *
+ * The listening process also keeps the most recently requested objects open. The
+ * descriptors are inherited by the children, which read them with pread so the
+ * shared file offset does not matter. Children report the objects they serve back
+ * to the listening process, which keeps the open files in least recently used order.
+ */
+
+#include <sys/types.h>
+#include <sys/inotify.h>
+#include <sys/stat.h>
+
+#include <dirent.h>
+#include <err.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "index.h"
+#include "log.h"
+#include "murmur3.h"
+
+const uint32_t INDEX_SEED = 0x165;
+const unsigned int INITIAL_BUCKETS = 1024;
+const uint32_t WATCH_EVENTS = IN_CREATE | IN_CLOSE_WRITE | IN_MODIFY | IN_ATTRIB | IN_MOVED_TO | IN_MOVED_FROM | IN_DELETE;
+
+static char index_dir[255];
+static struct object_info **buckets;
+static unsigned int num_buckets;
+static unsigned int num_objects;
+
+static struct object_info *lru_head;
+static struct object_info *lru_tail;
+static unsigned int num_open_files;
+static unsigned int max_open;
+
+/****
+ * Build the validator of a stored object. The validator changes whenever the
+ * object's size or modification time changes
+ * validator: Buffer of at least VALIDATOR_LEN bytes
+ * return: Nothing
+ ****/
+static void make_validator(const struct stat *st, char *validator) {
+	snprintf(validator, VALIDATOR_LEN, "%llx-%llx", (unsigned long long)st->st_size, (unsigned long long)st->st_mtime);
+}
+
+static unsigned int bucket_of(const char *object_name, unsigned int count) {
+	uint32_t hash;
+	MurmurHash3_x86_32(object_name, strlen(object_name), INDEX_SEED, &hash);
+	return hash % count;
+}
+
+static void object_path(char *path, size_t size, const char *object_name) {
+	snprintf(path, size, "%s%s", index_dir, object_name);
+}
+
+/****
+ * Double the number of hash buckets once the table is fully loaded
+ * return: Nothing
+ ****/
+static void grow_table() {
+	unsigned int count = num_buckets ? num_buckets * 2 : INITIAL_BUCKETS;
+	struct object_info **table;
+	unsigned int i;
+
+	if ((table = calloc(count, sizeof(*table))) == NULL)
+		err(1, "calloc");
+	for (i = 0; i < num_buckets; i++) {
+		struct object_info *info, *next;
+		for (info = buckets[i]; info != NULL; info = next) {
+			unsigned int b = bucket_of(info->name, count);
+			next = info->next;
+			info->next = table[b];
+			table[b] = info;
+		}
+	}
+
+	free(buckets);
+	buckets = table;
+	num_buckets = count;
+}
+
+static void lru_unlink(struct object_info *info) {
+	if (info->lru_prev != NULL)
+		info->lru_prev->lru_next = info->lru_next;
+	else
+		lru_head = info->lru_next;
+	if (info->lru_next != NULL)
+		info->lru_next->lru_prev = info->lru_prev;
+	else
+		lru_tail = info->lru_prev;
+	info->lru_prev = info->lru_next = NULL;
+}
+
+/****
+ * Close an object's file and take it out of the file cache
+ * return: Nothing
+ ****/
+static void close_file(struct object_info *info) {
+	if (info->fd == -1)
+		return;
+	lru_unlink(info);
+	close(info->fd);
+	info->fd = -1;
+	num_open_files--;
+}
+
+/****
+ * Bring an object's index entry up to date with the filesystem. The object is
+ * added if it is new and removed if it no longer exists or is not a regular file
+ * return: Nothing
+ ****/
+static void refresh(const char *object_name) {
+	char path[512];
+	struct stat st;
+	struct object_info **link, *info;
+	int exists;
+
+	if (!valid_object_name(object_name))
+		return;
+	object_path(path, sizeof(path), object_name);
+	exists = stat(path, &st) == 0 && S_ISREG(st.st_mode);
+
+	for (link = &buckets[bucket_of(object_name, num_buckets)]; *link != NULL; link = &(*link)->next) {
+		if (strcmp((*link)->name, object_name) == 0)
+			break;
+	}
+	info = *link;
+
+	if (!exists) {
+		if (info != NULL) {
+			close_file(info);
+			*link = info->next;
+			free(info);
+			num_objects--;
+		}
+		return;
+	}
+
+	if (info == NULL) {
+		if (num_objects >= num_buckets) {
+			grow_table();
+			link = &buckets[bucket_of(object_name, num_buckets)];
+			while (*link != NULL)
+				link = &(*link)->next;
+		}
+		if ((info = calloc(1, sizeof(*info))) == NULL)
+			err(1, "calloc");
+		strcpy(info->name, object_name);
+		info->fd = -1;
+		*link = info;
+		num_objects++;
+	} else {
+		close_file(info);		// The file may have been replaced by a new one
+	}
+
+	info->size = st.st_size;
+	info->mtime = st.st_mtime;
+	make_validator(&st, info->validator);
+}
+
+/****
+ * Add every object in the directory to the index
+ * return: Nothing
+ ****/
+static void scan_dir() {
+	struct dirent *de;
+	DIR *dir;
+
+	if ((dir = opendir(index_dir)) == NULL)
+		err(1, "opendir %s", index_dir);
+	while ((de = readdir(dir)) != NULL)
+		refresh(de->d_name);
+	closedir(dir);
+}
+
+/****
+ * Rebuild the whole index after inotify dropped events
+ * return: Nothing
+ ****/
+static void rescan() {
+	unsigned int i;
+
+	for (i = 0; i < num_buckets; i++) {
+		struct object_info *info, *next;
+		for (info = buckets[i]; info != NULL; info = next) {
+			next = info->next;
+			refresh(info->name);
+		}
+	}
+	scan_dir();
+}
+
+/****
+ * Index an object directory and start watching it for changes
+ * dir: Object directory including its trailing '/'
+ * max_open_files: Number of recently requested objects to keep open
+ * return: inotify descriptor to pass to index_update when it becomes readable
+ ****/
+int index_init(const char *dir, unsigned int max_open_files) {
+	int notify_fd;
+
+	strncpy(index_dir, dir, sizeof(index_dir) - 1);
+	max_open = max_open_files;
+	grow_table();
+
+	if ((notify_fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC)) == -1)
+		err(1, "inotify_init1");
+	if (inotify_add_watch(notify_fd, index_dir, WATCH_EVENTS) == -1)
+		err(1, "inotify_add_watch %s", index_dir);
+
+	scan_dir();
+	log_info("Indexed %u objects in %s", num_objects, index_dir);
+	return notify_fd;
+}
+
+/****
+ * Find an object in the index
+ * return: The object's entry. NULL if there is no such object
+ ****/
+struct object_info *index_lookup(const char *object_name) {
+	struct object_info *info;
+
+	for (info = buckets[bucket_of(object_name, num_buckets)]; info != NULL; info = info->next) {
+		if (strcmp(info->name, object_name) == 0)
+			return info;
+	}
+	return NULL;
+}
+
+/****
+ * Get a descriptor to read an object with pread. Objects in the file cache are
+ * not reopened
+ * return: The descriptor, to be released with index_close. -1 on error
+ ****/
+int index_open(const struct object_info *info) {
+	char path[512];
+
+	if (info->fd != -1)
+		return info->fd;
+	object_path(path, sizeof(path), info->name);
+	return open(path, O_RDONLY);
+}
+
+/****
+ * Release a descriptor returned by index_open
+ * return: Nothing
+ ****/
+void index_close(const struct object_info *info, int fd) {
+	if (fd != -1 && fd != info->fd)
+		close(fd);
+}
+
+/****
+ * Record that an object was requested, moving it to the front of the file cache
+ * and opening it if needed. The least recently used file is closed if the cache is full
+ * return: Nothing
+ ****/
+void index_touch(const char *object_name) {
+	struct object_info *info;
+	char path[512];
+
+	if (max_open == 0 || (info = index_lookup(object_name)) == NULL)
+		return;
+
+	if (info->fd != -1) {
+		lru_unlink(info);
+	} else {
+		object_path(path, sizeof(path), object_name);
+		if ((info->fd = open(path, O_RDONLY)) == -1)
+			return;
+		if (num_open_files == max_open)
+			close_file(lru_tail);
+		num_open_files++;
+	}
+
+	info->lru_next = lru_head;
+	if (lru_head != NULL)
+		lru_head->lru_prev = info;
+	lru_head = info;
+	if (lru_tail == NULL)
+		lru_tail = info;
+}
+
+/****
+ * Apply pending changes to the object directory
+ * notify_fd: Descriptor returned by index_init
+ * return: Nothing
+ ****/
+void index_update(int notify_fd) {
+	char buf[4096] __attribute__((aligned(__alignof__(struct inotify_event))));
+	ssize_t len;
+
+	while ((len = read(notify_fd, buf, sizeof(buf))) > 0) {
+		char *p;
+		for (p = buf; p < buf + len; p += sizeof(struct inotify_event) + ((struct inotify_event *)p)->len) {
+			const struct inotify_event *event = (const struct inotify_event *)p;
+			if (event->mask & IN_Q_OVERFLOW) {
+				log_info("Object directory change queue overflowed. Rescanning %s", index_dir);
+				rescan();
+			} else if (event->len > 0) {
+				refresh(event->name);
+			}
+		}
+	}
+}
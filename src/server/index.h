@@ -0,0 +1,29 @@
+/*
+ * index.h - In-memory index of the server's objects and cache of their open files
+ */
+
+#ifndef _INDEX_H_
+#define _INDEX_H_
+
+#include <time.h>
+#include "protocol.h"
+
+struct object_info {
+	char name[MAX_OBJECT_NAME + 1];
+	long long size;				/* Object size in bytes */
+	time_t mtime;				/* Last modification time */
+	char validator[VALIDATOR_LEN];		/* Validator handed out to the proxy */
+	int fd;					/* Open data file. -1 if it is not in the file cache */
+	struct object_info *next;		/* Next object in the same hash bucket */
+	struct object_info *lru_prev;		/* More recently used object in the file cache */
+	struct object_info *lru_next;		/* Less recently used object in the file cache */
+};
+
+int index_init(const char *dir, unsigned int max_open_files);
+struct object_info *index_lookup(const char *object_name);
+int index_open(const struct object_info *info);
+void index_close(const struct object_info *info, int fd);
+void index_touch(const char *object_name);
+void index_update(int notify_fd);
+
+#endif // _INDEX_H_
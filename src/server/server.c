@@ -32,34 +32,273 @@
 
 #include <err.h>
 #include <errno.h>
+#include <fcntl.h>
 #include <limits.h>
+#include <poll.h>
 #include <signal.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <unistd.h>
 #include <tls.h>
+#include "index.h"
+#include "latency.h"
+#include "log.h"
+#include "metrics.h"
+#include "options.h"
+#include "protocol.h"
+#include "shard.h"
+#include "synthetic.h"
+#include "trace.h"
 
 
 const char SERVER_DIR[] = "./server_files/";
-
-static void usage()
+const unsigned int MAX_OPEN_FILES = 256;
+const unsigned int MAX_SHARDS = 256;
+const char DEFAULT_SYNTHETIC_SIZES[] = "4096";
+
+enum stage {
+	STAGE_ACCEPT,				/* From accept until the connection's process starts the handshake */
+	STAGE_HANDSHAKE,			/* TLS handshake with the proxy server */
+	STAGE_REQUEST_READ,			/* Reading the request line */
+	STAGE_LOOKUP,				/* Finding and opening an object */
+	STAGE_TRANSFER,				/* Sending the response for an object */
+	STAGE_CLOSE,				/* Closing the session */
+	NUM_STAGES
+};
+
+const char *const STAGE_NAMES[] = {"accept", "handshake", "request_read", "lookup", "transfer", "close"};
+
+enum counter {
+	COUNTER_REQUESTS,			/* Requests by verb. A batch request counts once */
+	COUNTER_RESPONSES,			/* Responses for single objects by status */
+	COUNTER_BYTES_SERVED,			/* Object bytes sent */
+	COUNTER_OPEN_CONNECTIONS,		/* Connections being served */
+	NUM_COUNTERS
+};
+
+enum verb { VERB_GET, VERB_REVALIDATE, VERB_BATCH };
+enum response { RESPONSE_OK, RESPONSE_PARTIAL, RESPONSE_NOT_MODIFIED, RESPONSE_NOT_FOUND, RESPONSE_BAD_RANGE };
+
+const char *const VERB_NAMES[] = {"get", "revalidate", "batch"};
+const char *const RESPONSE_NAMES[] = {"ok", "partial", "not_modified", "not_found", "bad_range"};
+const struct metric COUNTERS[] = {
+	{"tlscache_server_requests_total", "Requests received by verb", METRIC_COUNTER, "verb", VERB_NAMES, 3},
+	{"tlscache_server_responses_total", "Responses for single objects by status", METRIC_COUNTER, "status",
+	    RESPONSE_NAMES, 5},
+	{"tlscache_server_bytes_served_total", "Object bytes sent to proxy servers", METRIC_COUNTER, NULL, NULL, 0},
+	{"tlscache_server_open_connections", "Connections being served", METRIC_GAUGE, NULL, NULL, 0},
+};
+
+void usage(void)
 {
 	extern char * __progname;
-	fprintf(stderr, "usage: %s -port portnumber\n", __progname);
+	fprintf(stderr, "usage: %s -port portnumber [-shards count] [-backlog length]\n"
+	    "       [-log-level error|warn|info|debug] [-log-content on|off] [-admin-port portnumber]\n"
+	    "       [-trace filename] [-synthetic seed [-synthetic-sizes bytes|uniform:min-max|pareto:min-max]]\n",
+	    __progname);
 	exit(1);
 }
 
+static int synthetic = 0;			/* Serve generated objects instead of SERVER_DIR */
+static uint64_t synthetic_seed;
+static struct synthetic_sizes synthetic_sizes;
+
+static void connection_closed() {
+	metrics_add(COUNTER_OPEN_CONNECTIONS, 0, -1);
+}
+
+static void write_metrics(FILE *fp) {
+	latency_write_metrics(fp, "tlscache_server_stage_seconds");
+}
+
 static void kidhandler(int signum) {
 	/* signal handler for SIGCHLD */
 	waitpid(WAIT_ANY, NULL, WNOHANG);
 }
 
+/****
+ * Read the names of served objects reported by children and move them to the
+ * front of the open file cache. Each report is one '\n' terminated line
+ * report_fd: Nonblocking read end of the report pipe
+ * return: Nothing
+ ****/
+static void read_reports(int report_fd) {
+	static char buf[4096];
+	static size_t len;
+	ssize_t n;
+
+	while ((n = read(report_fd, buf + len, sizeof(buf) - len)) > 0) {
+		char *line = buf, *nl;
+		len += n;
+		while ((nl = memchr(line, '\n', buf + len - line)) != NULL) {
+			*nl = '\0';
+			index_touch(line);
+			line = nl + 1;
+		}
+		len -= line - buf;
+		memmove(buf, line, len);
+		if (len == sizeof(buf))
+			len = 0;		// Drop a line too long to be an object name
+	}
+}
+
+/****
+ * Find a requested object, generating it in synthetic mode
+ * generated: Filled with the object in synthetic mode
+ * fd: Set to the object's open data file. -1 in synthetic mode
+ * key: Set to the key the object's content is generated from in synthetic mode
+ * return: The object. NULL if it does not exist or cannot be opened
+ ****/
+static struct object_info *find_object(const char *object_name, struct object_info *generated, int *fd, uint64_t *key)
+{
+	struct object_info *info;
+
+	*fd = -1;
+	if (!valid_object_name(object_name))
+		return NULL;
+	if (synthetic) {
+		*key = synthetic_key(object_name, synthetic_seed);
+		generated->size = synthetic_size(object_name, *key, &synthetic_sizes);
+		synthetic_validator(*key, generated->size, generated->validator);
+		return generated;
+	}
+	if ((info = index_lookup(object_name)) == NULL || (*fd = index_open(info)) == -1)
+		return NULL;
+	return info;
+}
+
+/****
+ * Answer a request for one object. The response is framed the same way whether the
+ * request came alone or as part of a batch
+ * report_fd: Write end of the pipe reporting served objects to the listening process
+ * proxy_validator: Validator of the proxy server's copy, or NULL
+ * range: Requested byte range, or NULL for the whole object
+ * return: Nothing. Exits if the object cannot be sent
+ ****/
+static void send_object(struct tls *cctx, int report_fd, const char *object_name, const char *proxy_validator, const char *range)
+{
+	struct object_info *info, generated;
+	int fd;
+	uint64_t key = 0;
+	long long start = 0, end = -1, first, last;
+	unsigned long long started = latency_clock();
+
+	info = find_object(object_name, &generated, &fd, &key);
+	started = latency_record(STAGE_LOOKUP, started);
+	if (info == NULL) {
+		if (tls_printf(cctx, "%s\n", RESP_NOT_FOUND) == -1)
+			err(1, "tls_write: %s", tls_error(cctx));
+		log_info("File %s not found!", object_name);
+		metrics_add(COUNTER_RESPONSES, RESPONSE_NOT_FOUND, 1);
+	} else if ((range != NULL && parse_range(range, &start, &end) == -1) ||
+	    resolve_range(start, end, info->size, &first, &last) == -1) {
+		if (tls_printf(cctx, "%s %lld\n", RESP_BAD_RANGE, info->size) == -1)
+			err(1, "tls_write: %s", tls_error(cctx));
+		log_info("Requested range %s is not satisfiable", range);
+		metrics_add(COUNTER_RESPONSES, RESPONSE_BAD_RANGE, 1);
+	} else if (proxy_validator != NULL && strcmp(info->validator, proxy_validator) == 0) {
+		if (tls_printf(cctx, "%s %s\n", RESP_NOT_MODIFIED, info->validator) == -1)
+			err(1, "tls_write: %s", tls_error(cctx));
+		log_debug("Proxy server's copy of %s is not modified", object_name);
+		metrics_add(COUNTER_RESPONSES, RESPONSE_NOT_MODIFIED, 1);
+	} else {
+		int ret;
+		if (range == NULL)
+			ret = tls_printf(cctx, "%s %lld %s\n", RESP_OK, info->size, info->validator);
+		else
+			ret = tls_printf(cctx, "%s %lld %s %lld-%lld/%lld\n", RESP_PARTIAL, last - first + 1,
+			    info->validator, first, last, info->size);
+		if (ret == -1)
+			err(1, "tls_write: %s", tls_error(cctx));
+		metrics_add(COUNTER_RESPONSES, range == NULL ? RESPONSE_OK : RESPONSE_PARTIAL, 1);
+
+		char content[16384];
+		long long offset = first;
+		ssize_t n;
+
+		while (offset <= last) {
+			n = last - offset + 1 < (long long)sizeof(content) ? last - offset + 1 : (long long)sizeof(content);
+			if (synthetic)
+				synthetic_fill(key, offset, content, n);
+			else if ((n = pread(fd, content, n, offset)) <= 0)
+				break;
+			if (tls_write_all(cctx, content, n) == -1)
+				err(1, "tls_write: %s", tls_error(cctx));
+			log_content(content, n);
+			metrics_add(COUNTER_BYTES_SERVED, 0, n);
+			offset += n;
+		}
+		if (offset <= last)
+			errx(1, "%s shrank while it was being sent", object_name);	// The response can no longer be framed
+	}
+	latency_record(STAGE_TRANSFER, started);
+
+	if (fd != -1) {
+		index_close(info, fd);
+
+		char report[MAX_OBJECT_NAME + 2];
+		int len = snprintf(report, sizeof(report), "%s\n", object_name);
+		if (write(report_fd, report, len) == -1 && errno != EAGAIN)
+			warn("write");
+	}
+}
+
 
 int main(int argc,  char *argv[])
 {
-	if (argc != 3 || strcmp(argv[1], "-port") != 0)				// Check if executable is used properly
+	if (argc < 3 || argc % 2 != 1 || strcmp(argv[1], "-port") != 0)	// Check if executable is used properly
                 usage();
+
+	unsigned int num_shards = 1;
+	int backlog = DEFAULT_BACKLOG;
+	enum log_level log_level = LOG_LEVEL_INFO;
+	int log_content = 0;
+	u_short admin_port = 0;
+	const char *trace_path = NULL;
+	int sizes_given = 0;
+	int arg;
+	for (arg = 3; arg < argc; arg += 2) {				// Optional settings come in pairs after the port
+		if (strcmp(argv[arg], "-shards") == 0)
+			num_shards = parse_number(argv[arg + 1], MAX_SHARDS);
+		else if (strcmp(argv[arg], "-backlog") == 0)
+			backlog = parse_number(argv[arg + 1], INT_MAX);
+		else if (strcmp(argv[arg], "-log-level") == 0 && log_parse_level(argv[arg + 1], &log_level) == 0)
+			continue;
+		else if (strcmp(argv[arg], "-log-content") == 0 && strcmp(argv[arg + 1], "on") == 0)
+			log_content = 1;
+		else if (strcmp(argv[arg], "-log-content") == 0 && strcmp(argv[arg + 1], "off") == 0)
+			log_content = 0;
+		else if (strcmp(argv[arg], "-admin-port") == 0)
+			admin_port = parse_number(argv[arg + 1], USHRT_MAX);
+		else if (strcmp(argv[arg], "-trace") == 0)
+			trace_path = argv[arg + 1];
+		else if (strcmp(argv[arg], "-synthetic") == 0) {
+			synthetic = 1;
+			synthetic_seed = parse_number(argv[arg + 1], ULONG_MAX);
+		} else if (strcmp(argv[arg], "-synthetic-sizes") == 0 && synthetic_parse_sizes(argv[arg + 1], &synthetic_sizes) == 0)
+			sizes_given = 1;
+		else
+			usage();
+	}
+	if (num_shards == 0 || (sizes_given && !synthetic))
+		usage();
+	/*
+	 * first, figure out what port we will listen on - it should
+	 * be our first parameter. Every argument is checked before any
+	 * shard is forked
+	 */
+	u_short port = parse_number(argv[2], USHRT_MAX);
+	if (!sizes_given)
+		synthetic_parse_sizes(DEFAULT_SYNTHETIC_SIZES, &synthetic_sizes);
+
+	log_init(STDOUT_FILENO, log_level, log_content);
+	if (trace_path != NULL)
+		trace_init(trace_path, "server");
+	latency_init(STAGE_NAMES, NUM_STAGES);
+	latency_dump_on_signal(SIGUSR1);
+	metrics_init(COUNTERS, NUM_COUNTERS);
+	unsigned int shard = start_shards(num_shards);
 	
 	/**** Configure TLS connection to proxy server ****/
 	struct tls_config *cfg = NULL;
@@ -69,83 +308,47 @@ int main(int argc,  char *argv[])
 
 	if (tls_init() != 0)
 		err(1, "tls_init:");
-	printf("Initialized TLS\n");
+	log_debug("Initialized TLS");
 
 	if ((cfg = tls_config_new()) == NULL)
 		err(1, "tls_config_new:");
-	printf("Got TLS config\n");
+	log_debug("Got TLS config");
 
 	if ((mem = tls_load_file("../../certificates/root.pem", &mem_len, NULL)) == NULL)
 		err(1, "tls_load_file(ca):");
 	if (tls_config_set_ca_mem(cfg, mem, mem_len) != 0)
 		err(1, "tls_config_set_ca_mem:");
-	printf("Set root certificate\n");
+	log_debug("Set root certificate");
 
 	if ((mem = tls_load_file("../../certificates/server.crt", &mem_len, NULL)) == NULL)
 		err(1, "tls_load_file(server):");
 	if (tls_config_set_cert_mem(cfg, mem, mem_len) != 0)
 		err(1, "tls_config_set_cert_mem:");
-	printf("Set server certificate\n");	
+	log_debug("Set server certificate");
 
 	if ((mem = tls_load_file("../../certificates/server.key", &mem_len, NULL)) == NULL)
 		err(1, "tls_load_file(serverkey):");
 	if (tls_config_set_key_mem(cfg, mem, mem_len) != 0)
 		err(1, "tls_config_set_key_mem:");
-	printf("Set server private key\n");	
+	log_debug("Set server private key");
 
 	if ((ctx = tls_server()) == NULL)
 		err(1, "tls_server:");
-	printf("Got TLS server\n");
+	log_debug("Got TLS server");
 
 	if (tls_configure(ctx, cfg) != 0)
 		err(1, "tls_configure: %s", tls_error(ctx));
-	printf("Configured TLS server with TLS config\n");
+	log_debug("Configured TLS server with TLS config");
 	/**** End configure TLS connection to proxy server ****/
 
 	/**** Configure TCP connection with proxy server ****/
-	struct sockaddr_in sockname, client;
-	char *ep;
+	struct sockaddr_in client;
 	struct sigaction sa;
 	int sd;
 	socklen_t clientlen;
-	u_short port;
 	pid_t pid;
-	u_long p;
-
-	/*
-	 * first, figure out what port we will listen on - it should
-	 * be our first parameter.
-	 */
-	errno = 0;
-        p = strtoul(argv[2], &ep, 10);
-        if (*argv[2] == '\0' || *ep != '\0') {
-		/* parameter wasn't a number, or was empty */
-		fprintf(stderr, "%s - not a number\n", argv[2]);
-		usage();
-	}
-        if ((errno == ERANGE && p == ULONG_MAX) || (p > USHRT_MAX)) {
-		/* It's a number, but it either can't fit in an unsigned
-		 * long, or is too big for an unsigned short
-		 */
-		fprintf(stderr, "%s - value out of range\n", argv[2]);
-		usage();
-	}
-	/* now safe to do this */
-	port = p;
-
-	memset(&sockname, 0, sizeof(sockname));
-	sockname.sin_family = AF_INET;
-	sockname.sin_port = htons(port);
-	sockname.sin_addr.s_addr = htonl(INADDR_ANY);
-	sd = socket(AF_INET,SOCK_STREAM,0);
-	if (sd == -1)
-		err(1, "socket failed");
-
-	if (bind(sd, (struct sockaddr *) &sockname, sizeof(sockname)) == -1)
-		err(1, "bind failed");
 
-	if (listen(sd, 3) == -1)
-		err(1, "listen failed");
+	sd = listen_socket(port, backlog, num_shards > 1);
 
 	/*
 	 * we're now bound, and listening for connections on "sd" -
@@ -169,16 +372,55 @@ int main(int argc,  char *argv[])
         if (sigaction(SIGCHLD, &sa, NULL) == -1)
                 err(1, "sigaction failed");
 
-	printf("Server up and listening for connections on port %u\n", port);
+	log_info("Server up and listening for connections on port %u", port);
+	if (shard == 0 && admin_port != 0) {
+		metrics_serve(admin_port, write_metrics);
+		log_info("Serving metrics on http://127.0.0.1:%u/metrics", admin_port);
+	}
 	/**** End configure TCP connection with proxy server ****/	
 
+	/**** Index stored objects ****/
+	int notify_fd = -1;				// Ignored by poll in synthetic mode
+	int report_pipe[2];
+
+	if (synthetic)
+		log_info("Serving generated objects with seed %llu", (unsigned long long)synthetic_seed);
+	else
+		notify_fd = index_init(SERVER_DIR, MAX_OPEN_FILES);
+
+	if (pipe(report_pipe) == -1 || fcntl(report_pipe[0], F_SETFL, O_NONBLOCK) == -1 ||
+	    fcntl(report_pipe[1], F_SETFL, O_NONBLOCK) == -1)
+		err(1, "pipe");
+	/**** End index stored objects ****/
+
 	for(;;) {
+		/**** Wait for a connection or a change to the stored objects ****/
+		struct pollfd pfds[3] = {
+			{ .fd = sd, .events = POLLIN },
+			{ .fd = notify_fd, .events = POLLIN },
+			{ .fd = report_pipe[0], .events = POLLIN }
+		};
+
+		if (poll(pfds, 3, -1) == -1) {
+			if (errno == EINTR)
+				continue;
+			err(1, "poll failed");
+		}
+		if (pfds[1].revents & POLLIN)
+			index_update(notify_fd);
+		if (pfds[2].revents & POLLIN)
+			read_reports(report_pipe[0]);
+		if (!(pfds[0].revents & POLLIN))
+			continue;
+		/**** End wait for a connection or a change to the stored objects ****/
+
 		/**** TCP connection with proxy server ****/
 		int clientsd;
 		clientlen = sizeof(&client);
 		clientsd = accept(sd, (struct sockaddr *)&client, &clientlen);
 		if (clientsd == -1)
 			err(1, "accept failed");
+		unsigned long long accepted = latency_clock();
 		/**** End TCP connection with proxy server ****/
 
 		/*
@@ -192,62 +434,101 @@ int main(int argc,  char *argv[])
 		     err(1, "fork failed");
 
 		if(pid == 0) {
+			close(report_pipe[0]);
+			if (notify_fd != -1)
+				close(notify_fd);
+			metrics_add(COUNTER_OPEN_CONNECTIONS, 0, 1);
+			atexit(connection_closed);		// Also counts connections ended by an error
+
 			/**** TLS connection with proxy server ****/
+			unsigned long long started = latency_record(STAGE_ACCEPT, accepted);
 			if (tls_accept_socket(ctx, &cctx, clientsd) != 0)
 				err(1, "tls_accept_socket: %s", tls_error(ctx));
-			printf("Accepted TLS socket\n");
-			printf("\n");
+			if (tls_handshake(cctx) != 0)
+				errx(1, "tls_handshake: %s", tls_error(cctx));
+			started = latency_record(STAGE_HANDSHAKE, started);
+			log_debug("Accepted TLS socket");
 			/**** TLS connection with proxy server ****/
 			
 			/**** Receive request for object from proxy server ****/
-			char request[255];
-			memset(request, 0, sizeof(request));
-			
-			if (tls_read(cctx, request, sizeof(request)) < 0)
-				err(1, "tls_read: %s", tls_error(cctx));
-			
-			printf("Received request for server for %s\n", request); 
+			struct tls_stream stream;
+			char request[MAX_LINE];
+			char *verb, *object_name, *proxy_validator = NULL, *range = NULL;
+			char *saveptr, *ep;
+			unsigned long batch_size = 0;
+			struct trace_context trace;
+
+			stream_init(&stream, cctx);
+			if (stream_read_line(&stream, request, sizeof(request)) != 1)
+				errx(1, "tls_read: %s", tls_error(cctx));
+			latency_record(STAGE_REQUEST_READ, started);
+
+			trace_extract(request, &trace);
+			verb = strtok_r(request, " ", &saveptr);
+			object_name = strtok_r(NULL, " ", &saveptr);
+			if (verb != NULL && strcmp(verb, REQ_BATCH) == 0 && object_name != NULL) {
+				batch_size = strtoul(object_name, &ep, 10);
+				if (*ep != '\0' || batch_size == 0 || batch_size > MAX_BATCH)
+					errx(1, "Malformed request");
+				log_info("Received %s request for server for %lu objects", verb, batch_size);
+			} else if (verb != NULL && strcmp(verb, REQ_REVALIDATE) == 0)
+				proxy_validator = strtok_r(NULL, " ", &saveptr);
+			else if (verb == NULL || strcmp(verb, REQ_GET) != 0)
+				errx(1, "Malformed request");
+			if (batch_size == 0) {
+				range = strtok_r(NULL, " ", &saveptr);
+				if (object_name == NULL || (strcmp(verb, REQ_REVALIDATE) == 0 && proxy_validator == NULL))
+					errx(1, "Malformed request");
+				log_info("Received %s request %016llx for server for %s%s%s", verb, trace.id, object_name,
+				    range != NULL ? " " : "", range != NULL ? range : "");
+			}
+			metrics_add(COUNTER_REQUESTS, batch_size > 0 ? VERB_BATCH : proxy_validator != NULL ? VERB_REVALIDATE : VERB_GET,
+			    1);
 			/**** End receive request for object from proxy server ****/
 
-			/**** Send requested object to client ****/
-			FILE *fp;
-			char filename[255];
-			char content[255];
-			memset(filename, 0, sizeof(filename));
-			memset(content, 0, sizeof(content));
-			strcpy(filename, SERVER_DIR);
-			strcat(filename, request);
-	 
-			if ((fp = fopen(filename, "r")) == NULL)
-				err(1, "File not found!");
-
-			printf("Sent file content:\n");
-			while (fread(content, sizeof(char), sizeof(content), fp) > 0) {
-				if (tls_write(cctx, content, strlen(content)) < 0)
-					err(1, "tls_write: %s", tls_error(ctx));
-				printf("%s", content);
-				memset(content, 0, sizeof(content));
+			/**** Send requested objects to proxy server ****/
+			if (batch_size == 0) {
+				trace_begin(&trace);
+				send_object(cctx, report_pipe[1], object_name, proxy_validator, range);
+				trace_end("request", accepted, object_name);
+			} else {
+				unsigned long i;
+				for (i = 0; i < batch_size; i++) {
+					unsigned long long reading = latency_clock();
+
+					if (stream_read_line(&stream, request, sizeof(request)) != 1)
+						errx(1, "Batch request ended early");
+					trace_extract(request, &trace);
+					object_name = strtok_r(request, " ", &saveptr);
+					proxy_validator = strtok_r(NULL, " ", &saveptr);
+					if (object_name == NULL)
+						errx(1, "Malformed request");
+					log_debug("Batch object %s for request %016llx", object_name, trace.id);
+					trace_begin(&trace);		// The connection's first spans go to the first object
+					send_object(cctx, report_pipe[1], object_name, proxy_validator, NULL);
+					trace_end("batch_object", reading, object_name);
+				}
 			}
-			fclose(fp);
-			printf("\n");	
-			/**** End send requested object to client ****/
+			/**** End send requested objects to proxy server ****/
 
 			/**** Close TLS connection to proxy server ****/
+			started = latency_clock();
 			if (tls_close(cctx) != 0)
 				err(1, "tls_close: %s", tls_error(cctx));
-			printf("Closed TLS client\n");
-			
+			log_debug("Closed TLS client");
+
 			tls_free(cctx);
-			printf("Freed TLS client\n"); 
+			log_debug("Freed TLS client");
 
 			tls_free(ctx);
-			printf("Freed TLS server\n");
+			log_debug("Freed TLS server");
 
 			tls_config_free(cfg);
-			printf("Freed TLS config\n");
-			printf("\n");
+			log_debug("Freed TLS config");
 
 			close(clientsd);
+			latency_record(STAGE_CLOSE, started);
+			latency_flush();
 			/**** End close TLS connection to proxy server ****/
 
 			exit(0);